@@ -388,7 +388,9 @@ class OPDS2SamlIDP: NSObject, Codable {
 /// choose to sign up for multiple Accounts.
 @objcMembers final class Account: NSObject
 {
-  let logo:UIImage
+  /// The logo as provided by the library registry, i.e. a base64 `data:` URL.
+  /// It's only decoded when the logo is displayed.
+  private let logoDataURL: String?
   let uuid:String
   let name:String
   let subtitle:String?
@@ -422,14 +424,45 @@ class OPDS2SamlIDP: NSObject, Codable {
     
     authenticationDocumentUrl = publication.links.first(where: { $0.type == "application/vnd.opds.authentication.v1.0+json" })?.href
     
-    let logoString = publication.images?.first(where: { $0.rel == "http://opds-spec.org/image/thumbnail" })?.href
-    if let modString = logoString?.replacingOccurrences(of: "data:image/png;base64,", with: ""),
-      let logoData = Data.init(base64Encoded: modString),
-      let logoImage = UIImage(data: logoData) {
-      logo = logoImage
-    } else {
-      logo = UIImage.init(named: "LibraryLogoMagic")!
-    }
+    logoDataURL = publication.images?.first(where: { $0.rel == "http://opds-spec.org/image/thumbnail" })?.href
+  }
+
+  init(snapshotEntry entry: NYPLLibraryCatalogSnapshot.Entry) {
+    name = entry.name
+    subtitle = entry.subtitle
+    uuid = entry.uuid
+    catalogUrl = entry.catalogUrl
+    supportEmail = entry.supportEmail
+    authenticationDocumentUrl = entry.authenticationDocumentUrl
+    logoDataURL = entry.logoDataURL
+  }
+
+  var snapshotEntry: NYPLLibraryCatalogSnapshot.Entry {
+    return NYPLLibraryCatalogSnapshot.Entry(uuid: uuid,
+                                            name: name,
+                                            subtitle: subtitle,
+                                            supportEmail: supportEmail,
+                                            catalogUrl: catalogUrl,
+                                            authenticationDocumentUrl: authenticationDocumentUrl,
+                                            logoDataURL: logoDataURL)
+  }
+
+  /// The library logo, decoded on the calling thread the first time it's
+  /// needed. Use `loadLogo(completion:)` on the main thread.
+  var logo: UIImage {
+    return NYPLLibraryLogoCache.shared.logo(forKey: uuid, dataURL: logoDataURL)
+  }
+
+  /// Decodes the library logo off the main thread the first time it's
+  /// needed; later calls are served from `NYPLLibraryLogoCache`. Callers
+  /// should show `NYPLLibraryLogoCache.placeholder` until the logo is ready.
+  /// - Parameter completion: Called on the main thread with the logo, or
+  /// with a placeholder if the library doesn't provide a valid one. Called
+  /// synchronously if the logo is already cached.
+  func loadLogo(completion: @escaping (UIImage) -> Void) {
+    NYPLLibraryLogoCache.shared.loadLogo(forKey: uuid,
+                                         dataURL: logoDataURL,
+                                         completion: completion)
   }
 
 
@@ -191,11 +191,11 @@ let currentAccountIdentifierKey  = "NYPLCurrentAccountIdentifier"
                                          key: String,
                                          completion: @escaping (Bool) -> ()) {
     do {
-      let catalogsFeed = try OPDS2CatalogsFeed.fromData(data)
+      let accounts = try makeAccounts(fromCatalogData: data, key: key)
       let hadAccount = self.currentAccount != nil
 
       accountSetsWorkQueue.sync(flags: .barrier) {
-        accountSets[key] = catalogsFeed.catalogs.map { Account(publication: $0) }
+        accountSets[key] = accounts
       }
 
       // note: `currentAccount` computed property feeds off of `accountSets`, so
@@ -236,6 +236,22 @@ let currentAccountIdentifierKey  = "NYPLCurrentAccountIdentifier"
     }
   }
 
+  /// Builds the library accounts listed in the library catalog data, from
+  /// the snapshot saved the last time this data was parsed if possible.
+  /// Otherwise the data is parsed and a new snapshot is saved.
+  private func makeAccounts(fromCatalogData data: Data, key: String) throws -> [Account] {
+    let digest = NYPLLibraryCatalogSnapshot.digest(ofFeedData: data)
+    if let snapshot = NYPLLibraryCatalogSnapshot.load(forKey: key),
+      snapshot.feedDigest == digest {
+      return snapshot.entries.map { Account(snapshotEntry: $0) }
+    }
+
+    let catalogsFeed = try OPDS2CatalogsFeed.fromData(data)
+    let accounts = catalogsFeed.catalogs.map { Account(publication: $0) }
+    NYPLLibraryCatalogSnapshot(feedDigest: digest, accounts: accounts).save(forKey: key)
+    return accounts
+  }
+
   /// Loads library catalogs from the network or cache if available.
   ///
   /// After loading the library accounts, the authentication document
@@ -325,6 +341,7 @@ let currentAccountIdentifierKey  = "NYPLCurrentAccountIdentifier"
 
   func clearCache() {
     NYPLNetworkExecutor.shared.clearCache()
+    NYPLLibraryCatalogSnapshot.removeAll()
     do {
       let applicationSupportUrl = try FileManager.default.url(for: .applicationSupportDirectory, in: .userDomainMask, appropriateFor: nil, create: false)
       let appSupportDirContents = try FileManager.default.contentsOfDirectory(at: applicationSupportUrl, includingPropertiesForKeys: nil, options: [.skipsHiddenFiles, .skipsPackageDescendants, .skipsSubdirectoryDescendants])
@@ -0,0 +1,104 @@
+//
+//  NYPLLibraryCatalogSnapshot.swift
+//  Simplified
+//
+//  Copyright © 2026 NYPL. All rights reserved.
+//
+
+import Foundation
+import CommonCrypto
+
+/// The library accounts parsed from a library registry feed, persisted in a
+/// compact form so that the account list can be rebuilt without parsing the
+/// whole OPDS2 feed again when the feed hasn't changed.
+struct NYPLLibraryCatalogSnapshot: Codable {
+
+  /// The fields `Account` reads from an OPDS2 catalog publication.
+  struct Entry: Codable {
+    let uuid: String
+    let name: String
+    let subtitle: String?
+    let supportEmail: String?
+    let catalogUrl: String?
+    let authenticationDocumentUrl: String?
+    /// The logo as found in the feed, still encoded.
+    let logoDataURL: String?
+  }
+
+  /// Identifies the feed data the snapshot was made from.
+  let feedDigest: String
+  let entries: [Entry]
+
+  //----------------------------------------------------------------------------
+  init(feedDigest: String, accounts: [Account]) {
+    self.feedDigest = feedDigest
+    self.entries = accounts.map { $0.snapshotEntry }
+  }
+
+  //----------------------------------------------------------------------------
+  /// - Returns: A digest of the feed data, to check whether a snapshot was
+  /// made from the same data.
+  static func digest(ofFeedData data: Data) -> String {
+    var digest = [UInt8](repeating: 0, count: Int(CC_SHA256_DIGEST_LENGTH))
+    data.withUnsafeBytes {
+      _ = CC_SHA256($0.baseAddress, CC_LONG(data.count), &digest)
+    }
+    return digest.map { String(format: "%02hhx", $0) }.joined()
+  }
+
+  // MARK: - Persistence
+
+  /// Snapshot file names start with this prefix.
+  static let fileNamePrefix = "library_catalog_snapshot_"
+
+  //----------------------------------------------------------------------------
+  static func fileURL(forKey key: String) -> URL? {
+    guard let cachesURL = FileManager.default.urls(for: .cachesDirectory,
+                                                   in: .userDomainMask).first else {
+      return nil
+    }
+    return cachesURL.appendingPathComponent("\(fileNamePrefix)\(key).plist")
+  }
+
+  //----------------------------------------------------------------------------
+  /// - Returns: The snapshot saved for the library registry identified by
+  /// `key`, if any.
+  static func load(forKey key: String) -> NYPLLibraryCatalogSnapshot? {
+    guard let url = fileURL(forKey: key),
+      let data = try? Data(contentsOf: url) else {
+        return nil
+    }
+
+    return try? PropertyListDecoder().decode(NYPLLibraryCatalogSnapshot.self, from: data)
+  }
+
+  //----------------------------------------------------------------------------
+  func save(forKey key: String) {
+    guard let url = NYPLLibraryCatalogSnapshot.fileURL(forKey: key) else {
+      return
+    }
+
+    do {
+      let encoder = PropertyListEncoder()
+      encoder.outputFormat = .binary
+      try encoder.encode(self).write(to: url, options: .atomic)
+    } catch {
+      Log.error(#file, "Unable to save library catalog snapshot: \(error)")
+    }
+  }
+
+  //----------------------------------------------------------------------------
+  /// Deletes the snapshots of all library registries.
+  static func removeAll() {
+    guard let cachesURL = FileManager.default.urls(for: .cachesDirectory,
+                                                   in: .userDomainMask).first,
+      let contents = try? FileManager.default.contentsOfDirectory(at: cachesURL,
+                                                                  includingPropertiesForKeys: nil) else {
+        return
+    }
+
+    for url in contents where url.lastPathComponent.starts(with: fileNamePrefix) {
+      try? FileManager.default.removeItem(at: url)
+    }
+  }
+}
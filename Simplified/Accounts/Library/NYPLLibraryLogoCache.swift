@@ -0,0 +1,133 @@
+//
+//  NYPLLibraryLogoCache.swift
+//  Simplified
+//
+//  Copyright © 2026 NYPL. All rights reserved.
+//
+
+import UIKit
+
+/// Decodes library logos on demand and keeps the decoded images in a
+/// size-bounded, least-recently-used cache.
+///
+/// The library registry embeds every logo in the catalog as a base64 `data:`
+/// URL. Accounts keep that string as is, so that loading the catalog doesn't
+/// decode hundreds of images that are mostly never shown. The cache is
+/// emptied on memory warnings. This class is thread-safe.
+final class NYPLLibraryLogoCache {
+
+  static let shared = NYPLLibraryLogoCache()
+
+  /// Logos are shown at 45x45 points at most.
+  static let maxPixelSize = 135
+
+  static let defaultCostLimit = 4 * 1024 * 1024
+
+  static let placeholder = UIImage(named: "LibraryLogoMagic")!
+
+  private let cache: NYPLLRUCache<String, UIImage>
+  private let decodingQueue = DispatchQueue(label: "org.nypl.labs.SimplyE.NYPLLibraryLogoCache.decodingQueue",
+                                            qos: .userInitiated)
+  private var memoryWarningObserver: NSObjectProtocol?
+
+  //----------------------------------------------------------------------------
+  /// - Parameter costLimit: The maximum number of bytes of decoded bitmaps
+  /// the cache can hold.
+  init(costLimit: Int = NYPLLibraryLogoCache.defaultCostLimit) {
+    self.cache = NYPLLRUCache(costLimit: costLimit)
+    self.memoryWarningObserver = NotificationCenter.default.addObserver(
+      forName: UIApplication.didReceiveMemoryWarningNotification,
+      object: nil,
+      queue: nil) { [weak self] _ in
+        self?.cache.removeAll()
+    }
+  }
+
+  deinit {
+    if let observer = memoryWarningObserver {
+      NotificationCenter.default.removeObserver(observer)
+    }
+  }
+
+  var hitCount: Int {
+    return cache.hitCount
+  }
+
+  var missCount: Int {
+    return cache.missCount
+  }
+
+  //----------------------------------------------------------------------------
+  /// - Returns: The decoded logo for `key`, if it's in the cache.
+  func cachedLogo(forKey key: String) -> UIImage? {
+    return cache.value(forKey: key)
+  }
+
+  //----------------------------------------------------------------------------
+  /// Returns the logo for `key`, decoding `dataURL` on the calling thread if
+  /// it's not in the cache yet.
+  ///
+  /// - Returns: The decoded logo, or the placeholder logo if `dataURL` is
+  /// missing or not a valid image. The placeholder is cached as well, so
+  /// that an invalid logo is only decoded once.
+  func logo(forKey key: String, dataURL: String?) -> UIImage {
+    if let logo = cache.value(forKey: key) {
+      return logo
+    }
+
+    return decodeAndCacheLogo(forKey: key, dataURL: dataURL)
+  }
+
+  //----------------------------------------------------------------------------
+  /// Same as `logo(forKey:dataURL:)`, but decoding happens on a background
+  /// queue.
+  ///
+  /// - Parameter completion: Called on the main queue. Called synchronously
+  /// if the logo is already in the cache.
+  func loadLogo(forKey key: String,
+                dataURL: String?,
+                completion: @escaping (UIImage) -> Void) {
+    if let logo = cache.value(forKey: key) {
+      completion(logo)
+      return
+    }
+
+    decodingQueue.async {
+      let logo = self.logo(forKey: key, dataURL: dataURL)
+      DispatchQueue.main.async {
+        completion(logo)
+      }
+    }
+  }
+
+  //----------------------------------------------------------------------------
+  /// Decodes a `data:image/png;base64,` URL into a bitmap ready for display.
+  class func decodedLogo(fromDataURL dataURL: String?) -> UIImage? {
+    guard let base64String = dataURL?.replacingOccurrences(of: "data:image/png;base64,", with: ""),
+      let data = Data(base64Encoded: base64String) else {
+        return nil
+    }
+
+    return NYPLBookCoverCache.decodedImage(from: data, maxPixelSize: maxPixelSize)
+  }
+
+  // MARK: - Private
+
+  //----------------------------------------------------------------------------
+  private func decodeAndCacheLogo(forKey key: String, dataURL: String?) -> UIImage {
+    guard let logo = NYPLLibraryLogoCache.decodedLogo(fromDataURL: dataURL) else {
+      // the placeholder is shared, so it doesn't take up any extra memory
+      cache.setValue(NYPLLibraryLogoCache.placeholder, forKey: key, cost: 0)
+      return NYPLLibraryLogoCache.placeholder
+    }
+
+    let cost: Int
+    if let cgImage = logo.cgImage {
+      cost = cgImage.bytesPerRow * cgImage.height
+    } else {
+      cost = Int(logo.size.width * logo.size.height * logo.scale * logo.scale * 4)
+    }
+    cache.setValue(logo, forKey: key, cost: cost)
+    return logo
+  }
+}
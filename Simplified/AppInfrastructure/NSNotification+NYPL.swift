@@ -19,6 +19,12 @@ extension Notification.Name {
   static let NYPLDidSignOut = Notification.Name("NYPLDidSignOut")
   static let NYPLIsSigningIn = Notification.Name("NYPLIsSigningIn")
   static let NYPLAppDelegateDidReceiveCleverRedirectURL = Notification.Name("NYPLAppDelegateDidReceiveCleverRedirectURL")
+
+  /// Posted on the main thread, at most once per run loop iteration. The
+  /// `userInfo` dictionary may contain a `bookRegistryChangesKey` key whose
+  /// value is a dictionary mapping the identifiers of the books that changed
+  /// to an `NSNumber` wrapping their `NYPLBookRegistryChange` options. If the
+  /// key is missing, any book may have changed.
   static let NYPLBookRegistryDidChange = Notification.Name("NYPLBookRegistryDidChange")
 
   /// The `userInfo` dictionary contains the following key-value pairs:
@@ -28,9 +34,14 @@ extension Notification.Name {
   /// if there's some processing going on for the book.
   static let NYPLBookProcessingDidChange = Notification.Name("NYPLBookProcessingDidChange")
 
-  /// The `userInfo` dictionary contains the following key-value pairs:
-  /// - a `bookIDKey` key whose value is a String indicating
-  /// the book identifier;
+  /// Posted on the main thread, at most once per tick for any number of
+  /// books. The `userInfo` dictionary contains the following key-value pairs:
+  /// - a `bookIDKey` key whose value is a String indicating the identifier
+  /// of one of the books that changed, or an empty String if any book may
+  /// have changed;
+  /// - unless any book may have changed, a `downloadProgressChangesKey` key
+  /// whose value is a dictionary mapping the identifiers of all the books
+  /// that changed to an `NSNumber` wrapping their download progress.
   static let NYPLMyBooksDownloadCenterDidChange = Notification.Name("NYPLMyBooksDownloadCenterDidChange")
 
   static let NYPLBookDetailDidClose = Notification.Name("NYPLBookDetailDidClose")
@@ -56,4 +67,6 @@ extension Notification.Name {
 class NYPLNotificationKeys: NSObject {
   @objc public static let bookIDKey = "identifier"
   @objc public static let bookProcessingValueKey = "value"
+  @objc public static let bookRegistryChangesKey = "changes"
+  @objc public static let downloadProgressChangesKey = "downloadProgress"
 }
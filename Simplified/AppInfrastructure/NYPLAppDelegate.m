@@ -102,13 +102,15 @@ performFetchWithCompletionHandler:(void (^)(UIBackgroundFetchResult))backgroundF
     NYPLLOG_F(@"[Background Fetch] Starting book registry sync. "
               "ElapsedTime=%f", -startDate.timeIntervalSinceNow);
     // Only the "current library" account syncs during a background fetch.
-    [[NYPLBookRegistry sharedRegistry] syncResettingCache:NO completionHandler:^(NSDictionary *errorDict) {
-      if (errorDict == nil) {
-        [[NYPLBookRegistry sharedRegistry] save];
-      }
-    } backgroundFetchHandler:^(UIBackgroundFetchResult result) {
+    // Revalidating the loans feed costs little more than a 304 when nothing
+    // changed, and then there is nothing to save either.
+    [[NYPLBookRegistry sharedRegistry] syncResettingCache:YES completionHandler:nil
+                                   backgroundFetchHandler:^(UIBackgroundFetchResult result) {
       NYPLLOG_F(@"[Background Fetch] Completed with result %lu. "
                 "ElapsedTime=%f", (unsigned long)result, -startDate.timeIntervalSinceNow);
+      if (result == UIBackgroundFetchResultNewData) {
+        [[NYPLBookRegistry sharedRegistry] save];
+      }
       backgroundFetchHandler(result);
     }];
   } else {
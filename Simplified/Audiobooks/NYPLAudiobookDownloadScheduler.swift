@@ -0,0 +1,449 @@
+//
+//  NYPLAudiobookDownloadScheduler.swift
+//  Simplified
+//
+//  Copyright © 2026 NYPL. All rights reserved.
+//
+
+import Foundation
+
+/// The kind of network the device is connected to, as far as scheduling
+/// downloads is concerned.
+enum NYPLDownloadNetworkType {
+  case none
+  case cellular
+  case wifi
+}
+
+/// Priority of an audiobook download. Higher priority downloads are started
+/// first and may pause lower priority ones to get a slot.
+@objc enum NYPLAudiobookDownloadPriority: Int {
+  case low = 0
+  case normal = 1
+  case high = 2
+}
+
+/// What the scheduler needs to drive the download of one audiobook.
+protocol NYPLAudiobookFetching: AnyObject {
+  /// How much of the audiobook was downloaded so far, in a unit proportional
+  /// to bytes and common to all the audiobooks, so that the amounts
+  /// downloaded for different audiobooks can be added up.
+  var downloadedAmount: Double { get }
+
+  /// Starts downloading the files of the audiobook that are not downloaded
+  /// yet, or resumes after `cancelFetch()`.
+  func fetch()
+
+  /// Stops downloading. The files already downloaded are kept, the ones
+  /// being downloaded are lost.
+  func cancelFetch()
+}
+
+/// Decides which audiobooks are being downloaded at any given time.
+///
+/// Up to `concurrencyLimit` audiobooks are fetched at once. The limit starts
+/// low and is raised one step at a time as long as doing so increases the
+/// measured throughput, i.e. the amount downloaded per second by all the
+/// running downloads; a step that doesn't pay off is reverted and not retried
+/// for a while. The limit never exceeds the maximum allowed for the current
+/// network type.
+///
+/// Waiting downloads are started by priority, then in the order they were
+/// added. A download that ran for `timeSlice` yields its slot to a waiting
+/// download of the same or higher priority once the file it is downloading
+/// completes, so that all the audiobooks make progress without losing any
+/// partly downloaded file; a higher priority download takes the slot of a
+/// lower priority one right away. Downloads can also be paused and resumed
+/// individually: a paused download keeps its place among the others but
+/// doesn't take a slot.
+///
+/// The scheduler is not thread-safe: it must be used from a single queue.
+/// `tick()` must be called regularly while there are downloads, and
+/// `fileDidComplete(for:)` whenever a file of an audiobook is downloaded.
+final class NYPLAudiobookDownloadScheduler {
+
+  struct Configuration {
+    var maxConcurrentDownloadsOnWiFi = 4
+    var maxConcurrentDownloadsOnCellular = 2
+    var initialConcurrentDownloads = 2
+
+    /// How long a download may keep its slot while downloads of the same
+    /// priority are waiting.
+    var timeSlice: TimeInterval = 120
+
+    /// How often `tick()` should be called.
+    var tickInterval: TimeInterval = 10
+
+    /// The minimum relative throughput increase for an additional concurrent
+    /// download to be kept.
+    var minThroughputGain = 0.1
+
+    /// How many ticks to wait before trying to raise the limit again after
+    /// an increase didn't pay off.
+    var ticksBetweenProbes = 6
+  }
+
+  private final class Job {
+    let bookID: String
+    let fetcher: NYPLAudiobookFetching
+    var priority: NYPLAudiobookDownloadPriority
+    var sequence: Int
+    var isRunning = false
+    var isPaused = false
+    var sliceStart: TimeInterval = 0
+    var sampleAmount: Double = 0
+
+    init(bookID: String,
+         fetcher: NYPLAudiobookFetching,
+         priority: NYPLAudiobookDownloadPriority,
+         sequence: Int) {
+      self.bookID = bookID
+      self.fetcher = fetcher
+      self.priority = priority
+      self.sequence = sequence
+    }
+  }
+
+  private struct Probe {
+    let previousLimit: Int
+    let baseline: Double
+  }
+
+  let configuration: Configuration
+  private(set) var concurrencyLimit: Int
+  private let networkType: () -> NYPLDownloadNetworkType
+  private let now: () -> TimeInterval
+  private var jobs: [Job] = []
+  private var nextSequence = 0
+  private var probe: Probe?
+  private var ticksUntilNextProbe = 0
+
+  /// When the throughput was last measured, nil while nothing is running.
+  private var throughputSampleTime: TimeInterval?
+
+  /// The amount downloaded since `throughputSampleTime` by downloads that
+  /// were stopped or finished since then.
+  private var amountSinceSample: Double = 0
+
+  //----------------------------------------------------------------------------
+  /// - Parameters:
+  ///   - configuration: Limits and timings of the scheduler.
+  ///   - networkType: Returns the type of the current network.
+  ///   - now: Returns the current time, in seconds.
+  init(configuration: Configuration = Configuration(),
+       networkType: @escaping () -> NYPLDownloadNetworkType,
+       now: @escaping () -> TimeInterval = { ProcessInfo.processInfo.systemUptime }) {
+    self.configuration = configuration
+    self.networkType = networkType
+    self.now = now
+    self.concurrencyLimit = max(1, configuration.initialConcurrentDownloads)
+  }
+
+  var isEmpty: Bool {
+    return jobs.isEmpty
+  }
+
+  /// The downloads currently running, highest priority first.
+  var runningBookIDs: [String] {
+    return orderedJobs().filter { $0.isRunning }.map { $0.bookID }
+  }
+
+  /// The downloads waiting for a slot, in the order they will be started.
+  var waitingBookIDs: [String] {
+    return waitingJobs().map { $0.bookID }
+  }
+
+  /// The downloads that are paused.
+  var pausedBookIDs: [String] {
+    return orderedJobs().filter { $0.isPaused }.map { $0.bookID }
+  }
+
+  //----------------------------------------------------------------------------
+  func contains(_ bookID: String) -> Bool {
+    return job(for: bookID) != nil
+  }
+
+  //----------------------------------------------------------------------------
+  func isRunning(_ bookID: String) -> Bool {
+    return job(for: bookID)?.isRunning ?? false
+  }
+
+  //----------------------------------------------------------------------------
+  func isPaused(_ bookID: String) -> Bool {
+    return job(for: bookID)?.isPaused ?? false
+  }
+
+  //----------------------------------------------------------------------------
+  func fetcher(for bookID: String) -> NYPLAudiobookFetching? {
+    return job(for: bookID)?.fetcher
+  }
+
+  //----------------------------------------------------------------------------
+  /// Adds a download and starts it if a slot is available. If the audiobook
+  /// is already scheduled, its priority is raised to `priority` if higher.
+  ///
+  /// - Returns: `false` if the audiobook was already scheduled.
+  @discardableResult
+  func add(bookID: String,
+           fetcher: NYPLAudiobookFetching,
+           priority: NYPLAudiobookDownloadPriority) -> Bool {
+    if let job = job(for: bookID) {
+      if priority.rawValue > job.priority.rawValue {
+        job.priority = priority
+        scheduleDownloads()
+      }
+      return false
+    }
+
+    jobs.append(Job(bookID: bookID,
+                    fetcher: fetcher,
+                    priority: priority,
+                    sequence: makeSequence()))
+    scheduleDownloads()
+    return true
+  }
+
+  //----------------------------------------------------------------------------
+  /// Stops and forgets a download, e.g. because it was cancelled.
+  func remove(_ bookID: String) {
+    guard let job = job(for: bookID) else {
+      return
+    }
+    if job.isRunning {
+      collectSample(of: job)
+      job.fetcher.cancelFetch()
+    }
+    jobs.removeAll { $0 === job }
+    scheduleDownloads()
+  }
+
+  //----------------------------------------------------------------------------
+  /// Forgets a download that completed or failed, freeing its slot.
+  func finish(_ bookID: String) {
+    if let job = job(for: bookID), job.isRunning {
+      collectSample(of: job)
+    }
+    jobs.removeAll { $0.bookID == bookID }
+    scheduleDownloads()
+  }
+
+  //----------------------------------------------------------------------------
+  /// Stops a download until `resume(_:)` is called, giving its slot to the
+  /// next waiting download. The files already downloaded are kept.
+  func pause(_ bookID: String) {
+    guard let job = job(for: bookID), !job.isPaused else {
+      return
+    }
+    job.isPaused = true
+    if job.isRunning {
+      collectSample(of: job)
+      job.isRunning = false
+      job.fetcher.cancelFetch()
+    }
+    scheduleDownloads()
+  }
+
+  //----------------------------------------------------------------------------
+  /// Makes a paused download eligible for a slot again, at the place it had
+  /// among the downloads of the same priority.
+  func resume(_ bookID: String) {
+    guard let job = job(for: bookID), job.isPaused else {
+      return
+    }
+    job.isPaused = false
+    scheduleDownloads()
+  }
+
+  //----------------------------------------------------------------------------
+  func setPriority(_ priority: NYPLAudiobookDownloadPriority, for bookID: String) {
+    guard let job = job(for: bookID), job.priority != priority else {
+      return
+    }
+    job.priority = priority
+    scheduleDownloads()
+  }
+
+  //----------------------------------------------------------------------------
+  /// Gives the slot of a download whose time slice expired to the next
+  /// waiting download of the same or higher priority, if any. Since this only
+  /// happens between two files, a file taking longer than `timeSlice` to
+  /// download is never thrown away.
+  func fileDidComplete(for bookID: String) {
+    guard let job = job(for: bookID), job.isRunning,
+      now() - job.sliceStart >= configuration.timeSlice,
+      let next = waitingJobs().first,
+      next.priority.rawValue >= job.priority.rawValue else {
+        return
+    }
+    stop(job)
+    scheduleDownloads()
+  }
+
+  //----------------------------------------------------------------------------
+  /// Measures the throughput since the previous tick, adapts the
+  /// concurrency limit and fills the free slots.
+  func tick() {
+    adjustConcurrencyLimit(throughput: measureThroughput(at: now()))
+    scheduleDownloads()
+  }
+
+  // MARK: - Private
+
+  //----------------------------------------------------------------------------
+  private func job(for bookID: String) -> Job? {
+    return jobs.first { $0.bookID == bookID }
+  }
+
+  //----------------------------------------------------------------------------
+  private func makeSequence() -> Int {
+    nextSequence += 1
+    return nextSequence
+  }
+
+  //----------------------------------------------------------------------------
+  private func orderedJobs() -> [Job] {
+    return jobs.sorted {
+      if $0.priority != $1.priority {
+        return $0.priority.rawValue > $1.priority.rawValue
+      }
+      return $0.sequence < $1.sequence
+    }
+  }
+
+  //----------------------------------------------------------------------------
+  /// The downloads that could take a slot, in the order they would.
+  private func waitingJobs() -> [Job] {
+    return orderedJobs().filter { !$0.isRunning && !$0.isPaused }
+  }
+
+  //----------------------------------------------------------------------------
+  private func maximumConcurrency() -> Int {
+    switch networkType() {
+    case .wifi:
+      return max(1, configuration.maxConcurrentDownloadsOnWiFi)
+    case .cellular:
+      return max(1, configuration.maxConcurrentDownloadsOnCellular)
+    case .none:
+      return 1
+    }
+  }
+
+  //----------------------------------------------------------------------------
+  private func start(_ job: Job) {
+    let time = now()
+    if throughputSampleTime == nil {
+      throughputSampleTime = time
+    }
+    job.isRunning = true
+    job.sliceStart = time
+    job.sampleAmount = job.fetcher.downloadedAmount
+    job.fetcher.fetch()
+  }
+
+  //----------------------------------------------------------------------------
+  /// Stops a running download and puts it behind the other downloads of the
+  /// same priority.
+  private func stop(_ job: Job) {
+    collectSample(of: job)
+    job.isRunning = false
+    job.sequence = makeSequence()
+    job.fetcher.cancelFetch()
+  }
+
+  //----------------------------------------------------------------------------
+  /// Starts waiting downloads while slots are available, and stops running
+  /// downloads in favor of higher priority ones or when over the limit.
+  private func scheduleDownloads() {
+    concurrencyLimit = min(concurrencyLimit, maximumConcurrency())
+
+    var running = orderedJobs().filter { $0.isRunning }
+    while running.count > concurrencyLimit, let lowest = running.popLast() {
+      stop(lowest)
+    }
+
+    for candidate in waitingJobs() {
+      if running.count < concurrencyLimit {
+        start(candidate)
+        running.append(candidate)
+      } else if let lowest = running.last,
+        candidate.priority.rawValue > lowest.priority.rawValue {
+        stop(lowest)
+        running.removeLast()
+        start(candidate)
+        running.insert(candidate, at: 0)
+        running = running.sorted { $0.priority.rawValue > $1.priority.rawValue }
+      } else {
+        break
+      }
+    }
+  }
+
+  //----------------------------------------------------------------------------
+  /// Accounts for what a running download got since it was last sampled,
+  /// before it stops running.
+  private func collectSample(of job: Job) {
+    amountSinceSample += max(0, job.fetcher.downloadedAmount - job.sampleAmount)
+  }
+
+  //----------------------------------------------------------------------------
+  /// - Returns: The amount downloaded per second since the previous
+  /// measurement, including by the downloads that stopped in the meantime,
+  /// or nil if nothing was measured.
+  private func measureThroughput(at time: TimeInterval) -> Double? {
+    guard let sampleTime = throughputSampleTime else {
+      return nil
+    }
+
+    var amount = amountSinceSample
+    let runningJobs = jobs.filter { $0.isRunning }
+    for job in runningJobs {
+      let downloadedAmount = job.fetcher.downloadedAmount
+      amount += max(0, downloadedAmount - job.sampleAmount)
+      job.sampleAmount = downloadedAmount
+    }
+    amountSinceSample = 0
+    throughputSampleTime = runningJobs.isEmpty ? nil : time
+
+    guard time > sampleTime else {
+      return nil
+    }
+    return amount / (time - sampleTime)
+  }
+
+  //----------------------------------------------------------------------------
+  private func adjustConcurrencyLimit(throughput: Double?) {
+    let maximum = maximumConcurrency()
+    guard let throughput = throughput else {
+      concurrencyLimit = min(concurrencyLimit, maximum)
+      return
+    }
+
+    if let probe = probe {
+      self.probe = nil
+      if throughput < probe.baseline * (1 + configuration.minThroughputGain) {
+        Log.info(#file, "Audiobook downloads: \(concurrencyLimit) concurrent downloads didn't improve throughput, back to \(probe.previousLimit)")
+        concurrencyLimit = probe.previousLimit
+        ticksUntilNextProbe = configuration.ticksBetweenProbes
+      }
+      concurrencyLimit = min(concurrencyLimit, maximum)
+      return
+    }
+
+    if ticksUntilNextProbe > 0 {
+      ticksUntilNextProbe -= 1
+    }
+
+    let runningCount = jobs.filter { $0.isRunning }.count
+    let hasWaitingJobs = !waitingJobs().isEmpty
+    if ticksUntilNextProbe == 0,
+      concurrencyLimit < maximum,
+      runningCount >= concurrencyLimit,
+      hasWaitingJobs,
+      throughput > 0 {
+      probe = Probe(previousLimit: concurrencyLimit, baseline: throughput)
+      concurrencyLimit += 1
+      Log.info(#file, "Audiobook downloads: trying \(concurrencyLimit) concurrent downloads")
+    }
+    concurrencyLimit = min(concurrencyLimit, maximum)
+  }
+}
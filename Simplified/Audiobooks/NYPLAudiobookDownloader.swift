@@ -17,11 +17,12 @@ import NYPLUtilitiesObjc
   func audiobookDownloadDidTimeout(bookID: String, networkStatus: NetworkStatus, metadata: [String: Any])
 }
 
-class NYPLAudiobookDownloadObject {
+class NYPLAudiobookDownloadObject: NSObject {
   var bookID: String
   var audiobookManager: DefaultAudiobookManager
   var didRetryDownload: Bool = false
   var beyondTimeLimit: Bool = false
+  weak var downloader: NYPLAudiobookDownloader?
   
   init(bookID: String, audiobookManager: DefaultAudiobookManager) {
     self.bookID = bookID
@@ -29,42 +30,71 @@ class NYPLAudiobookDownloadObject {
   }
 }
 
+extension NYPLAudiobookDownloadObject: NYPLAudiobookFetching {
+  /// The duration of the audio downloaded so far, in seconds. The toolkit
+  /// doesn't report byte counts, but at a given bitrate the size of a file is
+  /// proportional to its duration, which makes this comparable across
+  /// audiobooks, unlike the fraction of each audiobook that was downloaded.
+  var downloadedAmount: Double {
+    return audiobookManager.audiobook.spine.reduce(0) {
+      $0 + Double($1.downloadTask.downloadProgress) * $1.chapter.duration
+    }
+  }
+  
+  func fetch() {
+    Log.info(#file, "Fetch initiated for \(bookID)")
+    audiobookManager.networkService.fetch()
+  }
+  
+  func cancelFetch() {
+    Log.info(#file, "Fetch stopped for \(bookID)")
+    audiobookManager.networkService.cancelFetch()
+  }
+}
+
 /// This class is designed to download audiobook files in the background.
-/// Only one audiobook would be downloaded at a time,
-/// when it completes or being cancelled, the next audiobook in queue will be downloaded.
+/// Several audiobooks are downloaded at the same time, as decided by a
+/// `NYPLAudiobookDownloadScheduler`: how many depends on the network type
+/// and on the measured throughput, and the other audiobooks wait in queue
+/// by priority, taking turns with the ones being downloaded.
 /// When the download fails, a second download attempt will be triggered immediately.
 /// If the case of a second failure, the audiobook will be removed and user can manually retry download.
 @objc class NYPLAudiobookDownloader: NSObject {
   @objc weak var delegate: NYPLAudiobookDownloadStatusDelegate?
   
   private var serialQueue: DispatchQueue = DispatchQueue(label: "org.nypl.labs.NYPLAudiobooksDownloader")
-  private var downloadObjects: [NYPLAudiobookDownloadObject] = []
-  private var currentDownloadObject: NYPLAudiobookDownloadObject?
+  private var downloadObjects: [String: NYPLAudiobookDownloadObject] = [:]
+  private lazy var scheduler = NYPLAudiobookDownloadScheduler(networkType: {
+    NYPLAudiobookDownloader.currentNetworkType()
+  })
+  private var tickTimer: DispatchSourceTimer?
   
   /// - Parameters:
   ///   - bookID: The book identifier for updating download status through delegate
   ///   - audiobookManager: Audiobook manager responsible for the download mechanism
-  ///   - isHighPriority: If `true`, the audiobook will be the next one in queue,
-  ///   download will start once the current download completes.
+  ///   - isHighPriority: If `true`, the audiobook is downloaded right away,
+  ///   pausing a lower priority download if needed.
   ///   Otherwise, audiobook will be added to end of the downlaod queue.
   ///   
-  ///   Note: Calling this function does nothing if an audiobook has already been added to queue.
+  ///   Note: Calling this function does nothing if an audiobook has already been added to queue,
+  ///   except raising its priority if `isHighPriority` is `true`.
   func downloadAudiobook(for bookID: String,
                          audiobookManager: DefaultAudiobookManager,
                          isHighPriority: Bool) {
-    guard downloadObject(for: bookID) == nil else {
-      return
-    }
-    
+    let priority: NYPLAudiobookDownloadPriority = isHighPriority ? .high : .normal
     serialQueue.async {
+      if let downloadObject = self.downloadObjects[bookID] {
+        self.scheduler.add(bookID: bookID, fetcher: downloadObject, priority: priority)
+        return
+      }
+      
       let newDownloadObject = NYPLAudiobookDownloadObject(bookID: bookID,
                                                           audiobookManager: audiobookManager)
-      if isHighPriority {
-        self.downloadObjects.insert(newDownloadObject, at: 0)
-      } else {
-        self.downloadObjects.append(newDownloadObject)
-      }
-      self.fetchNextIfNeeded()
+      newDownloadObject.downloader = self
+      audiobookManager.networkService.registerDelegate(newDownloadObject)
+      self.downloadObjects[bookID] = newDownloadObject
+      self.scheduler.add(bookID: bookID, fetcher: newDownloadObject, priority: priority)
+      self.updateTickTimer()
     }
   }
   
@@ -73,136 +103,215 @@ class NYPLAudiobookDownloadObject {
       return
     }
     
-    if let downloadObject = currentDownloadObject,
-       downloadObject.bookID == bookID {
-      cancelDownload(for: downloadObject)
-      releaseCurrentDownloadObject()
-      fetchNextIfNeeded()
-    } else if let index = downloadObjects.firstIndex(where: { $0.bookID == bookID }) {
-      cancelDownload(for: downloadObjects[index])
-      serialQueue.async {
-        _ = self.downloadObjects.remove(at: index)
+    serialQueue.async {
+      guard let downloadObject = self.downloadObjects[bookID] else {
+        return
       }
+      self.scheduler.remove(bookID)
+      self.release(downloadObject)
+      Log.info(#file, "Fetch cancelled for \(bookID)")
     }
   }
-  
+
+  /// Stops downloading the audiobook until `resumeDownload(for:)` is called.
+  /// The files already downloaded are kept, and the audiobook keeps its
+  /// place among the waiting downloads.
+  @objc func pauseDownload(for bookID: String) {
+    serialQueue.async {
+      self.scheduler.pause(bookID)
+    }
+  }
+
+  @objc func resumeDownload(for bookID: String) {
+    serialQueue.async {
+      self.scheduler.resume(bookID)
+    }
+  }
+
   @objc func audiobookManager(for bookID: String) -> DefaultAudiobookManager? {
-    return downloadObject(for: bookID)?.audiobookManager
+    return serialQueue.sync {
+      downloadObjects[bookID]?.audiobookManager
+    }
   }
   
   // MARK: - Helper
   
-  private func releaseCurrentDownloadObject() {
-    serialQueue.async {
-      self.currentDownloadObject = nil
-    }
+  /// Forgets a download that completed, failed or was cancelled.
+  /// Must be called on `serialQueue`.
+  private func release(_ downloadObject: NYPLAudiobookDownloadObject) {
+    downloadObject.audiobookManager.networkService.removeDelegate(downloadObject)
+    downloadObjects[downloadObject.bookID] = nil
+    updateTickTimer()
   }
   
-  private func fetchNextIfNeeded() {
-    serialQueue.async {
-      guard self.currentDownloadObject == nil else {
-        return
-      }
-      
-      if let downloadObject = self.downloadObjects.popFirst() {
-        Log.info(#file, "Fetch initiated for \(downloadObject.bookID)")
-        downloadObject.audiobookManager.networkService.registerDelegate(self)
-        downloadObject.audiobookManager.networkService.fetch()
-        self.currentDownloadObject = downloadObject
+  /// Keeps the scheduler ticking while there are downloads.
+  /// Must be called on `serialQueue`.
+  private func updateTickTimer() {
+    if scheduler.isEmpty {
+      tickTimer?.cancel()
+      tickTimer = nil
+    } else if tickTimer == nil {
+      let interval = scheduler.configuration.tickInterval
+      let timer = DispatchSource.makeTimerSource(queue: serialQueue)
+      timer.schedule(deadline: .now() + interval, repeating: interval)
+      timer.setEventHandler { [weak self] in
+        self?.scheduler.tick()
       }
+      tickTimer = timer
+      timer.resume()
     }
   }
   
-  private func cancelDownload(for downloadObject: NYPLAudiobookDownloadObject) {
-    serialQueue.async {
-      downloadObject.audiobookManager.networkService.cancelFetch()
-      downloadObject.audiobookManager.networkService.removeDelegate(self)
+  private class func currentNetworkType() -> NYPLDownloadNetworkType {
+    guard let manager = NYPLReachability.shared()?.hostReachabilityManager else {
+      return .none
     }
-    Log.info(#file, "Fetch cancelled for \(downloadObject.bookID)")
-  }
-  
-  private func downloadObject(for bookID: String) -> NYPLAudiobookDownloadObject? {
-    if let downloadObject = currentDownloadObject,
-       downloadObject.bookID == bookID {
-      return downloadObject
-    } else if let index = downloadObjects.firstIndex(where: { $0.bookID == bookID }) {
-      return downloadObjects[index]
+    switch manager.currentReachabilityStatus() {
+    case ReachableViaWiFi:
+      return .wifi
+    case ReachableViaWWAN:
+      return .cellular
+    default:
+      return .none
     }
-    return nil
   }
 }
 
-extension NYPLAudiobookDownloader: AudiobookNetworkServiceDelegate {
+/// Each download object is the delegate of its own network service, so that
+/// the callbacks of audiobooks downloaded at the same time can be told apart.
+extension NYPLAudiobookDownloadObject: AudiobookNetworkServiceDelegate {
   func audiobookNetworkService(_ audiobookNetworkService: AudiobookNetworkService, didCompleteDownloadFor spineElement: SpineElement) {
-    if let downloadObject = currentDownloadObject {
-      delegate?.audiobookDidUpdateDownloadProgress(audiobookNetworkService.downloadProgress,
-                                                   bookID: downloadObject.bookID)
-    }
+    downloader?.delegate?.audiobookDidUpdateDownloadProgress(audiobookNetworkService.downloadProgress,
+                                                             bookID: bookID)
+    downloader?.fileDidComplete(for: self)
   }
   
   func audiobookNetworkService(_ audiobookNetworkService: AudiobookNetworkService, didUpdateProgressFor spineElement: SpineElement) {}
   
   func audiobookNetworkService(_ audiobookNetworkService: AudiobookNetworkService, didUpdateOverallDownloadProgress progress: Float) {
-    if progress == 1,
-      let downloadObject = currentDownloadObject
-    {
-      Log.info(#file, "Audiobook - \(downloadObject.bookID) download completed and removed")
-      delegate?.audiobookDidCompleteDownload(bookID: downloadObject.bookID, beyondTimeLimit: downloadObject.beyondTimeLimit)
-      serialQueue.async {
-        downloadObject.audiobookManager.networkService.removeDelegate(self)
-      }
-
-      releaseCurrentDownloadObject()
-      fetchNextIfNeeded()
+    if progress == 1 {
+      downloader?.downloadDidComplete(self)
     }
   }
   
   func audiobookNetworkService(_ audiobookNetworkService: AudiobookNetworkService, didDeleteFileFor spineElement: SpineElement) {}
   
   func audiobookNetworkService(_ audiobookNetworkService: AudiobookNetworkService, didReceive error: NSError?, for spineElement: SpineElement) {
-    audiobookNetworkService.cancelFetch()
-    if let downloadObject = currentDownloadObject {
+    downloader?.download(self, didReceive: error)
+  }
+  
+  func audiobookNetworkService(_ audiobookNetworkService: AudiobookNetworkService,
+                               didTimeoutFor spineElement: SpineElement?,
+                               networkStatus: NetworkStatus) {
+    downloader?.download(self, didTimeoutFor: spineElement, networkStatus: networkStatus)
+  }
+  
+  func audiobookNetworkService(_ audiobookNetworkService: AudiobookNetworkService,
+                               downloadExceededTimeLimitFor spineElement: SpineElement,
+                               elapsedTime: TimeInterval,
+                               networkStatus: NetworkStatus) {
+    downloader?.download(self,
+                         exceededTimeLimitFor: spineElement,
+                         elapsedTime: elapsedTime,
+                         networkStatus: networkStatus)
+  }
+}
+
+extension NYPLAudiobookDownloader {
+  fileprivate func fileDidComplete(for downloadObject: NYPLAudiobookDownloadObject) {
+    serialQueue.async {
+      guard self.downloadObjects[downloadObject.bookID] === downloadObject else {
+        return
+      }
+      self.scheduler.fileDidComplete(for: downloadObject.bookID)
+    }
+  }
+  
+  fileprivate func downloadDidComplete(_ downloadObject: NYPLAudiobookDownloadObject) {
+    serialQueue.async {
+      guard self.downloadObjects[downloadObject.bookID] === downloadObject else {
+        return
+      }
+      Log.info(#file, "Audiobook - \(downloadObject.bookID) download completed and removed")
+      let beyondTimeLimit = downloadObject.beyondTimeLimit
+      self.notifyDelegate {
+        $0.audiobookDidCompleteDownload(bookID: downloadObject.bookID,
+                                        beyondTimeLimit: beyondTimeLimit)
+      }
+      self.scheduler.finish(downloadObject.bookID)
+      self.release(downloadObject)
+    }
+  }
+  
+  fileprivate func download(_ downloadObject: NYPLAudiobookDownloadObject, didReceive error: NSError?) {
+    serialQueue.async {
+      // Errors reported after the scheduler paused the download are the
+      // consequence of cancelling it.
+      guard self.downloadObjects[downloadObject.bookID] === downloadObject,
+        self.scheduler.isRunning(downloadObject.bookID),
+        error?.code != NSURLErrorCancelled else {
+          return
+      }
+      
+      downloadObject.audiobookManager.networkService.cancelFetch()
       if downloadObject.didRetryDownload {
         Log.error(#file, "Audiobook download failed, bookID - \(downloadObject.bookID)")
-        delegate?.audiobookDidReceiveDownloadError(error: error, bookID: downloadObject.bookID)
-        releaseCurrentDownloadObject()
-        fetchNextIfNeeded()
+        self.notifyDelegate {
+          $0.audiobookDidReceiveDownloadError(error: error, bookID: downloadObject.bookID)
+        }
+        self.scheduler.finish(downloadObject.bookID)
+        self.release(downloadObject)
       } else {
         Log.info(#file, "Audiobook retrying download, bookID - \(downloadObject.bookID)")
-        downloadObject.audiobookManager.networkService.fetch()
         downloadObject.didRetryDownload = true
+        downloadObject.audiobookManager.networkService.fetch()
       }
     }
   }
   
-  func audiobookNetworkService(_ audiobookNetworkService: AudiobookNetworkService,
-                               didTimeoutFor spineElement: SpineElement?,
-                               networkStatus: NetworkStatus) {
-    if let downloadObject = currentDownloadObject {
+  fileprivate func download(_ downloadObject: NYPLAudiobookDownloadObject,
+                            didTimeoutFor spineElement: SpineElement?,
+                            networkStatus: NetworkStatus) {
+    serialQueue.async {
+      guard self.downloadObjects[downloadObject.bookID] === downloadObject else {
+        return
+      }
       let metadata = [
         "BookID": downloadObject.bookID,
-        "Connectivity": connectivityString(networkStatus),
+        "Connectivity": self.connectivityString(networkStatus),
         "Chapter Info": spineElement?.chapter.description ?? "N/A",
       ]
-      delegate?.audiobookDownloadDidTimeout(bookID: downloadObject.bookID,
-                                            networkStatus: networkStatus,
-                                            metadata: metadata)
-      releaseCurrentDownloadObject()
-      fetchNextIfNeeded()
+      self.notifyDelegate {
+        $0.audiobookDownloadDidTimeout(bookID: downloadObject.bookID,
+                                       networkStatus: networkStatus,
+                                       metadata: metadata)
+      }
+      self.scheduler.finish(downloadObject.bookID)
+      self.release(downloadObject)
     }
   }
   
-  func audiobookNetworkService(_ audiobookNetworkService: AudiobookNetworkService,
-                               downloadExceededTimeLimitFor spineElement: SpineElement,
-                               elapsedTime: TimeInterval,
-                               networkStatus: NetworkStatus) {
+  fileprivate func download(_ downloadObject: NYPLAudiobookDownloadObject,
+                            exceededTimeLimitFor spineElement: SpineElement,
+                            elapsedTime: TimeInterval,
+                            networkStatus: NetworkStatus) {
     serialQueue.async {
-      self.currentDownloadObject?.beyondTimeLimit = true
+      downloadObject.beyondTimeLimit = true
     }
     
     Log.warn(#file, "Audiobook Download Exceeded Time Limit. Chapter: \(spineElement.chapter.description), download progress for current file - \(spineElement.downloadTask.downloadProgress * 100)%, elapsed time - \(elapsedTime)seconds, connectivity - \(connectivityString(networkStatus))")
   }
   
+  /// Delegate methods are called outside of `serialQueue`, since they may
+  /// call back into the downloader synchronously.
+  private func notifyDelegate(_ notify: @escaping (NYPLAudiobookDownloadStatusDelegate) -> Void) {
+    NYPLMainThreadRun.asyncIfNeeded {
+      if let delegate = self.delegate {
+        notify(delegate)
+      }
+    }
+  }
+  
   private func connectivityString(_  networkStatus: NetworkStatus) -> String {
     switch networkStatus {
     case ReachableViaWWAN:
@@ -16,18 +16,15 @@ struct NYPLAxisBookContentDecryptionAdapter {
   private static let aes256cbc = "http://www.w3.org/2001/04/xmlenc#aes256-cbc"
   
   let cypher: NYPLRSACryptographing
-  private let decompressor: NYPLAxisDecompression
   
   init?(cypher: NYPLRSACryptographing? = NYPLRSACypher(
-          errorLogger: NYPLAxisErrorLogsAdapter()),
-       decompressor: NYPLAxisDecompression = NYPLAxisDecompressor()) {
+          errorLogger: NYPLAxisErrorLogsAdapter())) {
     guard let cypher = cypher else {
       /// No need to log error here since cypher already logs one in case of failed initialization
       return nil
     }
     
     self.cypher = cypher
-    self.decompressor = decompressor
   }
   
   /// Decrypts given resource if encrypted. Returns original resource if not encrypted.
@@ -39,11 +36,8 @@ struct NYPLAxisBookContentDecryptionAdapter {
       return resource
     }
     
-    let resourceAdapter = NYPLFullAxisNowResourceAdapter(
-      aesKey: key, cypher: cypher, decompressor: decompressor)
-    
-    return NYPLFullAxisNowResource(
-      adapter: resourceAdapter, resource: resource)
+    return NYPLAxisStreamingResource(
+      resource: resource, decoder: NYPLAxisStreamingContentDecoder(key: key))
   }
   
   /// Decrypts the given data using private key to return `AES` key data
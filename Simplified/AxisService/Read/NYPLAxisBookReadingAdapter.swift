@@ -66,8 +66,14 @@ struct NYPLAxisBookReadingAdapter {
                                  key: Data,
                                  fetcher: Fetcher) -> ProtectedAsset {
     
+    // decrypted resources are cached for as long as the publication is open
+    let resourceCache = NYPLAxisResourceCache()
     let transformingFetcher = TransformingFetcher(fetcher: fetcher) {
-      return decryptor.decrypt(resource: $0, withKey: key)
+      guard $0.link.properties.encryption != nil else {
+        return $0
+      }
+      let decryptedResource = decryptor.decrypt(resource: $0, withKey: key)
+      return resourceCache.cachingResource(decryptedResource)
     }
     
     let protectedAsset = ProtectedAsset(asset: asset,
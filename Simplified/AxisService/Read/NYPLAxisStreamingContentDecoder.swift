@@ -0,0 +1,207 @@
+//
+//  NYPLAxisStreamingContentDecoder.swift
+//  Simplified
+//
+//  Copyright © 2026 NYPL. All rights reserved.
+//
+
+import Foundation
+import CommonCrypto
+import Compression
+
+/// Decodes the content of AxisNow resources chunk by chunk.
+///
+/// Axis resources are compressed with raw DEFLATE (no zlib header) and then
+/// encrypted with AES-256-CBC, the IV being prepended to the ciphertext as
+/// specified by XML Encryption. Instead of decrypting the whole resource and
+/// then inflating the whole decrypted data, the decoder feeds each decrypted
+/// chunk straight into an incremental inflate stream, so that only a chunk of
+/// each stage is in memory at any time and decoding can stop as soon as the
+/// requested bytes have been produced.
+final class NYPLAxisStreamingContentDecoder {
+
+  enum DecodingError: Error {
+    case truncatedData
+    case cryptorFailure(CCCryptorStatus)
+    case inflateFailure
+  }
+
+  /// Size of the encrypted chunks read from the resource, and of the
+  /// inflated chunks passed to the output handler.
+  static let chunkSize = 64 * 1024
+
+  private let key: Data
+
+  //----------------------------------------------------------------------------
+  /// - Parameter key: The AES key obtained from the book license.
+  init(key: Data) {
+    self.key = key
+  }
+
+  //----------------------------------------------------------------------------
+  /// Decodes an encrypted resource.
+  ///
+  /// - Parameters:
+  ///   - encryptedLength: Length of the encrypted resource, IV included.
+  ///   - read: Reads the given range of the encrypted resource.
+  ///   - output: Receives the decoded content in order, one chunk at a time.
+  ///   Returning `false` stops decoding.
+  /// - Throws: Any error thrown by `read`, or `DecodingError`.
+  func decode(encryptedLength: UInt64,
+              read: (Range<UInt64>) throws -> Data,
+              output: (Data) -> Bool) throws {
+    let ivLength = UInt64(kCCBlockSizeAES128)
+    guard encryptedLength >= 2 * ivLength else {
+      throw DecodingError.truncatedData
+    }
+
+    let iv = try read(0..<ivLength)
+    guard iv.count == Int(ivLength) else {
+      throw DecodingError.truncatedData
+    }
+
+    var cryptorRef: CCCryptorRef?
+    let status = key.withUnsafeBytes { keyBytes in
+      iv.withUnsafeBytes { ivBytes in
+        CCCryptorCreate(CCOperation(kCCDecrypt),
+                        CCAlgorithm(kCCAlgorithmAES),
+                        CCOptions(kCCOptionPKCS7Padding),
+                        keyBytes.baseAddress, keyBytes.count,
+                        ivBytes.baseAddress,
+                        &cryptorRef)
+      }
+    }
+    guard status == kCCSuccess, let cryptor = cryptorRef else {
+      throw DecodingError.cryptorFailure(status)
+    }
+    defer {
+      CCCryptorRelease(cryptor)
+    }
+
+    let inflater = try NYPLRawInflater(chunkSize: NYPLAxisStreamingContentDecoder.chunkSize)
+    let chunkSize = UInt64(NYPLAxisStreamingContentDecoder.chunkSize)
+    // decrypted output can exceed the input by at most one block
+    var decrypted = Data(count: Int(chunkSize) + kCCBlockSizeAES128)
+    var offset = ivLength
+
+    while offset < encryptedLength {
+      let end = min(offset + chunkSize, encryptedLength)
+      let encrypted = try read(offset..<end)
+      guard encrypted.count == Int(end - offset) else {
+        throw DecodingError.truncatedData
+      }
+      offset = end
+
+      var decryptedCount = 0
+      let updateStatus = encrypted.withUnsafeBytes { inBytes in
+        decrypted.withUnsafeMutableBytes { outBytes in
+          CCCryptorUpdate(cryptor,
+                          inBytes.baseAddress, inBytes.count,
+                          outBytes.baseAddress, outBytes.count,
+                          &decryptedCount)
+        }
+      }
+      guard updateStatus == kCCSuccess else {
+        throw DecodingError.cryptorFailure(updateStatus)
+      }
+
+      let shouldContinue = try decrypted.withUnsafeBytes {
+        try inflater.process(UnsafeRawBufferPointer(rebasing: $0[0..<decryptedCount]),
+                             isFinal: false,
+                             output: output)
+      }
+      guard shouldContinue else {
+        return
+      }
+    }
+
+    var finalCount = 0
+    let finalStatus = decrypted.withUnsafeMutableBytes { outBytes in
+      CCCryptorFinal(cryptor, outBytes.baseAddress, outBytes.count, &finalCount)
+    }
+    guard finalStatus == kCCSuccess else {
+      throw DecodingError.cryptorFailure(finalStatus)
+    }
+
+    _ = try decrypted.withUnsafeBytes {
+      try inflater.process(UnsafeRawBufferPointer(rebasing: $0[0..<finalCount]),
+                           isFinal: true,
+                           output: output)
+    }
+  }
+}
+
+/// Incremental raw DEFLATE decompression over the Compression framework.
+private final class NYPLRawInflater {
+  private let stream: UnsafeMutablePointer<compression_stream>
+  private let buffer: UnsafeMutablePointer<UInt8>
+  private let bufferSize: Int
+  private var isFinished = false
+
+  //----------------------------------------------------------------------------
+  init(chunkSize: Int) throws {
+    stream = UnsafeMutablePointer<compression_stream>.allocate(capacity: 1)
+    bufferSize = chunkSize
+    buffer = UnsafeMutablePointer<UInt8>.allocate(capacity: chunkSize)
+
+    // COMPRESSION_ZLIB is raw DEFLATE, without the zlib header
+    guard compression_stream_init(stream,
+                                  COMPRESSION_STREAM_DECODE,
+                                  COMPRESSION_ZLIB) == COMPRESSION_STATUS_OK else {
+      stream.deallocate()
+      buffer.deallocate()
+      throw NYPLAxisStreamingContentDecoder.DecodingError.inflateFailure
+    }
+  }
+
+  deinit {
+    compression_stream_destroy(stream)
+    stream.deallocate()
+    buffer.deallocate()
+  }
+
+  //----------------------------------------------------------------------------
+  /// Inflates `input`, passing the output to `output` as it's produced.
+  /// - Returns: `false` if `output` asked to stop, `true` otherwise.
+  func process(_ input: UnsafeRawBufferPointer,
+               isFinal: Bool,
+               output: (Data) -> Bool) throws -> Bool {
+    guard !isFinished else {
+      return true
+    }
+
+    // the source pointer must be valid even when there's no input
+    var emptyInput: UInt8 = 0
+    return try withUnsafePointer(to: &emptyInput) { emptyPointer in
+      stream.pointee.src_ptr = input.baseAddress?.assumingMemoryBound(to: UInt8.self)
+        ?? emptyPointer
+      stream.pointee.src_size = input.count
+      let flags = isFinal ? Int32(COMPRESSION_STREAM_FINALIZE.rawValue) : 0
+
+      while true {
+        stream.pointee.dst_ptr = buffer
+        stream.pointee.dst_size = bufferSize
+
+        let status = compression_stream_process(stream, flags)
+        let produced = bufferSize - stream.pointee.dst_size
+        if produced > 0 && !output(Data(bytes: buffer, count: produced)) {
+          return false
+        }
+
+        switch status {
+        case COMPRESSION_STATUS_END:
+          isFinished = true
+          return true
+        case COMPRESSION_STATUS_OK:
+          // done with this input once it's consumed and there is no pending
+          // output left, which is the case when the buffer wasn't filled
+          if stream.pointee.src_size == 0 && produced < bufferSize {
+            return true
+          }
+        default:
+          throw NYPLAxisStreamingContentDecoder.DecodingError.inflateFailure
+        }
+      }
+    }
+  }
+}
@@ -0,0 +1,131 @@
+//
+//  NYPLBookCoverCache.swift
+//  Simplified
+//
+//  Copyright © 2026 NYPL. All rights reserved.
+//
+
+import UIKit
+import ImageIO
+
+/// An in-memory, least-recently-used cache of decoded cover images, bounded
+/// by the number of bytes taken by their bitmaps.
+///
+/// Images stored here are expected to be already decoded (see
+/// `decodedImage(from:maxPixelSize:)`), so that displaying them doesn't
+/// trigger a decode on the main thread. This class is thread-safe.
+@objc final class NYPLBookCoverCache: NSObject {
+
+  private let cache: NYPLLRUCache<String, UIImage>
+
+  /// The maximum total cost, in bytes, of the images kept in the cache.
+  @objc var costLimit: Int {
+    return cache.costLimit
+  }
+
+  /// The current total cost, in bytes, of the images kept in the cache.
+  @objc var totalCost: Int {
+    return cache.totalCost
+  }
+
+  /// The number of lookups that found an image.
+  @objc var hitCount: Int {
+    return cache.hitCount
+  }
+
+  /// The number of lookups that didn't find an image.
+  @objc var missCount: Int {
+    return cache.missCount
+  }
+
+  //----------------------------------------------------------------------------
+  /// - Parameter costLimit: The maximum number of bytes of decoded bitmaps
+  /// the cache can hold.
+  @objc init(costLimit: Int) {
+    self.cache = NYPLLRUCache(costLimit: costLimit)
+    super.init()
+  }
+
+  //----------------------------------------------------------------------------
+  /// The key of the image of a book at `imageURL`, so that an image isn't
+  /// served anymore once the feed gives the book another one.
+  @objc(keyForBookIdentifier:imageURL:)
+  class func key(forBookIdentifier bookIdentifier: String, imageURL: URL?) -> String {
+    return "\(bookIdentifier)\n\(imageURL?.absoluteString ?? "")"
+  }
+
+  //----------------------------------------------------------------------------
+  @objc(imageForKey:)
+  func image(forKey key: String) -> UIImage? {
+    return cache.value(forKey: key)
+  }
+
+  //----------------------------------------------------------------------------
+  /// Adds `image` to the cache, evicting the least recently used images if
+  /// needed to stay within `costLimit`. Images larger than the limit are not
+  /// cached.
+  @objc(setImage:forKey:)
+  func setImage(_ image: UIImage, forKey key: String) {
+    cache.setValue(image, forKey: key, cost: NYPLBookCoverCache.cost(of: image))
+  }
+
+  //----------------------------------------------------------------------------
+  @objc(removeImageForKey:)
+  func removeImage(forKey key: String) {
+    cache.removeValue(forKey: key)
+  }
+
+  //----------------------------------------------------------------------------
+  /// Removes the images of a book, whatever their URL.
+  @objc(removeImagesForBookIdentifier:)
+  func removeImages(forBookIdentifier bookIdentifier: String) {
+    let prefix = NYPLBookCoverCache.key(forBookIdentifier: bookIdentifier, imageURL: nil)
+    cache.removeValues { $0.hasPrefix(prefix) }
+  }
+
+  //----------------------------------------------------------------------------
+  @objc func removeAllImages() {
+    cache.removeAll()
+  }
+
+  // MARK: - Decoding
+
+  //----------------------------------------------------------------------------
+  /// Decodes image data into a bitmap that can be drawn without further
+  /// decoding, downsampling it if its largest side exceeds `maxPixelSize`.
+  /// - Returns: The decoded image, or `nil` if `data` is not a valid image.
+  @objc(decodedImageFromData:maxPixelSize:)
+  class func decodedImage(from data: Data?, maxPixelSize: Int) -> UIImage? {
+    guard let data = data, !data.isEmpty else {
+      return nil
+    }
+
+    let sourceOptions = [kCGImageSourceShouldCache: false] as CFDictionary
+    guard let source = CGImageSourceCreateWithData(data as CFData, sourceOptions) else {
+      return nil
+    }
+
+    let thumbnailOptions = [
+      kCGImageSourceCreateThumbnailFromImageAlways: true,
+      kCGImageSourceCreateThumbnailWithTransform: true,
+      kCGImageSourceShouldCacheImmediately: true,
+      kCGImageSourceThumbnailMaxPixelSize: maxPixelSize
+    ] as CFDictionary
+    guard let cgImage = CGImageSourceCreateThumbnailAtIndex(source, 0, thumbnailOptions) else {
+      return nil
+    }
+
+    return UIImage(cgImage: cgImage)
+  }
+
+  // MARK: - Private
+
+  //----------------------------------------------------------------------------
+  private class func cost(of image: UIImage) -> Int {
+    if let cgImage = image.cgImage {
+      return cgImage.bytesPerRow * cgImage.height
+    }
+    let scale = image.scale
+    return Int(image.size.width * scale * image.size.height * scale * 4)
+  }
+}
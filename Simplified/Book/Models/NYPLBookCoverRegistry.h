@@ -1,9 +1,18 @@
 // This class is intended for internal use by NYPLBookRegistry only.
 
 @class NYPLBook;
+@class NYPLBookCoverCache;
 
 @interface NYPLBookCoverRegistry : NSObject
 
+// Decoded thumbnails kept in memory, keyed by book identifier. Exposed mostly so that its hit and
+// miss counts can be inspected when tuning its size.
+@property (nonatomic, readonly) NYPLBookCoverCache *thumbnailCache;
+
+// The number of thumbnail requests that joined a download already in flight for the same URL
+// instead of starting their own.
+@property (atomic, readonly) NSUInteger coalescedThumbnailRequestCount;
+
 // All handlers are called on the main thread.
 
 - (void)thumbnailImageForBook:(NYPLBook *)book
@@ -17,6 +26,10 @@
 - (void)thumbnailImagesForBooks:(NSSet *)books
                         handler:(void (^)(NSDictionary *bookIdentifiersToImages))handler;
 
+// Fetches and caches the thumbnails of books that have a thumbnail URL, so that they are available
+// when these books are shown. No cover is generated for the others, nor for failed fetches.
+- (void)warmUpThumbnailImagesForBooks:(NSSet *)books;
+
 // Immediately returns the cached thumbnail if available, else nil. Generated images are not
 // returned.
 - (UIImage *)cachedThumbnailImageForBook:(NYPLBook *)book;
@@ -12,11 +12,22 @@
 @interface NYPLBookCoverRegistry ()
 
 @property (nonatomic) NSURLSession *session;
+@property (nonatomic) NYPLBookCoverCache *thumbnailCache;
+@property (atomic) NSUInteger coalescedThumbnailRequestCount;
+
+// Maps thumbnail URLs being downloaded to the completion blocks waiting for them. Also serves as
+// the lock protecting itself.
+@property (nonatomic) NSMutableDictionary<NSURL *, NSMutableArray *> *thumbnailFetchCompletions;
 
 @end
 
 static NSUInteger const diskCacheInMegabytes = 16;
 static NSUInteger const memoryCacheInMegabytes = 2;
+static NSUInteger const thumbnailCacheInMegabytes = 24;
+
+// Thumbnails are shown at most a few hundred points tall, so larger images are downsampled when
+// decoded to keep the memory cache useful.
+static NSInteger const thumbnailMaxPixelSize = 600;
 
 @implementation NYPLBookCoverRegistry
 
@@ -56,11 +67,28 @@ static NSUInteger const memoryCacheInMegabytes = 2;
   
   self.session = [NSURLSession sessionWithConfiguration:configuration];
   
+  self.thumbnailCache = [[NYPLBookCoverCache alloc]
+                         initWithCostLimit:1024 * 1024 * thumbnailCacheInMegabytes];
+  self.thumbnailFetchCompletions = [NSMutableDictionary dictionary];
+  
+  [[NSNotificationCenter defaultCenter]
+   addObserver:self
+   selector:@selector(didReceiveMemoryWarning)
+   name:UIApplicationDidReceiveMemoryWarningNotification
+   object:nil];
+  
   return self;
 }
 
 #pragma mark -
 
+- (void)didReceiveMemoryWarning
+{
+  [self.thumbnailCache removeAllImages];
+}
+
+#pragma mark -
+
 - (NSURL *)pinnedThumbnailImageDirectoryURL
 {
   NSURL *URL = [[NYPLBookContentMetadataFilesHelper currentAccountDirectory] URLByAppendingPathComponent:@"pinned-thumbnail-images"];
@@ -94,6 +122,12 @@ static NSUInteger const memoryCacheInMegabytes = 2;
   return nil;
 }
 
+- (NSString *)thumbnailCacheKeyForBook:(NYPLBook *const)book
+{
+  return [NYPLBookCoverCache keyForBookIdentifier:book.identifier
+                                         imageURL:book.imageThumbnailURL];
+}
+
 - (void)coverImageForBook:(NYPLBook *)book handler:(void (^)(UIImage *image))handler
 {
 
@@ -117,31 +151,86 @@ static NSUInteger const memoryCacheInMegabytes = 2;
    resume];
 }
 
+// Downloads the thumbnail at |URL| and decodes it off the main thread. Concurrent requests for the
+// same URL share a single download and decode. |completion| is called on a background queue with
+// the downloaded data and the decoded image, either of which may be nil.
+- (void)fetchThumbnailImageWithURL:(NSURL *const)URL
+                        completion:(void (^const)(NSData *data, UIImage *image))completion
+{
+  if(!URL) {
+    completion(nil, nil);
+    return;
+  }
+  
+  @synchronized(self.thumbnailFetchCompletions) {
+    NSMutableArray *const completions = self.thumbnailFetchCompletions[URL];
+    if(completions) {
+      [completions addObject:completion];
+      ++self.coalescedThumbnailRequestCount;
+      return;
+    }
+    self.thumbnailFetchCompletions[URL] = [NSMutableArray arrayWithObject:completion];
+  }
+  
+  [[self.session
+    dataTaskWithRequest:[NSURLRequest requestWithURL:URL]
+    completionHandler:^(NSData *const data,
+                        __attribute__((unused)) NSURLResponse *response,
+                        __attribute__((unused)) NSError *error) {
+      UIImage *const image = [NYPLBookCoverCache decodedImageFromData:data
+                                                         maxPixelSize:thumbnailMaxPixelSize];
+      NSArray *completions;
+      @synchronized(self.thumbnailFetchCompletions) {
+        completions = self.thumbnailFetchCompletions[URL];
+        [self.thumbnailFetchCompletions removeObjectForKey:URL];
+      }
+      for(void (^const waitingCompletion)(NSData *, UIImage *) in completions) {
+        waitingCompletion(data, image);
+      }
+    }]
+   resume];
+}
+
 - (void)thumbnailImageForBook:(NYPLBook *)book handler:(void (^)(UIImage *image))handler
 {
   if(!(book && handler)) {
     @throw NSInvalidArgumentException;
   }
   
+  UIImage *const cachedImage =
+    [self.thumbnailCache imageForKey:[self thumbnailCacheKeyForBook:book]];
+  if(cachedImage) {
+    [[NSOperationQueue mainQueue] addOperationWithBlock:^{
+      handler(cachedImage);
+    }];
+    return;
+  }
+  
   BOOL const isPinned = !![[NYPLBookRegistry sharedRegistry] bookForIdentifier:book.identifier];
   NSString *filePath =  [[self URLForPinnedThumbnailImageOfBookIdentifier:book.identifier] path];
   
   if(isPinned) {
-    if (filePath) {
-      UIImage *const image = [UIImage imageWithContentsOfFile:filePath];
-      if(image) {
-        [[NSOperationQueue mainQueue] addOperationWithBlock:^{
-          handler(image);
-        }];
-        return;
+    // Reading and decoding the pinned image is done off the main thread.
+    dispatch_async(dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0), ^{
+      if (filePath) {
+        UIImage *const image = [NYPLBookCoverCache
+                                decodedImageFromData:[NSData dataWithContentsOfFile:filePath]
+                                maxPixelSize:thumbnailMaxPixelSize];
+        if(image) {
+          [self.thumbnailCache setImage:image forKey:[self thumbnailCacheKeyForBook:book]];
+          [[NSOperationQueue mainQueue] addOperationWithBlock:^{
+            handler(image);
+          }];
+          return;
+        }
       }
-    }
-    
-    // If the image didn't load, that means we still need to download the pinned image.
-    [self getBookCoverImageWithURL:book.imageThumbnailURL
-                  createFileAtPath:filePath
-                           handler:handler
-                           forBook:book];
+      
+      // If the image didn't load, that means we still need to download the pinned image.
+      [self getBookCoverImageWithURL:book.imageThumbnailURL
+                    createFileAtPath:filePath
+                             handler:handler
+                             forBook:book];
+    });
   } else {
     if(!book.imageThumbnailURL) {
       [[NSOperationQueue mainQueue] addOperationWithBlock:^{
@@ -161,31 +250,28 @@ static NSUInteger const memoryCacheInMegabytes = 2;
                      createFileAtPath:(nullable NSString *)path
                               handler:(void (^)(UIImage *image))handler
                               forBook:(nonnull NYPLBook *)book {
-  [[self.session
-    dataTaskWithRequest:[NSURLRequest requestWithURL:imageURL]
-    completionHandler:^(NSData *const data,
-                        __attribute__((unused)) NSURLResponse *response,
-                        __attribute__((unused)) NSError *error) {
-      
-      if (path) {
-        @synchronized(self) {
-          [[NSFileManager defaultManager]
-           createFileAtPath:path
-           contents:data
-           attributes:nil];
-        }
+  [self fetchThumbnailImageWithURL:imageURL completion:^(NSData *const data, UIImage *const image) {
+    if (path) {
+      @synchronized(self) {
+        [[NSFileManager defaultManager]
+         createFileAtPath:path
+         contents:data
+         attributes:nil];
       }
-        
-      [[NSOperationQueue mainQueue] addOperationWithBlock:^{
-        UIImage *const image = [UIImage imageWithData:data];
-        if (image) {
-          handler(image);
-        } else {
-          handler([NYPLTenPrintCoverView imageForBook:book]);
-        }
-      }];
-  }]
-   resume];
+    }
+    
+    if (image) {
+      [self.thumbnailCache setImage:image forKey:[self thumbnailCacheKeyForBook:book]];
+    }
+    
+    [[NSOperationQueue mainQueue] addOperationWithBlock:^{
+      if (image) {
+        handler(image);
+      } else {
+        handler([NYPLTenPrintCoverView imageForBook:book]);
+      }
+    }];
+  }];
 }
 
 - (void)thumbnailImagesForBooks:(NSSet *)books
@@ -213,9 +299,13 @@ static NSUInteger const memoryCacheInMegabytes = 2;
   __block NSUInteger remaining = books.count;
   
   for(NYPLBook *const book in books) {
-    if(!book.imageThumbnailURL) {
+    NSString *const key = [self thumbnailCacheKeyForBook:book];
+    UIImage *const cachedImage = (book.imageThumbnailURL
+                                  ? [self.thumbnailCache imageForKey:key]
+                                  : nil);
+    if(!book.imageThumbnailURL || cachedImage) {
       [lock lock];
-      dictionary[book.identifier] = [NYPLTenPrintCoverView imageForBook:book];
+      dictionary[book.identifier] = cachedImage ?: [NYPLTenPrintCoverView imageForBook:book];
       --remaining;
       if(!remaining) {
         [[NSOperationQueue mainQueue] addOperationWithBlock:^{
@@ -225,13 +315,14 @@ static NSUInteger const memoryCacheInMegabytes = 2;
       [lock unlock];
       continue;
     }
-    [[self.session
-      dataTaskWithRequest:[NSURLRequest requestWithURL:book.imageThumbnailURL]
-      completionHandler:^(NSData *const data,
-                          __attribute__((unused)) NSURLResponse *response,
-                          __attribute__((unused)) NSError *error) {
+    [self
+     fetchThumbnailImageWithURL:book.imageThumbnailURL
+     completion:^(__attribute__((unused)) NSData *const data, UIImage *const image) {
+        if(image) {
+          [self.thumbnailCache setImage:image forKey:key];
+        }
         [lock lock];
-        dictionary[book.identifier] = NYPLNullFromNil([UIImage imageWithData:data]);
+        dictionary[book.identifier] = NYPLNullFromNil(image);
         --remaining;
         if(!remaining) {
           [[NSOperationQueue mainQueue] addOperationWithBlock:^{
@@ -256,8 +347,27 @@ static NSUInteger const memoryCacheInMegabytes = 2;
           }];
         }
         [lock unlock];
-      }]
-     resume];
+      }];
+  }
+}
+
+- (void)warmUpThumbnailImagesForBooks:(NSSet *const)books
+{
+  for(NYPLBook *const book in books) {
+    if(!book.imageThumbnailURL) {
+      continue;
+    }
+    NSString *const key = [self thumbnailCacheKeyForBook:book];
+    if([self.thumbnailCache imageForKey:key]) {
+      continue;
+    }
+    [self
+     fetchThumbnailImageWithURL:book.imageThumbnailURL
+     completion:^(__attribute__((unused)) NSData *const data, UIImage *const image) {
+       if(image) {
+         [self.thumbnailCache setImage:image forKey:key];
+       }
+     }];
   }
 }
 
@@ -267,9 +377,19 @@ static NSUInteger const memoryCacheInMegabytes = 2;
     return nil;
   }
   
-  return [UIImage imageWithData:
-          [self.session.configuration.URLCache
-           cachedResponseForRequest:[NSURLRequest requestWithURL:book.imageThumbnailURL]].data];
+  UIImage *image = [self.thumbnailCache imageForKey:[self thumbnailCacheKeyForBook:book]];
+  if(image) {
+    return image;
+  }
+  
+  NSData *const data = [self.session.configuration.URLCache
+                        cachedResponseForRequest:[NSURLRequest
+                                                  requestWithURL:book.imageThumbnailURL]].data;
+  image = [NYPLBookCoverCache decodedImageFromData:data maxPixelSize:thumbnailMaxPixelSize];
+  if(image) {
+    [self.thumbnailCache setImage:image forKey:[self thumbnailCacheKeyForBook:book]];
+  }
+  return image;
 }
 
 - (void)pinThumbnailImageForBook:(NYPLBook *const)book
@@ -288,29 +408,28 @@ static NSUInteger const memoryCacheInMegabytes = 2;
      attributes:nil];
   }
   
-  [[self.session
-    dataTaskWithRequest:[NSURLRequest requestWithURL:book.imageThumbnailURL]
-    completionHandler:^(NSData *const data,
-                        __attribute__((unused)) NSURLResponse *response,
-                        __attribute__((unused)) NSError *error) {
-      if(!data || ![UIImage imageWithData:data]) {
-        return;
-      }
-      
-      if (path) {
-        @synchronized(self) {
-          [[NSFileManager defaultManager]
-           createFileAtPath:path
-           contents:data
-           attributes:nil];
-        }
-      }
-    }]
-   resume];
+  [self
+   fetchThumbnailImageWithURL:book.imageThumbnailURL
+   completion:^(NSData *const data, UIImage *const image) {
+    if(!data || !image) {
+      return;
+    }
+    
+    [self.thumbnailCache setImage:image forKey:[self thumbnailCacheKeyForBook:book]];
+    
+    @synchronized(self) {
+      [[NSFileManager defaultManager]
+       createFileAtPath:path
+       contents:data
+       attributes:nil];
+    }
+  }];
 }
 
 - (void)removePinnedThumbnailImageForBookIdentifier:(NSString *const)bookIdentifier
 {
+  [self.thumbnailCache removeImagesForBookIdentifier:bookIdentifier];
+  
   NSURL *url = [self URLForPinnedThumbnailImageOfBookIdentifier:bookIdentifier];
   if (url) {
     @synchronized(self) {
@@ -323,6 +442,8 @@ static NSUInteger const memoryCacheInMegabytes = 2;
 
 - (void)removeAllPinnedThumbnailImages
 {
+  [self.thumbnailCache removeAllImages];
+  
   @synchronized(self) {
     [[NSFileManager defaultManager]
      removeItemAtURL:[self pinnedThumbnailImageDirectoryURL]
@@ -2,12 +2,31 @@
 
 @class NYPLBook;
 @class NYPLBookLocation;
+@class NYPLOPDSEntry;
 @class NYPLReadiumBookmark;
 @class NYPLAudiobookBookmark;
 @protocol NYPLAudiobookRegistryProvider;
 
 typedef NS_ENUM(NSInteger, NYPLBookState);
 
+// The kinds of change a |NYPLBookRegistryDidChange| notification reports for each book. The
+// notification's userInfo maps book identifiers to the changes coalesced since the previous
+// notification, under |NYPLNotificationKeys.bookRegistryChangesKey|. When that key is absent (e.g.
+// after loading or resetting the registry) any book may have changed. An empty dictionary means
+// only the |syncing| status changed.
+typedef NS_OPTIONS(NSUInteger, NYPLBookRegistryChange) {
+  // The book was added, or its state changed.
+  NYPLBookRegistryChangeState = 1 << 0,
+  // The book's metadata (availability, acquisitions, etc.) changed.
+  NYPLBookRegistryChangeMetadata = 1 << 1,
+  // The reading location changed.
+  NYPLBookRegistryChangeLocation = 1 << 2,
+  // Readium, audiobook or generic bookmarks changed.
+  NYPLBookRegistryChangeBookmarks = 1 << 3,
+  // The book is no longer registered.
+  NYPLBookRegistryChangeRemoved = 1 << 4
+};
+
 @protocol NYPLBookRegistryProvider <NSObject>
 
 - (nonnull NSArray<NYPLReadiumBookmark *> *)readiumBookmarksForIdentifier:(nonnull NSString *)identifier;
@@ -91,8 +110,11 @@ typedef NS_ENUM(NSInteger, NYPLBookState);
 
  Errors are logged via NYPLErrorLogger.
 
- @param shouldResetCache Whether we should wipe the whole cache of
- loans/holds/book details/open search/ungrouped feeds in its entirety or not.
+ @param shouldResetCache Whether the loans feed must be revalidated with the
+ server instead of possibly coming from the local cache. The request is
+ conditional on the validators of the last synced feed: if the feed did not
+ change, the records are left untouched and @c fetchHandler is called with
+ @c UIBackgroundFetchResultNoData.
  @param handler Called on completion on the main thread. Not guaranteed to be
  called.
  @param fetchHandler Called on completion on the main thread while exceuting
@@ -103,6 +125,44 @@ typedef NS_ENUM(NSInteger, NYPLBookState);
          completionHandler:(void (^ _Nullable)(NSDictionary * _Nullable errorDict))handler
     backgroundFetchHandler:(void (^ _Nullable)(UIBackgroundFetchResult))fetchHandler;
 
+/**
+ Brings the records in line with the entries of a loans feed. Books missing from
+ the feed are removed and new ones added. Existing records are only updated if
+ their @c updated date, acquisitions or revoke link changed, so an unchanged
+ feed leaves the registry untouched. Observers get a single notification.
+
+ @return The number of records added, updated or removed.
+ */
+- (NSUInteger)applyLoansFeedEntries:(NSArray<NYPLOPDSEntry *> *_Nonnull)entries;
+
+/**
+ Applies the entries of a loans feed like @c applyLoansFeedEntries: and records the validators of
+ that feed, to be saved with the records by the next @c save.
+
+ @param validators The @c ETag and/or @c Last-Modified values of the feed, keyed by header name.
+ @return The number of records added, updated or removed.
+ */
+- (NSUInteger)applyLoansFeedEntries:(NSArray<NYPLOPDSEntry *> *_Nonnull)entries
+                         validators:(NSDictionary<NSString *, NSString *> *_Nullable)validators;
+
+// The validators of the loans feed the records were last synced with, sent with the next
+// conditional sync.
+@property (atomic, readonly, nullable) NSDictionary<NSString *, NSString *> *loansFeedValidators;
+
+/**
+ @return The loans feed validators saved in the registry directory @c directoryURL.
+ */
++ (nullable NSDictionary<NSString *, NSString *> *)loansFeedValidatorsInDirectory:(nonnull NSURL *)directoryURL;
+
+/**
+ Saves loans feed validators in the registry directory @c directoryURL, or removes the saved ones
+ if @c validators is nil.
+
+ @return Whether the validators could be saved.
+ */
++ (BOOL)saveLoansFeedValidators:(nullable NSDictionary<NSString *, NSString *> *)validators
+                    inDirectory:(nonnull NSURL *)directoryURL;
+
 /**
  Calls syncWithCompletionHandler: with a handler that presents standard
  success/failure alerts on completion.
@@ -263,6 +323,11 @@ genericBookmarks:(nullable NSArray<NYPLBookLocation *> *)genericBookmarks;
 - (void)thumbnailImagesForBooks:(nonnull NSSet *)books
                         handler:(void (^ _Nonnull)(NSDictionary * _Nonnull bookIdentifiersToImages))handler;
 
+// Fetches and caches the thumbnails of the given NYPLBook objects ahead of their display. Unlike
+// |thumbnailImagesForBooks:handler:|, no cover is generated on the main thread for books without a
+// thumbnail or whose thumbnail could not be fetched. May be called from any thread.
+- (void)warmUpThumbnailImagesForBooks:(nonnull NSSet *)books;
+
 // Immediately returns the cached thumbnail if available, else nil. Generated images are not
 // returned. The book does not have to be registered in order to retrieve a cover.
 - (nullable UIImage *)cachedThumbnailImageForBook:(nonnull NYPLBook *)book;
@@ -2,8 +2,10 @@
 
 #import "NYPLBook.h"
 #import "NYPLBookCoverRegistry.h"
+#import "NYPLBookRegistryJournal.h"
 #import "NYPLBookRegistryRecord.h"
 #import "NYPLJSON.h"
+#import "NYPLNull.h"
 #import "NYPLOPDS.h"
 #import "NYPLMyBooksDownloadCenter.h"
 #import "SimplyE-Swift.h"
@@ -15,12 +17,31 @@
 
 @property (nonatomic) NYPLBookCoverRegistry *coverRegistry;
 @property (nonatomic) NSMutableDictionary *identifiersToRecords;
+// Secondary index of |identifiersToRecords|: the identifiers of the records in each state, so that
+// the books in given states can be listed without scanning every record.
+@property (nonatomic) NSMutableDictionary<NSNumber *, NSMutableSet<NSString *> *> *identifiersByState;
+// Immutable arrays handed out by |booksMatchingStates:|, keyed by the states they match. A snapshot
+// is dropped when a record in one of its states is added, removed, or changes state or book.
+@property (nonatomic) NSMutableDictionary<NSArray<NSNumber *> *, NSArray<NYPLBook *> *> *booksSnapshots;
 @property (atomic) BOOL shouldBroadcast;
+// Changes made since the last |NYPLBookRegistryDidChange| notification, as NYPLBookRegistryChange
+// options keyed by book identifier. They are all sent with the next notification.
+@property (nonatomic) NSMutableDictionary<NSString *, NSNumber *> *pendingChanges;
+// Whether the next notification must tell observers that any book may have changed.
+@property (nonatomic) BOOL pendingChangesIncludeAllBooks;
+@property (nonatomic) BOOL broadcastScheduled;
 @property (atomic) BOOL syncing;
 @property (atomic) BOOL syncShouldCommit;
 @property (nonatomic) BOOL delaySync;
 @property (nonatomic, copy) void (^delayedSyncBlock)(void);
 @property (nonatomic) NSMutableSet *processingIdentifiers;
+@property (nonatomic) NYPLBookRegistryJournal *journal;
+@property (nonatomic) dispatch_queue_t compactionQueue;
+@property (nonatomic) BOOL compactionScheduled;
+// The validators of the loans feed the records were last synced with, sent with the next
+// conditional sync. They are saved next to the registry so that they never get ahead of it.
+@property (atomic) NSDictionary<NSString *, NSString *> *loansFeedValidators;
+@property (nonatomic) BOOL loansFeedValidatorsNeedSaving;
 
 @end
 
@@ -28,6 +49,41 @@ static NSString *const RegistryFilename = @"registry.json";
 
 static NSString *const RecordsKey = @"records";
 
+static NSString *const LoansFeedValidatorsFilename = @"loansFeedValidators.json";
+
+// The sequence number of the last journal entry folded into the snapshot.
+static NSString *const JournalSequenceKey = @"journalSequence";
+
+// Number of journal entries after which the snapshot is rewritten.
+static NSUInteger const JournalCompactionThreshold = 500;
+
+// Whether |book| was built from an entry identical to |entry| as far as loans go. The server bumps
+// |updated| whenever the metadata changes, while availability lives in the acquisitions.
+static BOOL BookIsUpToDateWithEntry(NYPLBook *const book, NYPLOPDSEntry *const entry)
+{
+  if(![book.updated isEqualToDate:entry.updated]
+     || book.acquisitions.count != entry.acquisitions.count) {
+    return NO;
+  }
+  
+  for(NSUInteger i = 0; i < entry.acquisitions.count; ++i) {
+    if(![book.acquisitions[i].dictionaryRepresentation
+         isEqualToDictionary:entry.acquisitions[i].dictionaryRepresentation]) {
+      return NO;
+    }
+  }
+  
+  // Returning a loan or cancelling a hold depends on this link.
+  NSURL *revokeURL = nil;
+  for(NYPLOPDSLink *const link in entry.links) {
+    if([link.rel isEqualToString:NYPLOPDSRelationAcquisitionRevoke]) {
+      revokeURL = link.href;
+      break;
+    }
+  }
+  return book.revokeURL == revokeURL || [book.revokeURL isEqual:revokeURL];
+}
+
 @implementation NYPLBookRegistry
 
 + (NYPLBookRegistry *)sharedRegistry
@@ -58,11 +114,31 @@ static NSString *const RecordsKey = @"records";
   
   self.coverRegistry = [[NYPLBookCoverRegistry alloc] init];
   self.identifiersToRecords = [NSMutableDictionary dictionary];
+  self.identifiersByState = [NSMutableDictionary dictionary];
+  self.booksSnapshots = [NSMutableDictionary dictionary];
   self.processingIdentifiers = [NSMutableSet set];
+  self.pendingChanges = [NSMutableDictionary dictionary];
   self.shouldBroadcast = YES;
+  self.compactionQueue =
+    dispatch_queue_create("org.nypl.labs.SimplyE.BookRegistry.compactionQueue",
+                          dispatch_queue_attr_make_with_qos_class(DISPATCH_QUEUE_SERIAL,
+                                                                  QOS_CLASS_UTILITY,
+                                                                  0));
+  
+  [[NSNotificationCenter defaultCenter]
+   addObserver:self
+   selector:@selector(applicationWillEnterForeground)
+   name:UIApplicationWillEnterForegroundNotification
+   object:nil];
+  
   return self;
 }
 
+- (void)dealloc
+{
+  [[NSNotificationCenter defaultCenter] removeObserver:self];
+}
+
 #pragma mark -
 
 - (NSURL *)registryDirectory
@@ -82,64 +158,96 @@ static NSString *const RecordsKey = @"records";
 
 - (NSArray<NSString *> *__nonnull)bookIdentifiersForAccount:(NSString * const)account
 {
-  NSURL *const url = [[NYPLBookContentMetadataFilesHelper directoryFor:account]
-                      URLByAppendingPathComponent:@"registry/registry.json"];
-  NSData *const data = [NSData dataWithContentsOfURL:url];
-  if (!data) {
-    return @[];
-  }
-  
-  id const json = NYPLJSONObjectFromData(data);
-  if (!json) @throw NSInternalInconsistencyException;
-  
-  NSDictionary *const dictionary = json;
-  if (![dictionary isKindOfClass:[NSDictionary class]]) @throw NSInternalInconsistencyException;
-  
-  NSArray *const records = dictionary[@"records"];
-  if (![records isKindOfClass:[NSArray class]]) @throw NSInternalInconsistencyException;
-  
-  NSMutableArray *const identifiers = [NSMutableArray arrayWithCapacity:records.count];
-  for (NSDictionary *const record in records) {
-    if (![record isKindOfClass:[NSDictionary class]]) @throw NSInternalInconsistencyException;
-    NSDictionary *const metadata = record[@"metadata"];
-    if (![metadata isKindOfClass:[NSDictionary class]]) @throw NSInternalInconsistencyException;
-    NSString *const identifier = metadata[@"id"];
-    if (![identifier isKindOfClass:[NSString class]]) @throw NSInternalInconsistencyException;
-    [identifiers addObject:identifier];
-  }
-  
-  return identifiers;
+  // The snapshot alone is not enough since books may have been added or
+  // removed by journal entries that have not been compacted yet.
+  __block NSArray<NSString *> *identifiers = nil;
+  [self performUsingAccount:account block:^{
+    identifiers = self.identifiersToRecords.allKeys;
+  }];
+  return identifiers ?: @[];
 }
 
 - (void)performSynchronizedWithoutBroadcasting:(void (^)(void))block
 {
   @synchronized(self) {
+    // Calls may be nested.
+    BOOL const shouldBroadcast = self.shouldBroadcast;
     self.shouldBroadcast = NO;
     block();
-    self.shouldBroadcast = YES;
+    self.shouldBroadcast = shouldBroadcast;
   }
 }
 
+// Tells observers that any book may have changed, e.g. after loading the registry.
 - (void)broadcastChange
 {
-  if (!self.shouldBroadcast) {
+  @synchronized(self) {
+    self.pendingChangesIncludeAllBooks = YES;
+    [self scheduleBroadcast];
+  }
+}
+
+// Must be called while synchronized on |self|.
+- (void)recordChange:(NYPLBookRegistryChange const)change forIdentifier:(NSString *const)identifier
+{
+  if(!change || !identifier) {
     return;
   }
+  
+  NSNumber *const pendingChange = self.pendingChanges[identifier];
+  self.pendingChanges[identifier] = @(pendingChange.unsignedIntegerValue | change);
+  [self scheduleBroadcast];
+}
+
+// Posts a single notification for all the changes recorded until the main queue gets to it. If
+// broadcasting is disabled, changes keep accumulating until the next broadcast after it's enabled.
+- (void)scheduleBroadcast
+{
+  @synchronized(self) {
+    if (!self.shouldBroadcast || self.broadcastScheduled) {
+      return;
+    }
+    self.broadcastScheduled = YES;
+  }
 
   // We send the notification out on the next run through the run loop to avoid deadlocks that could
   // occur due to calling synchronized methods on this object in response to a broadcast that
   // originated from within a synchronized block.
   [[NSOperationQueue mainQueue] addOperationWithBlock:^{
-    if ([UIApplication sharedApplication].applicationState == UIApplicationStateBackground) {
-      return;
+    // In the background, changes are kept for the broadcast made when the app returns to the
+    // foreground, see |applicationWillEnterForeground|.
+    BOOL const inBackground =
+      [UIApplication sharedApplication].applicationState == UIApplicationStateBackground;
+
+    NSDictionary *changes = nil;
+    @synchronized(self) {
+      self.broadcastScheduled = NO;
+      if (inBackground) {
+        return;
+      }
+      if (!self.pendingChangesIncludeAllBooks) {
+        changes = [self.pendingChanges copy];
+      }
+      self.pendingChangesIncludeAllBooks = NO;
+      [self.pendingChanges removeAllObjects];
     }
 
     [[NSNotificationCenter defaultCenter]
      postNotificationName:NSNotification.NYPLBookRegistryDidChange
-     object:self];
+     object:self
+     userInfo:(changes ? @{NYPLNotificationKeys.bookRegistryChangesKey: changes} : nil)];
   }];
 }
 
+- (void)applicationWillEnterForeground
+{
+  @synchronized(self) {
+    if (self.pendingChangesIncludeAllBooks || self.pendingChanges.count > 0) {
+      [self scheduleBroadcast];
+    }
+  }
+}
+
 - (void)broadcastProcessingChangeForIdentifier:(NSString *)identifier value:(BOOL)value
 {
   [[NSOperationQueue mainQueue] addOperationWithBlock:^{
@@ -161,53 +269,170 @@ static NSString *const RecordsKey = @"records";
 - (void)loadWithoutBroadcastingForAccount:(NSString *)account
 {
   @synchronized(self) {
-    self.identifiersToRecords = [NSMutableDictionary dictionary];
+    NSMutableDictionary *const identifiersToRecords = [NSMutableDictionary dictionary];
+    self.identifiersToRecords = identifiersToRecords;
+    self.journal = [[NYPLBookRegistryJournal alloc]
+                    initWithDirectoryURL:[self registryDirectory:account]];
     
     NSData *const savedData = [NSData dataWithContentsOfURL:
                                [[self registryDirectory:account]
                                 URLByAppendingPathComponent:RegistryFilename]];
     
-    if(!savedData) return;
+    NSUInteger snapshotSequence = 0;
+    if(savedData) {
+      NSDictionary *const dictionary = NYPLJSONObjectFromData(savedData);
+      
+      if(dictionary) {
+        snapshotSequence = [NYPLNullToNil(dictionary[JournalSequenceKey]) unsignedIntegerValue];
+        for(NSDictionary *const recordDictionary in dictionary[RecordsKey]) {
+          NYPLBookRegistryRecord *const record = [[NYPLBookRegistryRecord alloc]
+                                                  initWithDictionary:recordDictionary];
+          // If record doesn't exist, proceed to next record
+          if (!record) {
+            continue;
+          }
+          identifiersToRecords[record.book.identifier] = record;
+        }
+      } else {
+        NYPLLOG(@"Failed to interpret saved registry data as JSON.");
+      }
+    }
     
-    NSDictionary *const dictionary = NYPLJSONObjectFromData(savedData);
+    // Bring the snapshot up to date with the changes saved after it was written.
+    [self.journal replayOntoRecords:identifiersToRecords snapshotSequence:snapshotSequence];
     
-    if(!dictionary) {
-      NYPLLOG(@"Failed to interpret saved registry data as JSON.");
-      return;
-    }
+    self.loansFeedValidators =
+      [[self class] loansFeedValidatorsInDirectory:[self registryDirectory:account]];
+    self.loansFeedValidatorsNeedSaving = NO;
     
-    for(NSDictionary *const recordDictionary in dictionary[RecordsKey]) {
-      NYPLBookRegistryRecord *const record = [[NYPLBookRegistryRecord alloc]
-                                              initWithDictionary:recordDictionary];
-      // If record doesn't exist, proceed to next record
-      if (!record) {
-        continue;
-      }
+    for(NSString *const identifier in identifiersToRecords.allKeys) {
+      NYPLBookRegistryRecord *const record = identifiersToRecords[identifier];
       // If a download was still in progress when we quit, it must now be failed.
       if(record.state == NYPLBookStateDownloading || record.state == NYPLBookStateSAMLStarted) {
-        self.identifiersToRecords[record.book.identifier] =
-        [record recordWithState:NYPLBookStateDownloadFailed];
+        identifiersToRecords[identifier] = [record recordWithState:NYPLBookStateDownloadFailed];
       } else if (record.state == NYPLBookStateDownloadingUsable) {
         // If an audiobook background download was still in progress when we quit,
         // it will now be download successful and resume download when user open the book
-        self.identifiersToRecords[record.book.identifier] =
-        [record recordWithState:NYPLBookStateDownloadSuccessful];
-      } else {
-        self.identifiersToRecords[record.book.identifier] = record;
+        identifiersToRecords[identifier] = [record recordWithState:NYPLBookStateDownloadSuccessful];
       }
     }
+    
+    [self rebuildStateIndex];
+  }
+}
+
+#pragma mark State index
+
+- (NYPLBookRegistryChange)changeFromRecord:(NYPLBookRegistryRecord *const)oldRecord
+                                  toRecord:(NYPLBookRegistryRecord *const)newRecord
+{
+  if(!newRecord) {
+    return oldRecord ? NYPLBookRegistryChangeRemoved : 0;
+  }
+  if(!oldRecord) {
+    return NYPLBookRegistryChangeState;
+  }
+  
+  // Records are immutable and derived from one another, so unchanged values are shared.
+  NYPLBookRegistryChange change = 0;
+  if(oldRecord.state != newRecord.state) {
+    change |= NYPLBookRegistryChangeState;
+  }
+  if(oldRecord.book != newRecord.book) {
+    change |= NYPLBookRegistryChangeMetadata;
+  }
+  if(oldRecord.location != newRecord.location) {
+    change |= NYPLBookRegistryChangeLocation;
+  }
+  if(oldRecord.readiumBookmarks != newRecord.readiumBookmarks
+     || oldRecord.audiobookBookmarks != newRecord.audiobookBookmarks
+     || oldRecord.genericBookmarks != newRecord.genericBookmarks) {
+    change |= NYPLBookRegistryChangeBookmarks;
+  }
+  return change;
+}
+
+// Must be called while synchronized on |self|.
+- (void)rebuildStateIndex
+{
+  NSMutableDictionary *const identifiersByState = [NSMutableDictionary dictionary];
+  [self.identifiersToRecords
+   enumerateKeysAndObjectsUsingBlock:^(NSString *const identifier,
+                                       NYPLBookRegistryRecord *const record,
+                                       __attribute__((unused)) BOOL *stop) {
+    NSMutableSet *identifiers = identifiersByState[@(record.state)];
+    if(!identifiers) {
+      identifiers = [NSMutableSet set];
+      identifiersByState[@(record.state)] = identifiers;
+    }
+    [identifiers addObject:identifier];
+  }];
+  self.identifiersByState = identifiersByState;
+  self.booksSnapshots = [NSMutableDictionary dictionary];
+}
+
+// Must be called while synchronized on |self|.
+- (void)invalidateBooksSnapshotsForState:(NYPLBookState const)state
+{
+  NSNumber *const stateNumber = @(state);
+  for(NSArray<NSNumber *> *const states in self.booksSnapshots.allKeys) {
+    if([states containsObject:stateNumber]) {
+      [self.booksSnapshots removeObjectForKey:states];
+    }
+  }
+}
+
+// Replaces the record for |identifier|, or removes it if |record| is nil, keeping the state index
+// up to date. All changes to |identifiersToRecords| after loading must go through here. Must be
+// called while synchronized on |self|.
+- (void)setRecord:(NYPLBookRegistryRecord *const)record forIdentifier:(NSString *const)identifier
+{
+  NYPLBookRegistryRecord *const oldRecord = self.identifiersToRecords[identifier];
+  if(record) {
+    self.identifiersToRecords[identifier] = record;
+  } else {
+    [self.identifiersToRecords removeObjectForKey:identifier];
+  }
+  
+  [self recordChange:[self changeFromRecord:oldRecord toRecord:record] forIdentifier:identifier];
+  
+  // Changes to locations, bookmarks, etc. don't affect the books returned by state.
+  if(oldRecord && record && oldRecord.state == record.state && oldRecord.book == record.book) {
+    return;
+  }
+  
+  if(oldRecord) {
+    [self.identifiersByState[@(oldRecord.state)] removeObject:identifier];
+    [self invalidateBooksSnapshotsForState:oldRecord.state];
+  }
+  
+  if(record) {
+    NSMutableSet *identifiers = self.identifiersByState[@(record.state)];
+    if(!identifiers) {
+      identifiers = [NSMutableSet set];
+      self.identifiersByState[@(record.state)] = identifiers;
+    }
+    [identifiers addObject:identifier];
+    [self invalidateBooksSnapshotsForState:record.state];
   }
 }
 
+#pragma mark -
+
 - (void)save
 {
   if ([AccountsManager.sharedInstance currentAccount] == nil) {
     return;
   }
   @synchronized(self) {
+    NSURL *const directoryURL = self.journal.directoryURL;
+    if(!directoryURL) {
+      return;
+    }
+    
     NSError *error = nil;
     if(![[NSFileManager defaultManager]
-         createDirectoryAtURL:[self registryDirectory]
+         createDirectoryAtURL:directoryURL
          withIntermediateDirectories:YES
          attributes:nil
          error:&error]) {
@@ -215,48 +440,127 @@ static NSString *const RecordsKey = @"records";
       return;
     }
     
-    if(![[self registryDirectory] setResourceValue:@YES
-                                            forKey:NSURLIsExcludedFromBackupKey
-                                             error:&error]) {
+    if(![directoryURL setResourceValue:@YES
+                                forKey:NSURLIsExcludedFromBackupKey
+                                 error:&error]) {
       NYPLLOG(@"Failed to exclude registry directory from backup.");
       return;
     }
     
-    NSOutputStream *const stream =
-      [NSOutputStream
-       outputStreamWithURL:[[[self registryDirectory]
-                             URLByAppendingPathComponent:RegistryFilename]
-                            URLByAppendingPathExtension:@"temp"]
-       append:NO];
-      
-    [stream open];
+    // Only the changes made since the last save are written out here. The full
+    // snapshot is rewritten in the background once enough changes accumulate.
+    if(![self.journal flush]) {
+      NYPLLOG(@"Failed to write book registry journal.");
+      return;
+    }
+    
+    // Only now do the saved records match the validators.
+    if(self.loansFeedValidatorsNeedSaving) {
+      self.loansFeedValidatorsNeedSaving =
+        ![[self class] saveLoansFeedValidators:self.loansFeedValidators inDirectory:directoryURL];
+    }
     
-    // This try block is necessary to catch an (entirely undocumented) exception thrown by
-    // NSJSONSerialization in the event that the provided stream isn't open for writing.
-    @try {
+    if(self.journal.entriesSinceSnapshot >= JournalCompactionThreshold) {
+      [self scheduleCompaction];
+    }
+  }
+}
+
++ (NSDictionary<NSString *, NSString *> *)loansFeedValidatorsInDirectory:(NSURL *const)directoryURL
+{
+  NSData *const validatorsData = [NSData dataWithContentsOfURL:
+                                  [directoryURL URLByAppendingPathComponent:LoansFeedValidatorsFilename]];
+  NSDictionary *const validators = validatorsData ? NYPLJSONObjectFromData(validatorsData) : nil;
+  return [validators isKindOfClass:[NSDictionary class]] ? validators : nil;
+}
+
++ (BOOL)saveLoansFeedValidators:(NSDictionary<NSString *, NSString *> *const)validators
+                    inDirectory:(NSURL *const)directoryURL
+{
+  NSURL *const validatorsURL = [directoryURL URLByAppendingPathComponent:LoansFeedValidatorsFilename];
+  if(!validators) {
+    [[NSFileManager defaultManager] removeItemAtURL:validatorsURL error:NULL];
+  } else if(![NYPLJSONDataFromObject(validators) writeToURL:validatorsURL atomically:YES]) {
+    NYPLLOG(@"Failed to write loans feed validators.");
+    return NO;
+  }
+  return YES;
+}
+
+- (void)scheduleCompaction
+{
+  @synchronized(self) {
+    if(self.compactionScheduled) {
+      return;
+    }
+    self.compactionScheduled = YES;
+  }
+  
+  dispatch_async(self.compactionQueue, ^{
+    [self compact];
+  });
+}
+
+/**
+ Rewrites the registry snapshot so that it includes every journal entry saved
+ so far, then drops those entries from the journal. The records are immutable,
+ so only copying the dictionary happens under the lock; serializing and writing
+ the snapshot do not block readers or writers.
+ */
+- (void)compact
+{
+  NYPLBookRegistryJournal *journal = nil;
+  NSDictionary *identifiersToRecords = nil;
+  NSUInteger sequence = 0;
+  
+  @synchronized(self) {
+    self.compactionScheduled = NO;
+    journal = self.journal;
+    if(!journal || ![journal flush]) {
+      return;
+    }
+    identifiersToRecords = [self.identifiersToRecords copy];
+    sequence = journal.lastSequence;
+  }
+  
+  NSURL *const snapshotURL = [journal.directoryURL URLByAppendingPathComponent:RegistryFilename];
+  NSURL *const temporaryURL = [snapshotURL URLByAppendingPathExtension:@"temp"];
+  NSOutputStream *const stream = [NSOutputStream outputStreamWithURL:temporaryURL append:NO];
+  [stream open];
+  
+  NSError *error = nil;
+  // This try block is necessary to catch an (entirely undocumented) exception thrown by
+  // NSJSONSerialization in the event that the provided stream isn't open for writing.
+  @try {
 #pragma clang diagnostic push
 #pragma clang diagnostic ignored "-Wassign-enum"
-      if(![NSJSONSerialization
-           writeJSONObject:[self dictionaryRepresentation]
-           toStream:stream
-           options:0
-           error:&error]) {
+    if(![NSJSONSerialization
+         writeJSONObject:[self dictionaryRepresentationOfRecords:identifiersToRecords
+                                                journalSequence:sequence]
+         toStream:stream
+         options:0
+         error:&error]) {
 #pragma clang diagnostic pop
-        NYPLLOG(@"Failed to write book registry.");
-        return;
-      }
-    } @catch(NSException *const exception) {
-      NYPLLOG([exception reason]);
+      NYPLLOG(@"Failed to write book registry.");
+      return;
+    }
+  } @catch(NSException *const exception) {
+    NYPLLOG([exception reason]);
+    return;
+  } @finally {
+    [stream close];
+  }
+  
+  @synchronized(self) {
+    // The registry was reset or switched account while we were writing.
+    if(self.journal != journal) {
+      [[NSFileManager defaultManager] removeItemAtURL:temporaryURL error:NULL];
       return;
-    } @finally {
-      [stream close];
     }
     
     if(![[NSFileManager defaultManager]
-         replaceItemAtURL:[[self registryDirectory] URLByAppendingPathComponent:RegistryFilename]
-         withItemAtURL:[[[self registryDirectory]
-                         URLByAppendingPathComponent:RegistryFilename]
-                        URLByAppendingPathExtension:@"temp"]
+         replaceItemAtURL:snapshotURL
+         withItemAtURL:temporaryURL
          backupItemName:nil
          options:NSFileManagerItemReplacementUsingNewMetadataOnly
          resultingItemURL:NULL
@@ -264,6 +568,8 @@ static NSString *const RecordsKey = @"records";
       NYPLLOG(@"Failed to rename temporary registry file.");
       return;
     }
+    
+    [journal compactUpToSequence:sequence];
   }
 }
 
@@ -314,7 +620,7 @@ static NSString *const RecordsKey = @"records";
 
     self.syncing = YES;
     self.syncShouldCommit = YES;
-    [self broadcastChange];
+    [self scheduleBroadcast];
   } //@synchronized
 
   NSURL *loansURL = [[[AccountsManager sharedInstance] currentAccount] loansUrl];
@@ -327,10 +633,9 @@ static NSString *const RecordsKey = @"records";
   }
 
   NYPLLOG(@"[syncWithCompletionHandler] Begin BookRegistry syncing...");
-  [NYPLOPDSFeedFetcher fetchOPDSFeedWithUrl:loansURL
-                            networkExecutor:[NYPLNetworkExecutor shared]
-                           shouldResetCache:shouldResetCache
-                                 completion:^(NYPLOPDSFeed * _Nullable feed, NSDictionary<NSString *,id> * _Nullable errorDict) {
+  // |validators| are those of the response |feed| came with, if they can be trusted to identify it.
+  void (^const handleFeed)(NYPLOPDSFeed *, NSDictionary *, NSDictionary *) =
+    ^(NYPLOPDSFeed *const feed, NSDictionary *const validators, NSDictionary *const errorDict) {
     if(!feed) {
       [self handleSyncError:errorDict
           wasResettingCache:shouldResetCache
@@ -345,7 +650,7 @@ static NSString *const RecordsKey = @"records";
       NYPLLOG(@"[syncWithCompletionHandler] Sync shouldn't commit");
       // A reset must have occurred.
       self.syncing = NO;
-      [self broadcastChange];
+      [self scheduleBroadcast];
       [[NSOperationQueue mainQueue]
        addOperationWithBlock:^{
          if(fetchHandler) fetchHandler(UIBackgroundFetchResultNoData);
@@ -363,33 +668,14 @@ static NSString *const RecordsKey = @"records";
           NYPLLOG(@"A Licensor Token was not received or parsed from the OPDS feed.");
         }
         
-        NSMutableSet *identifiersToRemove = [NSMutableSet setWithArray:self.identifiersToRecords.allKeys];
-        for(NYPLOPDSEntry *const entry in feed.entries) {
-          NYPLBook *const book = [NYPLBook bookWithEntry:entry];
-          if(!book) {
-            NYPLLOG_F(@"Failed to create book for entry '%@'.", entry.identifier);
-            continue;
-          }
-          [identifiersToRemove removeObject:book.identifier];
-          NYPLBook *const existingBook = [self bookForIdentifier:book.identifier];
-          if(existingBook) {
-            [self updateBook:book];
-          } else {
-            [self addBook:book location:nil state:NYPLBookStateDownloadNeeded fulfillmentId:nil readiumBookmarks:nil audiobookBookmarks:nil genericBookmarks:nil];
-          }
-        }
-        for (NSString *identifier in identifiersToRemove) {
-          NYPLBookRegistryRecord *record = [self.identifiersToRecords objectForKey:identifier];
-          if (record && (record.state == NYPLBookStateDownloadSuccessful ||
-                         record.state == NYPLBookStateUsed ||
-                         record.state == NYPLBookStateDownloadingUsable)) {
-            [[NYPLMyBooksDownloadCenter sharedDownloadCenter] deleteLocalContentForBookIdentifier:identifier];
-          }
-          [self removeBookForIdentifier:identifier];
-        }
+        NSUInteger const changedCount = [self applyLoansFeedEntries:feed.entries
+                                                         validators:validators];
+        NYPLLOG_F(@"[syncWithCompletionHandler] %lu of %lu loans changed",
+                  (unsigned long)changedCount, (unsigned long)feed.entries.count);
       }];
+      // One notification for the whole loans feed.
       self.syncing = NO;
-      [self broadcastChange];
+      [self scheduleBroadcast];
       [[NSOperationQueue mainQueue]
        addOperationWithBlock:^{
          [NYPLUserNotifications updateAppIconBadgeWithHeldBooks:[self heldBooks]];
@@ -409,7 +695,107 @@ static NSString *const RecordsKey = @"records";
     } else {
       commitBlock();
     }
+  };
+  
+  if (shouldResetCache) {
+    // Revalidate with the server instead of downloading and parsing the whole feed again.
+    NSDictionary *validators = nil;
+    @synchronized(self) {
+      validators = self.loansFeedValidators;
+    }
+    [NYPLOPDSFeedFetcher fetchOPDSFeedIfModifiedWithUrl:loansURL
+                                        networkExecutor:[NYPLNetworkExecutor shared]
+                                             validators:validators
+                                             completion:^(NYPLOPDSFeed * _Nullable feed,
+                                                          NSDictionary<NSString *,NSString *> * _Nullable newValidators,
+                                                          BOOL notModified,
+                                                          NSDictionary<NSString *,id> * _Nullable errorDict) {
+      if (notModified) {
+        [self finishSyncWithoutChangesWithCompletion:completion backgroundFetchHandler:fetchHandler];
+        return;
+      }
+      handleFeed(feed, newValidators, errorDict);
+    }];
+  } else {
+    [NYPLOPDSFeedFetcher fetchOPDSFeedWithUrl:loansURL
+                              networkExecutor:[NYPLNetworkExecutor shared]
+                             shouldResetCache:NO
+                                   completion:^(NYPLOPDSFeed * _Nullable feed, NSDictionary<NSString *,id> * _Nullable errorDict) {
+      // The feed may come from the URL cache, so it may be older than the one the stored
+      // validators belong to.
+      handleFeed(feed, nil, errorDict);
+    }];
+  }
+}
+
+- (NSUInteger)applyLoansFeedEntries:(NSArray<NYPLOPDSEntry *> *const)entries
+                         validators:(NSDictionary<NSString *, NSString *> *const)validators
+{
+  __block NSUInteger changedCount = 0;
+  [self performSynchronizedWithoutBroadcasting:^{
+    changedCount = [self applyLoansFeedEntries:entries];
+    self.loansFeedValidators = validators;
+    self.loansFeedValidatorsNeedSaving = YES;
+  }];
+  return changedCount;
+}
+
+- (NSUInteger)applyLoansFeedEntries:(NSArray<NYPLOPDSEntry *> *const)entries
+{
+  __block NSUInteger changedCount = 0;
+  [self performSynchronizedWithoutBroadcasting:^{
+    NSMutableSet *identifiersToRemove = [NSMutableSet setWithArray:self.identifiersToRecords.allKeys];
+    for(NYPLOPDSEntry *const entry in entries) {
+      NYPLBookRegistryRecord *const record = self.identifiersToRecords[entry.identifier];
+      // Most loans are unchanged from one sync to the next: skip building their books.
+      if(record && BookIsUpToDateWithEntry(record.book, entry)) {
+        [identifiersToRemove removeObject:entry.identifier];
+        continue;
+      }
+      
+      NYPLBook *const book = [NYPLBook bookWithEntry:entry];
+      if(!book) {
+        NYPLLOG_F(@"Failed to create book for entry '%@'.", entry.identifier);
+        continue;
+      }
+      [identifiersToRemove removeObject:book.identifier];
+      if(record) {
+        [self updateBook:book];
+      } else {
+        [self addBook:book location:nil state:NYPLBookStateDownloadNeeded fulfillmentId:nil readiumBookmarks:nil audiobookBookmarks:nil genericBookmarks:nil];
+      }
+      ++changedCount;
+    }
+    for (NSString *identifier in identifiersToRemove) {
+      NYPLBookRegistryRecord *record = [self.identifiersToRecords objectForKey:identifier];
+      if (record && (record.state == NYPLBookStateDownloadSuccessful ||
+                     record.state == NYPLBookStateUsed ||
+                     record.state == NYPLBookStateDownloadingUsable)) {
+        [[NYPLMyBooksDownloadCenter sharedDownloadCenter] deleteLocalContentForBookIdentifier:identifier];
+      }
+      [self removeBookForIdentifier:identifier];
+      ++changedCount;
+    }
   }];
+  if(changedCount > 0) {
+    [self scheduleBroadcast];
+  }
+  return changedCount;
+}
+
+// Ends a sync whose loans feed did not change since the last one, leaving the records untouched.
+- (void)finishSyncWithoutChangesWithCompletion:(void (^)(NSDictionary *errorDict))completion
+                        backgroundFetchHandler:(void (^)(UIBackgroundFetchResult))fetchHandler
+{
+  NYPLLOG(@"[syncWithCompletionHandler] Loans feed not modified; nothing to commit");
+  self.syncing = NO;
+  [self scheduleBroadcast];
+  [[NSOperationQueue mainQueue]
+   addOperationWithBlock:^{
+     if(completion) completion(nil);
+     if(fetchHandler) fetchHandler(UIBackgroundFetchResultNoData);
+     [[NSNotificationCenter defaultCenter] postNotificationName:NSNotification.NYPLSyncEnded object:nil];
+   }];
 }
 
 - (void)handleSyncError:(NSDictionary<NSString *,id> * _Nullable)errorDict
@@ -422,7 +808,7 @@ static NSString *const RecordsKey = @"records";
   NYPLLOG_F(@"Error fetching/syncing (shouldResetCache=%d) loans: %@",
             wasResettingCache, errorDict);
   self.syncing = NO;
-  [self broadcastChange];
+  [self scheduleBroadcast];
   [[NSOperationQueue mainQueue]
    addOperationWithBlock:^{
     if(completion) {
@@ -438,13 +824,16 @@ static NSString *const RecordsKey = @"records";
 - (void)syncWithStandardAlertsOnCompletion
 {
   [self syncResettingCache:YES completionHandler:^(NSDictionary *errorDict) {
-    if (errorDict == nil) {
-      [self save];
-    } else {
+    if (errorDict != nil) {
       UIAlertController *alert = [NYPLAlertUtils alertWithTitle:@"SyncFailed"
                                                         message:@"We found a problem. Please check your connection or close and reopen the app to retry."];
       [NYPLAlertUtils presentFromViewControllerOrNilWithAlertController:alert viewController:nil animated:YES completion:nil];
     }
+  } backgroundFetchHandler:^(UIBackgroundFetchResult result) {
+    // Nothing changed if the loans feed was not modified.
+    if (result == UIBackgroundFetchResultNewData) {
+      [self save];
+    }
   }];
 }
 
@@ -492,15 +881,18 @@ genericBookmarks:(NSArray<NYPLBookLocation *> *)genericBookmarks
   
   @synchronized(self) {
     [self.coverRegistry pinThumbnailImageForBook:book];
-    self.identifiersToRecords[book.identifier] = [[NYPLBookRegistryRecord alloc]
-                                                  initWithBook:book
-                                                  location:location
-                                                  state:state
-                                                  fulfillmentId:fulfillmentId
-                                                  readiumBookmarks:readiumBookmarks
-                                                  audiobookBookmarks:audiobookBookmarks
-                                                  genericBookmarks:genericBookmarks];
-    [self broadcastChange];
+    NYPLBookRegistryRecord *const record = [[NYPLBookRegistryRecord alloc]
+                                            initWithBook:book
+                                            location:location
+                                            state:state
+                                            fulfillmentId:fulfillmentId
+                                            readiumBookmarks:readiumBookmarks
+                                            audiobookBookmarks:audiobookBookmarks
+                                            genericBookmarks:genericBookmarks];
+    [self setRecord:record forIdentifier:book.identifier];
+    [self.journal appendOperation:NYPLBookRegistryJournalOperationPut
+                       identifier:book.identifier
+                            value:[record dictionaryRepresentation]];
   }
 }
 
@@ -514,8 +906,10 @@ genericBookmarks:(NSArray<NYPLBookLocation *> *)genericBookmarks
     NYPLBookRegistryRecord *const record = self.identifiersToRecords[book.identifier];
     if(record) {
       [NYPLUserNotifications compareAvailabilityWithCachedRecord:record andNewBook:book];
-      self.identifiersToRecords[book.identifier] = [record recordWithBook:book];
-      [self broadcastChange];
+      [self setRecord:[record recordWithBook:book] forIdentifier:book.identifier];
+      [self.journal appendOperation:NYPLBookRegistryJournalOperationBook
+                         identifier:book.identifier
+                              value:[book dictionaryRepresentation]];
     }
   }
 }
@@ -530,8 +924,13 @@ genericBookmarks:(NSArray<NYPLBookLocation *> *)genericBookmarks
     NYPLBookRegistryRecord *const record = self.identifiersToRecords[book.identifier];
     if(record) {
       [self.coverRegistry removePinnedThumbnailImageForBookIdentifier:book.identifier];
-      self.identifiersToRecords[book.identifier] = [[record recordWithBook:book] recordWithState:NYPLBookStateUnregistered];
-      [self broadcastChange];
+      [self setRecord:[[record recordWithBook:book] recordWithState:NYPLBookStateUnregistered] forIdentifier:book.identifier];
+      [self.journal appendOperation:NYPLBookRegistryJournalOperationBook
+                         identifier:book.identifier
+                              value:[book dictionaryRepresentation]];
+      [self.journal appendOperation:NYPLBookRegistryJournalOperationState
+                         identifier:book.identifier
+                              value:[NYPLBookStateHelper stringValueFromBookState:NYPLBookStateUnregistered]];
     }
   }
 }
@@ -547,9 +946,11 @@ genericBookmarks:(NSArray<NYPLBookLocation *> *)genericBookmarks
     if(record) {
       book = [record.book bookWithMetadataFromBook:book];
       NYPLBookRegistryRecord *const updatedRecord = [record recordWithBook:book];
-      self.identifiersToRecords[book.identifier] = updatedRecord;
+      [self setRecord:updatedRecord forIdentifier:book.identifier];
+      [self.journal appendOperation:NYPLBookRegistryJournalOperationBook
+                         identifier:book.identifier
+                              value:[book dictionaryRepresentation]];
       NYPLBook *updatedBook = updatedRecord.book;
-      [self broadcastChange];
       return updatedBook;
     }
     return nil;
@@ -571,9 +972,10 @@ genericBookmarks:(NSArray<NYPLBookLocation *> *)genericBookmarks
       return;
     }
     
-    self.identifiersToRecords[identifier] = [record recordWithState:state];
-    
-    [self broadcastChange];
+    [self setRecord:[record recordWithState:state] forIdentifier:identifier];
+    [self.journal appendOperation:NYPLBookRegistryJournalOperationState
+                       identifier:identifier
+                            value:[NYPLBookStateHelper stringValueFromBookState:state]];
   }
 }
 
@@ -597,8 +999,10 @@ genericBookmarks:(NSArray<NYPLBookLocation *> *)genericBookmarks
       case NYPLBookStateDownloadSuccessful:
       case NYPLBookStateDownloadingUsable:
       case NYPLBookStateUsed:
-        self.identifiersToRecords[identifier] = [record recordWithState:NYPLBookStateDownloadNeeded];
-        [self broadcastChange];
+        [self setRecord:[record recordWithState:NYPLBookStateDownloadNeeded] forIdentifier:identifier];
+        [self.journal appendOperation:NYPLBookRegistryJournalOperationState
+                           identifier:identifier
+                                value:[NYPLBookStateHelper stringValueFromBookState:NYPLBookStateDownloadNeeded]];
         break;
       case NYPLBookStateUnregistered:
       case NYPLBookStateDownloadNeeded:
@@ -634,9 +1038,10 @@ genericBookmarks:(NSArray<NYPLBookLocation *> *)genericBookmarks
       @throw NSInvalidArgumentException;
     }
     
-    self.identifiersToRecords[identifier] = [record recordWithLocation:location];
-    
-    [self broadcastChange];
+    [self setRecord:[record recordWithLocation:location] forIdentifier:identifier];
+    [self.journal appendOperation:NYPLBookRegistryJournalOperationLocation
+                       identifier:identifier
+                            value:[location dictionaryRepresentation]];
   }
 }
 
@@ -656,7 +1061,10 @@ genericBookmarks:(NSArray<NYPLBookLocation *> *)genericBookmarks
       @throw NSInvalidArgumentException;
     }
     
-    self.identifiersToRecords[identifier] = [record recordWithFulfillmentId:fulfillmentId];
+    [self setRecord:[record recordWithFulfillmentId:fulfillmentId] forIdentifier:identifier];
+    [self.journal appendOperation:NYPLBookRegistryJournalOperationFulfillmentId
+                       identifier:identifier
+                            value:fulfillmentId];
     
     // This shouldn't be required, since nothing needs to display differently if the fulfillmentId changes
     // [self broadcastChange];
@@ -700,7 +1108,10 @@ genericBookmarks:(NSArray<NYPLBookLocation *> *)genericBookmarks
     }
     [bookmarks addObject:bookmark];
     
-    self.identifiersToRecords[identifier] = [record recordWithReadiumBookmarks:bookmarks];
+    [self setRecord:[record recordWithReadiumBookmarks:bookmarks] forIdentifier:identifier];
+    [self.journal appendOperation:NYPLBookRegistryJournalOperationAddReadiumBookmark
+                       identifier:identifier
+                            value:bookmark.dictionaryRepresentation];
     
     [[NYPLBookRegistry sharedRegistry] save];
   }
@@ -718,7 +1129,10 @@ genericBookmarks:(NSArray<NYPLBookLocation *> *)genericBookmarks
     }
     [bookmarks removeObject:bookmark];
     
-    self.identifiersToRecords[identifier] = [record recordWithReadiumBookmarks:bookmarks];
+    [self setRecord:[record recordWithReadiumBookmarks:bookmarks] forIdentifier:identifier];
+    [self.journal appendOperation:NYPLBookRegistryJournalOperationDeleteReadiumBookmark
+                       identifier:identifier
+                            value:bookmark.dictionaryRepresentation];
     
     [[NYPLBookRegistry sharedRegistry] save];
   }
@@ -737,7 +1151,13 @@ genericBookmarks:(NSArray<NYPLBookLocation *> *)genericBookmarks
     [bookmarks removeObject:oldBookmark];
     [bookmarks addObject:newBookmark];
 
-    self.identifiersToRecords[identifier] = [record recordWithReadiumBookmarks:bookmarks];
+    [self setRecord:[record recordWithReadiumBookmarks:bookmarks] forIdentifier:identifier];
+    [self.journal appendOperation:NYPLBookRegistryJournalOperationDeleteReadiumBookmark
+                       identifier:identifier
+                            value:oldBookmark.dictionaryRepresentation];
+    [self.journal appendOperation:NYPLBookRegistryJournalOperationAddReadiumBookmark
+                       identifier:identifier
+                            value:newBookmark.dictionaryRepresentation];
     
     [[NYPLBookRegistry sharedRegistry] save];
   }
@@ -772,7 +1192,10 @@ genericBookmarks:(NSArray<NYPLBookLocation *> *)genericBookmarks
     }
     [bookmarks addObject:bookmark];
     
-    self.identifiersToRecords[identifier] = [record recordWithAudiobookBookmarks:bookmarks];
+    [self setRecord:[record recordWithAudiobookBookmarks:bookmarks] forIdentifier:identifier];
+    [self.journal appendOperation:NYPLBookRegistryJournalOperationAddAudiobookBookmark
+                       identifier:identifier
+                            value:bookmark.dictionaryRepresentation];
     
     [[NYPLBookRegistry sharedRegistry] save];
   }
@@ -789,7 +1212,10 @@ genericBookmarks:(NSArray<NYPLBookLocation *> *)genericBookmarks
     }
     [bookmarks removeObject:audiobookBookmark];
     
-    self.identifiersToRecords[identifier] = [record recordWithAudiobookBookmarks:bookmarks];
+    [self setRecord:[record recordWithAudiobookBookmarks:bookmarks] forIdentifier:identifier];
+    [self.journal appendOperation:NYPLBookRegistryJournalOperationDeleteAudiobookBookmark
+                       identifier:identifier
+                            value:audiobookBookmark.dictionaryRepresentation];
     
     [[NYPLBookRegistry sharedRegistry] save];
   }
@@ -808,7 +1234,13 @@ genericBookmarks:(NSArray<NYPLBookLocation *> *)genericBookmarks
     [bookmarks removeObject:oldAudiobookBookmark];
     [bookmarks addObject:newAudiobookBookmark];
 
-    self.identifiersToRecords[identifier] = [record recordWithAudiobookBookmarks:bookmarks];
+    [self setRecord:[record recordWithAudiobookBookmarks:bookmarks] forIdentifier:identifier];
+    [self.journal appendOperation:NYPLBookRegistryJournalOperationDeleteAudiobookBookmark
+                       identifier:identifier
+                            value:oldAudiobookBookmark.dictionaryRepresentation];
+    [self.journal appendOperation:NYPLBookRegistryJournalOperationAddAudiobookBookmark
+                       identifier:identifier
+                            value:newAudiobookBookmark.dictionaryRepresentation];
     
     [[NYPLBookRegistry sharedRegistry] save];
   }
@@ -835,7 +1267,10 @@ genericBookmarks:(NSArray<NYPLBookLocation *> *)genericBookmarks
     }
     [bookmarks addObject:bookmark];
 
-    self.identifiersToRecords[identifier] = [record recordWithGenericBookmarks:bookmarks];
+    [self setRecord:[record recordWithGenericBookmarks:bookmarks] forIdentifier:identifier];
+    [self.journal appendOperation:NYPLBookRegistryJournalOperationAddGenericBookmark
+                       identifier:identifier
+                            value:[bookmark dictionaryRepresentation]];
 
     [[NYPLBookRegistry sharedRegistry] save];
   }
@@ -858,7 +1293,10 @@ genericBookmarks:(NSArray<NYPLBookLocation *> *)genericBookmarks
         return [object.locationString isEqualToString:bookmark.locationString] == NO;
       }]];
 
-    self.identifiersToRecords[identifier] = [record recordWithGenericBookmarks:filteredArray];
+    [self setRecord:[record recordWithGenericBookmarks:filteredArray] forIdentifier:identifier];
+    [self.journal appendOperation:NYPLBookRegistryJournalOperationDeleteGenericBookmark
+                       identifier:identifier
+                            value:[bookmark dictionaryRepresentation]];
 
     [[NYPLBookRegistry sharedRegistry] save];
   }
@@ -898,9 +1336,13 @@ genericBookmarks:(NSArray<NYPLBookLocation *> *)genericBookmarks
     // which case the book has already been removed from the registry, but we
     // still need to broadcast this removal event.
     if (identifier) {
-      [self.identifiersToRecords removeObjectForKey:identifier];
+      [self setRecord:nil forIdentifier:identifier];
+      [self.journal appendOperation:NYPLBookRegistryJournalOperationRemove
+                         identifier:identifier
+                              value:nil];
+    } else {
+      [self broadcastChange];
     }
-    [self broadcastChange];
   }
 }
 
@@ -922,6 +1364,11 @@ genericBookmarks:(NSArray<NYPLBookLocation *> *)genericBookmarks
   [self.coverRegistry thumbnailImagesForBooks:books handler:handler];
 }
 
+- (void)warmUpThumbnailImagesForBooks:(NSSet *const)books
+{
+  [self.coverRegistry warmUpThumbnailImagesForBooks:books];
+}
+
 - (UIImage *)cachedThumbnailImageForBook:(NYPLBook *const)book
 {
   return [self.coverRegistry cachedThumbnailImageForBook:book];
@@ -946,24 +1393,31 @@ genericBookmarks:(NSArray<NYPLBookLocation *> *)genericBookmarks
 {
   @synchronized(self) {
     self.syncShouldCommit = NO;
+    self.loansFeedValidators = nil;
+    self.loansFeedValidatorsNeedSaving = NO;
     [self.coverRegistry removeAllPinnedThumbnailImages];
     [self.identifiersToRecords removeAllObjects];
+    [self rebuildStateIndex];
     [[NSFileManager defaultManager] removeItemAtURL:[self registryDirectory] error:NULL];
+    // Start over with an empty journal, abandoning any pending compaction.
+    self.journal = [[NYPLBookRegistryJournal alloc] initWithDirectoryURL:[self registryDirectory]];
   }
   
   [self broadcastChange];
 }
 
-- (NSDictionary *)dictionaryRepresentation
+- (NSDictionary *)dictionaryRepresentationOfRecords:(NSDictionary *const)identifiersToRecords
+                                    journalSequence:(NSUInteger const)journalSequence
 {
   NSMutableArray *const records =
-    [NSMutableArray arrayWithCapacity:self.identifiersToRecords.count];
+    [NSMutableArray arrayWithCapacity:identifiersToRecords.count];
   
-  for(NYPLBookRegistryRecord *const record in [self.identifiersToRecords allValues]) {
+  for(NYPLBookRegistryRecord *const record in [identifiersToRecords allValues]) {
     [records addObject:[record dictionaryRepresentation]];
   }
   
-  return @{RecordsKey: records};
+  return @{RecordsKey: records,
+           JournalSequenceKey: @(journalSequence)};
 }
 
 - (NSUInteger)count
@@ -996,19 +1450,25 @@ genericBookmarks:(NSArray<NYPLBookLocation *> *)genericBookmarks
 
 - (NSArray *)booksMatchingStates:(NSArray * _Nonnull)states {
   @synchronized(self) {
-    NSMutableArray *const books =
-    [NSMutableArray arrayWithCapacity:self.identifiersToRecords.count];
+    NSArray *const snapshot = self.booksSnapshots[states];
+    if(snapshot) {
+      return snapshot;
+    }
     
-    [self.identifiersToRecords
-     enumerateKeysAndObjectsUsingBlock:^(__attribute__((unused)) NSString *identifier,
-                                         NYPLBookRegistryRecord *const record,
-                                         __attribute__((unused)) BOOL *stop) {
-      if (record.state && [states containsObject:@(record.state)]) {
-        [books addObject:record.book];
+    NSMutableArray *const books = [NSMutableArray array];
+    for(NSNumber *const state in states) {
+      // Unregistered records are never listed.
+      if(state.integerValue == NYPLBookStateUnregistered) {
+        continue;
       }
-    }];
+      for(NSString *const identifier in self.identifiersByState[state]) {
+        [books addObject:((NYPLBookRegistryRecord *)self.identifiersToRecords[identifier]).book];
+      }
+    }
     
-    return books;
+    NSArray *const newSnapshot = [books copy];
+    self.booksSnapshots[[states copy]] = newSnapshot;
+    return newSnapshot;
   }
 }
 
@@ -1037,9 +1497,19 @@ genericBookmarks:(NSArray<NYPLBookLocation *> *)genericBookmarks
       // Since the function contract specifies that the registry will not be modified
       // by `block`, we have no need to copy `self.identifiersToRecords` here.
       NSMutableDictionary *const currentIdentifiersToRecords = self.identifiersToRecords;
+      NSMutableDictionary *const currentIdentifiersByState = self.identifiersByState;
+      NSMutableDictionary *const currentBooksSnapshots = self.booksSnapshots;
+      NYPLBookRegistryJournal *const currentJournal = self.journal;
+      NSDictionary *const currentLoansFeedValidators = self.loansFeedValidators;
+      BOOL const currentLoansFeedValidatorsNeedSaving = self.loansFeedValidatorsNeedSaving;
       [self loadWithoutBroadcastingForAccount:account];
       block();
       self.identifiersToRecords = currentIdentifiersToRecords;
+      self.identifiersByState = currentIdentifiersByState;
+      self.booksSnapshots = currentBooksSnapshots;
+      self.journal = currentJournal;
+      self.loansFeedValidators = currentLoansFeedValidators;
+      self.loansFeedValidatorsNeedSaving = currentLoansFeedValidatorsNeedSaving;
     }
   }
 }
@@ -0,0 +1,75 @@
+// This class is intended for internal use by NYPLBookRegistry.
+//
+// The journal is an append-only log of per-record changes that sits next to
+// the registry snapshot (registry.json). Each mutation of the registry is
+// buffered as a small delta and appended to disk on the next save, so the cost
+// of persisting a change is proportional to the change rather than to the size
+// of the whole registry. On load, the deltas whose sequence number is greater
+// than the one stored in the snapshot are replayed on top of it. Periodically
+// the registry rewrites the snapshot and drops the entries it now contains.
+//
+// This class is not thread-safe: NYPLBookRegistry serializes all access to it.
+
+@class NYPLBookRegistryRecord;
+
+typedef NS_ENUM(NSInteger, NYPLBookRegistryJournalOperation) {
+  // Value: the record's dictionary representation.
+  NYPLBookRegistryJournalOperationPut,
+  // Value: none.
+  NYPLBookRegistryJournalOperationRemove,
+  // Value: the book's dictionary representation.
+  NYPLBookRegistryJournalOperationBook,
+  // Value: the state string, see NYPLBookStateHelper.
+  NYPLBookRegistryJournalOperationState,
+  // Value: the location's dictionary representation, or NSNull.
+  NYPLBookRegistryJournalOperationLocation,
+  // Value: the fulfillment id, or NSNull.
+  NYPLBookRegistryJournalOperationFulfillmentId,
+  // Value: the bookmark's dictionary representation.
+  NYPLBookRegistryJournalOperationAddReadiumBookmark,
+  NYPLBookRegistryJournalOperationDeleteReadiumBookmark,
+  NYPLBookRegistryJournalOperationAddAudiobookBookmark,
+  NYPLBookRegistryJournalOperationDeleteAudiobookBookmark,
+  NYPLBookRegistryJournalOperationAddGenericBookmark,
+  NYPLBookRegistryJournalOperationDeleteGenericBookmark
+};
+
+@interface NYPLBookRegistryJournal : NSObject
+
+// The directory containing both the snapshot and the journal file.
+@property (nonatomic, readonly, nonnull) NSURL *directoryURL;
+
+// The sequence number of the last entry appended, persisted or not.
+@property (nonatomic, readonly) NSUInteger lastSequence;
+
+// The number of entries, persisted or pending, not yet folded into a snapshot.
+@property (nonatomic, readonly) NSUInteger entriesSinceSnapshot;
+
++ (nonnull id)new NS_UNAVAILABLE;
+- (nonnull id)init NS_UNAVAILABLE;
+
+// designated initializer
+- (nonnull instancetype)initWithDirectoryURL:(nonnull NSURL *)directoryURL;
+
+// Reads the journal from disk and replays every entry more recent than
+// |snapshotSequence| onto |identifiersToRecords|. After this call, new entries
+// are numbered after the last one that was read. A torn trailing entry, which
+// can be left behind by a crash during an append, ends the replay.
+- (void)replayOntoRecords:(nonnull NSMutableDictionary<NSString *, NYPLBookRegistryRecord *> *)identifiersToRecords
+         snapshotSequence:(NSUInteger)snapshotSequence;
+
+// Buffers a delta for the record identified by |identifier|. |value| must be a
+// JSON-compatible object (see NYPLBookRegistryJournalOperation) or nil.
+- (void)appendOperation:(NYPLBookRegistryJournalOperation)operation
+             identifier:(nonnull NSString *)identifier
+                  value:(nullable id)value;
+
+// Appends all buffered deltas to the journal file. Returns NO on failure, in
+// which case the deltas stay buffered and will be retried on the next flush.
+- (BOOL)flush;
+
+// Drops every persisted entry whose sequence number is not greater than
+// |sequence|. Called after a snapshot including those entries has been saved.
+- (BOOL)compactUpToSequence:(NSUInteger)sequence;
+
+@end
@@ -0,0 +1,352 @@
+#import "NYPLBook.h"
+#import "NYPLBookLocation.h"
+#import "NYPLBookRegistryJournal.h"
+#import "NYPLBookRegistryRecord.h"
+#import "NYPLJSON.h"
+#import "NYPLNull.h"
+#import "SimplyE-Swift.h"
+
+#include <unistd.h>
+
+#if FEATURE_AUDIOBOOKS
+@import NYPLAudiobookToolkit;
+#endif
+
+@interface NYPLBookRegistryJournal ()
+
+@property (nonatomic) NSURL *directoryURL;
+@property (nonatomic) NSUInteger lastSequence;
+@property (nonatomic) NSUInteger persistedEntryCount;
+@property (nonatomic) NSUInteger pendingEntryCount;
+@property (nonatomic) NSMutableData *pendingData;
+
+@end
+
+static NSString *const JournalFilename = @"registry.journal";
+
+static NSString *const SequenceKey = @"seq";
+static NSString *const OperationKey = @"op";
+static NSString *const IdentifierKey = @"id";
+static NSString *const ValueKey = @"value";
+
+// These strings are persisted and must not change.
+static NSString *NYPLBookRegistryJournalOperationString(NYPLBookRegistryJournalOperation const operation)
+{
+  switch (operation) {
+    case NYPLBookRegistryJournalOperationPut:
+      return @"put";
+    case NYPLBookRegistryJournalOperationRemove:
+      return @"remove";
+    case NYPLBookRegistryJournalOperationBook:
+      return @"book";
+    case NYPLBookRegistryJournalOperationState:
+      return @"state";
+    case NYPLBookRegistryJournalOperationLocation:
+      return @"location";
+    case NYPLBookRegistryJournalOperationFulfillmentId:
+      return @"fulfillmentId";
+    case NYPLBookRegistryJournalOperationAddReadiumBookmark:
+      return @"addBookmark";
+    case NYPLBookRegistryJournalOperationDeleteReadiumBookmark:
+      return @"deleteBookmark";
+    case NYPLBookRegistryJournalOperationAddAudiobookBookmark:
+      return @"addAudiobookBookmark";
+    case NYPLBookRegistryJournalOperationDeleteAudiobookBookmark:
+      return @"deleteAudiobookBookmark";
+    case NYPLBookRegistryJournalOperationAddGenericBookmark:
+      return @"addGenericBookmark";
+    case NYPLBookRegistryJournalOperationDeleteGenericBookmark:
+      return @"deleteGenericBookmark";
+  }
+}
+
+static void NYPLBookRegistryJournalApplyEntry(NSDictionary *const entry,
+                                              NSMutableDictionary *const identifiersToRecords)
+{
+  NSString *const operation = entry[OperationKey];
+  NSString *const identifier = entry[IdentifierKey];
+  id const value = NYPLNullToNil(entry[ValueKey]);
+
+  if (![operation isKindOfClass:[NSString class]] || ![identifier isKindOfClass:[NSString class]]) {
+    return;
+  }
+
+  if ([operation isEqualToString:@"put"]) {
+    NYPLBookRegistryRecord *const record = [[NYPLBookRegistryRecord alloc] initWithDictionary:value];
+    if (record) {
+      identifiersToRecords[identifier] = record;
+    }
+    return;
+  }
+
+  if ([operation isEqualToString:@"remove"]) {
+    [identifiersToRecords removeObjectForKey:identifier];
+    return;
+  }
+
+  // All remaining operations modify an existing record.
+  NYPLBookRegistryRecord *const record = identifiersToRecords[identifier];
+  if (!record) {
+    return;
+  }
+
+  NYPLBookRegistryRecord *updatedRecord = nil;
+
+  if ([operation isEqualToString:@"book"]) {
+    NYPLBook *const book = [[NYPLBook alloc] initWithDictionary:value];
+    if (book) {
+      updatedRecord = [record recordWithBook:book];
+    }
+  } else if ([operation isEqualToString:@"state"]) {
+    NSNumber *const state = [NYPLBookStateHelper bookStateFromString:value];
+    if (state) {
+      updatedRecord = [record recordWithState:state.integerValue];
+    }
+  } else if ([operation isEqualToString:@"location"]) {
+    updatedRecord = [record recordWithLocation:(value
+                                                ? [[NYPLBookLocation alloc] initWithDictionary:value]
+                                                : nil)];
+  } else if ([operation isEqualToString:@"fulfillmentId"]) {
+    updatedRecord = [record recordWithFulfillmentId:value];
+  } else if ([operation isEqualToString:@"addBookmark"]
+             || [operation isEqualToString:@"deleteBookmark"]) {
+    NYPLReadiumBookmark *const bookmark = [[NYPLReadiumBookmark alloc] initWithDictionary:value];
+    if (bookmark) {
+      NSMutableArray *const bookmarks = record.readiumBookmarks.mutableCopy ?: [NSMutableArray array];
+      if ([operation isEqualToString:@"addBookmark"]) {
+        [bookmarks addObject:bookmark];
+      } else {
+        [bookmarks removeObject:bookmark];
+      }
+      updatedRecord = [record recordWithReadiumBookmarks:bookmarks];
+    }
+  } else if ([operation isEqualToString:@"addAudiobookBookmark"]
+             || [operation isEqualToString:@"deleteAudiobookBookmark"]) {
+#if FEATURE_AUDIOBOOKS
+    NYPLAudiobookBookmark *const bookmark = [[NYPLAudiobookBookmark alloc] initWithDictionary:value];
+    if (bookmark) {
+      NSMutableArray *const bookmarks = record.audiobookBookmarks.mutableCopy ?: [NSMutableArray array];
+      if ([operation isEqualToString:@"addAudiobookBookmark"]) {
+        [bookmarks addObject:bookmark];
+      } else {
+        [bookmarks removeObject:bookmark];
+      }
+      updatedRecord = [record recordWithAudiobookBookmarks:bookmarks];
+    }
+#endif
+  } else if ([operation isEqualToString:@"addGenericBookmark"]
+             || [operation isEqualToString:@"deleteGenericBookmark"]) {
+    NYPLBookLocation *const bookmark = [[NYPLBookLocation alloc] initWithDictionary:value];
+    if (bookmark) {
+      NSMutableArray *const bookmarks = record.genericBookmarks.mutableCopy ?: [NSMutableArray array];
+      if ([operation isEqualToString:@"addGenericBookmark"]) {
+        [bookmarks addObject:bookmark];
+      } else {
+        [bookmarks filterUsingPredicate:
+         [NSPredicate predicateWithBlock:
+          ^BOOL(NYPLBookLocation *object, __unused NSDictionary *bindings) {
+            return [object.locationString isEqualToString:bookmark.locationString] == NO;
+          }]];
+      }
+      updatedRecord = [record recordWithGenericBookmarks:bookmarks];
+    }
+  } else {
+    NYPLLOG_F(@"Ignoring unknown book registry journal operation '%@'.", operation);
+  }
+
+  if (updatedRecord) {
+    identifiersToRecords[identifier] = updatedRecord;
+  }
+}
+
+// Splits the journal into its entries, calling |block| with each decoded entry
+// and the offset just past its line. Returns the length of the valid prefix of
+// |data|, which is shorter than |data| only if the last line is torn.
+static NSUInteger NYPLBookRegistryJournalEnumerateEntries(NSData *const data,
+                                                          void (^block)(NSDictionary *entry,
+                                                                        NSUInteger endOffset))
+{
+  uint8_t const *const bytes = data.bytes;
+  NSUInteger const length = data.length;
+  NSUInteger lineStart = 0;
+
+  for (NSUInteger i = 0; i < length; ++i) {
+    if (bytes[i] != '\n') {
+      continue;
+    }
+    NSDictionary *const entry =
+      NYPLJSONObjectFromData([data subdataWithRange:NSMakeRange(lineStart, i - lineStart)]);
+    if (![entry isKindOfClass:[NSDictionary class]]
+        || ![entry[SequenceKey] isKindOfClass:[NSNumber class]]) {
+      break;
+    }
+    lineStart = i + 1;
+    block(entry, lineStart);
+  }
+
+  return lineStart;
+}
+
+@implementation NYPLBookRegistryJournal
+
+- (instancetype)initWithDirectoryURL:(NSURL *const)directoryURL
+{
+  self = [super init];
+  if(!self) return nil;
+
+  if(!directoryURL) {
+    @throw NSInvalidArgumentException;
+  }
+
+  self.directoryURL = directoryURL;
+  self.pendingData = [NSMutableData data];
+
+  return self;
+}
+
+- (NSURL *)journalURL
+{
+  return [self.directoryURL URLByAppendingPathComponent:JournalFilename];
+}
+
+- (NSUInteger)entriesSinceSnapshot
+{
+  return self.persistedEntryCount + self.pendingEntryCount;
+}
+
+- (void)replayOntoRecords:(NSMutableDictionary<NSString *, NYPLBookRegistryRecord *> *const)identifiersToRecords
+         snapshotSequence:(NSUInteger const)snapshotSequence
+{
+  self.lastSequence = snapshotSequence;
+  self.persistedEntryCount = 0;
+
+  NSData *const data = [NSData dataWithContentsOfURL:[self journalURL]];
+  if (!data) {
+    return;
+  }
+
+  NSUInteger const validLength =
+    NYPLBookRegistryJournalEnumerateEntries(data, ^(NSDictionary *entry,
+                                                    __unused NSUInteger endOffset) {
+      NSUInteger const sequence = [entry[SequenceKey] unsignedIntegerValue];
+      if (sequence <= snapshotSequence) {
+        return;
+      }
+      NYPLBookRegistryJournalApplyEntry(entry, identifiersToRecords);
+      self.lastSequence = MAX(self.lastSequence, sequence);
+      self.persistedEntryCount += 1;
+    });
+
+  if (validLength < data.length) {
+    // Drop the torn entry so that later appends are not stranded behind it.
+    NYPLLOG(@"Discarding torn entry at the end of the book registry journal.");
+    if (![[data subdataWithRange:NSMakeRange(0, validLength)]
+          writeToURL:[self journalURL]
+          atomically:YES]) {
+      NYPLLOG(@"Failed to truncate book registry journal.");
+    }
+  }
+}
+
+- (void)appendOperation:(NYPLBookRegistryJournalOperation const)operation
+             identifier:(NSString *const)identifier
+                  value:(id const)value
+{
+  if (!identifier) {
+    return;
+  }
+
+  NSDictionary *const entry = @{SequenceKey: @(self.lastSequence + 1),
+                                OperationKey: NYPLBookRegistryJournalOperationString(operation),
+                                IdentifierKey: identifier,
+                                ValueKey: NYPLNullFromNil(value)};
+  NSData *const data = NYPLJSONDataFromObject(entry);
+  if (!data) {
+    NYPLLOG_F(@"Failed to serialize book registry journal entry for '%@'.", identifier);
+    return;
+  }
+
+  self.lastSequence += 1;
+  self.pendingEntryCount += 1;
+  [self.pendingData appendData:data];
+  [self.pendingData appendBytes:"\n" length:1];
+}
+
+- (BOOL)flush
+{
+  if (self.pendingData.length == 0) {
+    return YES;
+  }
+
+  NSString *const path = [self journalURL].path;
+  unsigned long long const originalLength =
+    [[[NSFileManager defaultManager] attributesOfItemAtPath:path error:NULL] fileSize];
+
+  NSOutputStream *const stream = [NSOutputStream outputStreamWithURL:[self journalURL] append:YES];
+  [stream open];
+
+  uint8_t const *const bytes = self.pendingData.bytes;
+  NSUInteger const length = self.pendingData.length;
+  NSUInteger written = 0;
+  while (written < length) {
+    NSInteger const result = [stream write:bytes + written maxLength:length - written];
+    if (result <= 0) {
+      break;
+    }
+    written += (NSUInteger)result;
+  }
+  [stream close];
+
+  if (written < length) {
+    // Remove any partial line so the retry on the next flush starts on a clean
+    // line. If this fails too, the torn entry is discarded on the next load.
+    NYPLLOG(@"Failed to append to book registry journal.");
+    if (written > 0) {
+      truncate(path.fileSystemRepresentation, (off_t)originalLength);
+    }
+    return NO;
+  }
+
+  self.persistedEntryCount += self.pendingEntryCount;
+  self.pendingEntryCount = 0;
+  [self.pendingData setLength:0];
+  return YES;
+}
+
+- (BOOL)compactUpToSequence:(NSUInteger const)sequence
+{
+  NSData *const data = [NSData dataWithContentsOfURL:[self journalURL]];
+  if (!data) {
+    self.persistedEntryCount = 0;
+    return YES;
+  }
+
+  __block NSUInteger keepFromOffset = 0;
+  __block NSUInteger keptEntryCount = 0;
+  NSUInteger const validLength =
+    NYPLBookRegistryJournalEnumerateEntries(data, ^(NSDictionary *entry, NSUInteger endOffset) {
+      if ([entry[SequenceKey] unsignedIntegerValue] <= sequence) {
+        keepFromOffset = endOffset;
+      } else {
+        keptEntryCount += 1;
+      }
+    });
+
+  if (keptEntryCount == 0) {
+    NSError *error = nil;
+    if (![[NSFileManager defaultManager] removeItemAtURL:[self journalURL] error:&error]) {
+      NYPLLOG_F(@"Failed to remove compacted book registry journal: %@", error);
+      return NO;
+    }
+  } else if (![[data subdataWithRange:NSMakeRange(keepFromOffset, validLength - keepFromOffset)]
+               writeToURL:[self journalURL]
+               atomically:YES]) {
+    NYPLLOG(@"Failed to rewrite compacted book registry journal.");
+    return NO;
+  }
+
+  self.persistedEntryCount = keptEntryCount;
+  return YES;
+}
+
+@end
@@ -4,6 +4,7 @@
 // of this class should set the relevant properties of the collection view appropriately to handle
 // their unique needs.
 
+@class NYPLBook;
 @class NYPLReauthenticator;
 
 @interface NYPLBookCellCollectionViewController : UIViewController
@@ -14,9 +15,15 @@
 - (id)initWithCoder:(NSCoder *)aDecoder NS_UNAVAILABLE;
 - (id)initWithNibName:(NSString *)nibNameOrNil bundle:(NSBundle *)nibBundleOrNil NS_UNAVAILABLE;
 
-// Called whenever the book registry issues notifications, thus triggering a reload of the
+// Called whenever the book registry issues notifications, thus triggering an update of the
 // collection view. Subclasses should do whatever they need to do here *before* the view is
-// reloaded, e.g. recalculating the order in which cells should later be provided.
+// updated, e.g. recalculating the order in which cells should later be provided.
 - (void)willReloadCollectionViewData;
 
+// Returns the books provided for each section of the collection view, as last computed in
+// |willReloadCollectionViewData|. Subclasses that return them get book registry changes applied as
+// batch updates of the affected cells instead of a reload of the whole collection view. The
+// default implementation returns nil.
+- (NSArray<NSArray<NYPLBook *> *> *)booksBySection;
+
 @end
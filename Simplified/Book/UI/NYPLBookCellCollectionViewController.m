@@ -64,9 +64,8 @@
     addObserverForName:NSNotification.NYPLBookRegistryDidChange
     object:nil
     queue:[NSOperationQueue mainQueue]
-    usingBlock:^(__attribute__((unused)) NSNotification *note) {
-      [self willReloadCollectionViewData];
-      [self.collectionView reloadData];
+    usingBlock:^(NSNotification *note) {
+      [self bookRegistryDidChange:note];
     }]];
   
   [self.observers addObject:
@@ -74,13 +73,22 @@
     addObserverForName:NSNotification.NYPLMyBooksDownloadCenterDidChange
     object:nil
     queue:[NSOperationQueue mainQueue]
-    usingBlock:^(__attribute__((unused)) NSNotification *note) {
+    usingBlock:^(NSNotification *note) {
+      // Without a progress snapshot, any book may have changed.
+      NSDictionary<NSString *, NSNumber *> *const progressChanges =
+        note.userInfo[NYPLNotificationKeys.downloadProgressChangesKey];
       for(UICollectionViewCell *const cell in [self.collectionView visibleCells]) {
         if([cell isKindOfClass:[NYPLBookDownloadingCell class]]) {
           NYPLBookDownloadingCell *const downloadingCell = (NYPLBookDownloadingCell *)cell;
           NSString *const bookIdentifier = downloadingCell.book.identifier;
-          double downloadProgress = [[NYPLMyBooksDownloadCenter sharedDownloadCenter]
-                                     downloadProgressForBookIdentifier:bookIdentifier];
+          NSNumber *const changedProgress = progressChanges[bookIdentifier];
+          if(progressChanges && !changedProgress) {
+            continue;
+          }
+          double downloadProgress = (changedProgress
+                                     ? changedProgress.doubleValue
+                                     : [[NYPLMyBooksDownloadCenter sharedDownloadCenter]
+                                        downloadProgressForBookIdentifier:bookIdentifier]);
           downloadingCell.downloadProgress = downloadProgress;
 #if FEATURE_AUDIOBOOKS
           if (downloadingCell.book.defaultBookContentType == NYPLBookContentTypeAudiobook
@@ -198,4 +206,102 @@ minimumLineSpacingForSectionAtIndex:(__attribute__((unused)) NSInteger)section
   
 }
 
+- (NSArray<NSArray<NYPLBook *> *> *)booksBySection
+{
+  return nil;
+}
+
+- (void)bookRegistryDidChange:(NSNotification *const)note
+{
+  NSDictionary<NSString *, NSNumber *> *const changes =
+    note.userInfo[NYPLNotificationKeys.bookRegistryChangesKey];
+  NSArray<NSArray<NYPLBook *> *> *const oldSections = [self booksBySection];
+  
+  if(!changes || !oldSections) {
+    [self willReloadCollectionViewData];
+    [self.collectionView reloadData];
+    return;
+  }
+  
+  // Only the syncing status changed.
+  if(changes.count == 0) {
+    return;
+  }
+  
+  [self willReloadCollectionViewData];
+  NSArray<NSArray<NYPLBook *> *> *const newSections = [self booksBySection];
+  
+  BOOL canUpdateItems = (newSections.count == oldSections.count &&
+                         [self.collectionView numberOfSections] == (NSInteger)oldSections.count);
+  
+  NSMutableArray<NSIndexPath *> *const deletedIndexPaths = [NSMutableArray array];
+  NSMutableArray<NSIndexPath *> *const insertedIndexPaths = [NSMutableArray array];
+  NSMutableArray<NSIndexPath *> *const reloadedIndexPaths = [NSMutableArray array];
+  
+  for(NSUInteger section = 0; canUpdateItems && section < oldSections.count; ++section) {
+    NSArray<NSString *> *const oldIdentifiers = [oldSections[section] valueForKey:@"identifier"];
+    NSArray<NSString *> *const newIdentifiers = [newSections[section] valueForKey:@"identifier"];
+    if([self.collectionView numberOfItemsInSection:(NSInteger)section] != (NSInteger)oldIdentifiers.count) {
+      canUpdateItems = NO;
+      break;
+    }
+    
+    NSSet<NSString *> *const oldIdentifierSet = [NSSet setWithArray:oldIdentifiers];
+    NSSet<NSString *> *const newIdentifierSet = [NSSet setWithArray:newIdentifiers];
+    NSMutableArray<NSString *> *const oldKeptIdentifiers = [NSMutableArray array];
+    NSMutableArray<NSString *> *const newKeptIdentifiers = [NSMutableArray array];
+    
+    [oldIdentifiers enumerateObjectsUsingBlock:^(NSString *const identifier,
+                                                 NSUInteger const item,
+                                                 __attribute__((unused)) BOOL *stop) {
+      if([newIdentifierSet containsObject:identifier]) {
+        [oldKeptIdentifiers addObject:identifier];
+      } else {
+        [deletedIndexPaths addObject:[NSIndexPath indexPathForItem:(NSInteger)item inSection:(NSInteger)section]];
+      }
+    }];
+    
+    [newIdentifiers enumerateObjectsUsingBlock:^(NSString *const identifier,
+                                                 NSUInteger const item,
+                                                 __attribute__((unused)) BOOL *stop) {
+      NSIndexPath *const indexPath = [NSIndexPath indexPathForItem:(NSInteger)item inSection:(NSInteger)section];
+      if(![oldIdentifierSet containsObject:identifier]) {
+        [insertedIndexPaths addObject:indexPath];
+        return;
+      }
+      [newKeptIdentifiers addObject:identifier];
+      // Reloaded at their index after the deletions and insertions.
+      NYPLBookRegistryChange const change = changes[identifier].unsignedIntegerValue;
+      if(change & (NYPLBookRegistryChangeState | NYPLBookRegistryChangeMetadata)) {
+        [reloadedIndexPaths addObject:indexPath];
+      }
+    }];
+    
+    // Books that moved relative to one another, e.g. after their title changed, are not worth
+    // animating.
+    if(![oldKeptIdentifiers isEqualToArray:newKeptIdentifiers]) {
+      canUpdateItems = NO;
+    }
+  }
+  
+  if(!canUpdateItems) {
+    [self.collectionView reloadData];
+    return;
+  }
+  
+  // A reload is a deletion and an insertion at the same index path, so it can't be part of the same
+  // batch as other deletions and insertions. The collection view applies the second update once the
+  // first one is done, by which time |reloadedIndexPaths| match the new sections.
+  if(deletedIndexPaths.count > 0 || insertedIndexPaths.count > 0) {
+    [self.collectionView performBatchUpdates:^{
+      [self.collectionView deleteItemsAtIndexPaths:deletedIndexPaths];
+      [self.collectionView insertItemsAtIndexPaths:insertedIndexPaths];
+    } completion:nil];
+  }
+  
+  if(reloadedIndexPaths.count > 0) {
+    [self.collectionView reloadItemsAtIndexPaths:reloadedIndexPaths];
+  }
+}
+
 @end
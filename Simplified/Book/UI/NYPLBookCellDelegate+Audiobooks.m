@@ -239,7 +239,8 @@
 #if FEATURE_OVERDRIVE_AUTH
 - (void)updateODAudiobookManifest:(NSNotification *)notif
 {
-  NSString *bookID = notif.userInfo[NYPLNotificationKeys.bookIDKey];
+  NSString *const notifiedBookID = notif.userInfo[NYPLNotificationKeys.bookIDKey];
+  NSString *const bookID = self.book.identifier;
 
   // if MyBooks changed for any reason but a book update (in which case we
   // would have a nonnull book ID), then it must mean it's either a reset or
@@ -247,12 +248,20 @@
   // specific book.
   // Note that if for whatever reason AudioBookVC is deallocated before this
   // callback is called, `self.book` will be nil or potentially *different*.
-  if (bookID == nil || bookID.isEmptyNoWhitespace) {
+  if (notifiedBookID == nil || notifiedBookID.isEmptyNoWhitespace || bookID == nil) {
     [[NSNotificationCenter defaultCenter] removeObserver:self];
     [self.refreshAudiobookLock unlock];
     return;
   }
 
+  // Changes of several books are coalesced in one notification, and
+  // `notifiedBookID` is only one of them: wait for one including our book.
+  NSDictionary *const progressChanges =
+    notif.userInfo[NYPLNotificationKeys.downloadProgressChangesKey];
+  if (progressChanges[bookID] == nil) {
+    return;
+  }
+
   NYPLBookState bookState = [[NYPLBookRegistry sharedRegistry]
                              stateForIdentifier:bookID];
   if (bookState == NYPLBookStateDownloadFailed) {
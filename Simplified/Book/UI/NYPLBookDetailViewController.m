@@ -61,12 +61,12 @@
   }
 
   [[NSNotificationCenter defaultCenter] addObserver:self
-                                           selector:@selector(bookRegistryDidChange)
+                                           selector:@selector(bookRegistryDidChange:)
                                                name:NSNotification.NYPLBookRegistryDidChange
                                              object:nil];
 
   [[NSNotificationCenter defaultCenter] addObserver:self
-                                           selector:@selector(myBooksDidChange)
+                                           selector:@selector(myBooksDidChange:)
                                                name:NSNotification.NYPLMyBooksDownloadCenterDidChange
                                              object:nil];
 
@@ -321,8 +321,14 @@
   }
 }
 
-- (void)myBooksDidChange
+- (void)myBooksDidChange:(NSNotification *)note
 {
+  NSDictionary<NSString *, NSNumber *> *const progressChanges =
+    note.userInfo[NYPLNotificationKeys.downloadProgressChangesKey];
+  if(progressChanges && !progressChanges[self.book.identifier]) {
+    return;
+  }
+
   [NYPLMainThreadRun asyncIfNeeded:^{
     __auto_type myBooks = [NYPLMyBooksDownloadCenter sharedDownloadCenter];
     __auto_type bookID = self.book.identifier;
@@ -332,8 +338,14 @@
   }];
 }
 
-- (void)bookRegistryDidChange
+- (void)bookRegistryDidChange:(NSNotification *)note
 {
+  NSDictionary<NSString *, NSNumber *> *const changes =
+    note.userInfo[NYPLNotificationKeys.bookRegistryChangesKey];
+  if(changes && !changes[self.book.identifier]) {
+    return;
+  }
+  
   [NYPLMainThreadRun asyncIfNeeded:^{
     NYPLBookRegistry *registry = [NYPLBookRegistry sharedRegistry];
     NYPLBook *newBook = [registry bookForIdentifier:self.book.identifier];
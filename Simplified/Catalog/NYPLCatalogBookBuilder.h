@@ -0,0 +1,17 @@
+@class NYPLOPDSEntry;
+
+// Builds the books of catalog feeds from their OPDS entries. Large feeds are split into ranges of
+// entries that are built in parallel, on as many threads as there are active processors; the
+// results are always in feed order. The registry is only accessed on the calling thread, so the
+// caller may hold the registry's lock.
+@interface NYPLCatalogBookBuilder : NSObject
+
++ (id)new NS_UNAVAILABLE;
+- (id)init NS_UNAVAILABLE;
+
+// Returns an array with one object per element of |entries|, in the same order: the book built from
+// the entry, updated with the registry's metadata if the book is in the registry, or NSNull if no
+// book could be built or if the book has no acquisition the app supports.
++ (NSArray *)booksOrNullsWithEntries:(NSArray<NYPLOPDSEntry *> *)entries;
+
+@end
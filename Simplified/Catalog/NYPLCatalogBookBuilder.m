@@ -0,0 +1,94 @@
+#import "NYPLBook.h"
+#import "NYPLBookRegistry.h"
+#import "NYPLNull.h"
+#import "NYPLOPDS.h"
+#import "SimplyE-Swift.h"
+
+#import "NYPLCatalogBookBuilder.h"
+
+// Building a book takes a few microseconds, so fewer entries than this per range aren't worth
+// dispatching to another thread.
+static NSUInteger const minimumEntriesPerRange = 16;
+
+@implementation NYPLCatalogBookBuilder
+
++ (NYPLBook *)supportedBookWithEntry:(NYPLOPDSEntry *const)entry
+{
+  NYPLBook *const book = [NYPLBook bookWithEntry:entry];
+  if(!book) {
+    NYPLLOG_F(@"Failed to create book from entry: %@", entry.title);
+    return nil;
+  }
+  
+  if(!book.defaultAcquisition) {
+    // The application is not able to support this, so we ignore it.
+    return nil;
+  }
+  
+  return book;
+}
+
++ (NSArray *)booksOrNullsWithEntries:(NSArray<NYPLOPDSEntry *> *const)entries
+{
+  if(!entries) {
+    @throw NSInvalidArgumentException;
+  }
+  
+  NSTimeInterval const startTime = [NSProcessInfo processInfo].systemUptime;
+  NSUInteger const entryCount = entries.count;
+  NSUInteger const rangeCount = MAX(1U, MIN([NSProcessInfo processInfo].activeProcessorCount,
+                                            entryCount / minimumEntriesPerRange));
+  NSUInteger const rangeLength = (entryCount + rangeCount - 1) / rangeCount;
+  
+  // Each range of entries is built into its own array, stored at the index of the range.
+  NSMutableArray *const rangeResults = [NSMutableArray arrayWithCapacity:rangeCount];
+  for(NSUInteger i = 0; i < rangeCount; ++i) {
+    [rangeResults addObject:@[]];
+  }
+  
+  void (^const buildRange)(size_t) = ^(size_t const rangeIndex) {
+    NSUInteger const location = rangeIndex * rangeLength;
+    NSUInteger const end = MIN(location + rangeLength, entryCount);
+    if(location >= end) {
+      return;
+    }
+    NSMutableArray *const booksOrNulls = [NSMutableArray arrayWithCapacity:end - location];
+    for(NSUInteger i = location; i < end; ++i) {
+      [booksOrNulls addObject:NYPLNullFromNil([self supportedBookWithEntry:entries[i]])];
+    }
+    @synchronized(rangeResults) {
+      rangeResults[rangeIndex] = booksOrNulls;
+    }
+  };
+  
+  if(rangeCount == 1) {
+    buildRange(0);
+  } else {
+    dispatch_apply(rangeCount, dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0), buildRange);
+  }
+  
+  NSMutableArray *const booksOrNulls = [NSMutableArray arrayWithCapacity:entryCount];
+  for(NSArray *const rangeResult in rangeResults) {
+    [booksOrNulls addObjectsFromArray:rangeResult];
+  }
+  
+  // The registry is only updated on the calling thread, after the parallel part: the workers would
+  // otherwise wait on the registry's lock, which the caller may be holding.
+  NYPLBookRegistry *const registry = [NYPLBookRegistry sharedRegistry];
+  for(NSUInteger i = 0; i < entryCount; ++i) {
+    NYPLBook *const book = NYPLNullToNil(booksOrNulls[i]);
+    NYPLBook *const updatedBook = book ? [registry updatedBookMetadata:book] : nil;
+    if(updatedBook) {
+      booksOrNulls[i] = updatedBook;
+    }
+  }
+  
+  NYPLLOG_F(@"Built %lu entries in %lu range(s) in %.3fs.",
+            (unsigned long)entryCount,
+            (unsigned long)rangeCount,
+            [NSProcessInfo processInfo].systemUptime - startTime);
+  
+  return booksOrNulls;
+}
+
+@end
@@ -43,8 +43,9 @@
     return nil;
   }
 
-  NYPLXML *const XML = [NYPLXML XMLWithData:data];
-  if(!XML) {
+  NSTimeInterval const startTime = [NSProcessInfo processInfo].systemUptime;
+  NYPLOPDSFeedParser *const parser = data ? [[NYPLOPDSFeedParser alloc] initWithData:data] : nil;
+  if(![parser parse]) {
     NYPLLOG(@"Cannot initialize due to invalid XML.");
     [NYPLErrorLogger
      logCatalogInitErrorWithCode:NYPLErrorCodeInvalidXML
@@ -52,7 +53,7 @@
     return nil;
   }
 
-  NYPLOPDSFeed *const feed = [[NYPLOPDSFeed alloc] initWithXML:XML];
+  NYPLOPDSFeed *const feed = parser.feed;
   if(!feed) {
     NYPLLOG(@"Cannot initialize due to XML not representing an OPDS feed.");
     [NYPLErrorLogger
@@ -61,17 +62,25 @@
     return nil;
   }
 
+  NSTimeInterval const parseEndTime = [NSProcessInfo processInfo].systemUptime;
+
   switch(feed.type) {
-    case NYPLOPDSFeedTypeAcquisitionGrouped:
+    case NYPLOPDSFeedTypeAcquisitionGrouped: {
+      NYPLCatalogGroupedFeed *const groupedFeed = [[NYPLCatalogGroupedFeed alloc]
+                                                   initWithOPDSFeed:feed];
+      [self logBuildTimeOfFeed:feed startTime:startTime parseEndTime:parseEndTime];
       return [[NYPLCatalogGroupedFeedViewController alloc]
-              initWithGroupedFeed:[[NYPLCatalogGroupedFeed alloc]
-                                   initWithOPDSFeed:feed]
+              initWithGroupedFeed:groupedFeed
               remoteViewController:remoteVC];
-    case NYPLOPDSFeedTypeAcquisitionUngrouped:
+    }
+    case NYPLOPDSFeedTypeAcquisitionUngrouped: {
+      NYPLCatalogUngroupedFeed *const ungroupedFeed = [[NYPLCatalogUngroupedFeed alloc]
+                                                       initWithOPDSFeed:feed];
+      [self logBuildTimeOfFeed:feed startTime:startTime parseEndTime:parseEndTime];
       return [[NYPLCatalogUngroupedFeedViewController alloc]
-              initWithUngroupedFeed:[[NYPLCatalogUngroupedFeed alloc]
-                                     initWithOPDSFeed:feed]
+              initWithUngroupedFeed:ungroupedFeed
               remoteViewController:remoteVC];
+    }
     case NYPLOPDSFeedTypeInvalid:
       NYPLLOG(@"Cannot initialize due to invalid feed.");
       [NYPLErrorLogger
@@ -80,12 +89,24 @@
        metadata:@{ @"feedType": @(feed.type)}];
       return nil;
     case NYPLOPDSFeedTypeNavigation: {
-      return [NYPLCatalogFeedViewController navigationFeedWithData:XML
+      return [NYPLCatalogFeedViewController navigationFeedWithData:parser.feedXML
                                                           remoteVC:remoteVC];
     }
   }
 }
 
++ (void)logBuildTimeOfFeed:(NYPLOPDSFeed *const)feed
+                 startTime:(NSTimeInterval const)startTime
+              parseEndTime:(NSTimeInterval const)parseEndTime
+{
+  NSTimeInterval const endTime = [NSProcessInfo processInfo].systemUptime;
+  NYPLLOG_F(@"Feed with %lu entries: parsed in %.3fs, books built in %.3fs, total %.3fs.",
+            (unsigned long)feed.entries.count,
+            parseEndTime - startTime,
+            endTime - parseEndTime,
+            endTime - startTime);
+}
+
 // Only NavigationType Feed currently supported in the app is for two
 // "Instant Classic" feeds presented based on user's age.
 + (UIViewController *)navigationFeedWithData:(NYPLXML *)data
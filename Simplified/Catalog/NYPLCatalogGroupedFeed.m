@@ -1,6 +1,7 @@
 #import "NYPLAsync.h"
 #import "NYPLBook.h"
 #import "NYPLBookRegistry.h"
+#import "NYPLCatalogBookBuilder.h"
 #import "NYPLCatalogLane.h"
 #import "NYPLNull.h"
 #import "NYPLOPDS.h"
@@ -91,29 +92,27 @@
   NSMutableDictionary *const groupTitleToMutableBookArray = [NSMutableDictionary dictionary];
   NSMutableDictionary *const groupTitleToURLOrNull = [NSMutableDictionary dictionary];
   
+  NSMutableArray<NYPLOPDSEntry *> *const groupedEntries =
+    [NSMutableArray arrayWithCapacity:feed.entries.count];
   for(NYPLOPDSEntry *const entry in feed.entries) {
     if(!entry.groupAttributes) {
       NYPLLOG(@"Ignoring entry with missing group.");
       continue;
     }
-    
-    NSString *const groupTitle = entry.groupAttributes.title;
-    
-    NYPLBook *book = [NYPLBook bookWithEntry:entry];
+    [groupedEntries addObject:entry];
+  }
+  
+  // Books of all lanes are built at once, so that the work is spread evenly across threads.
+  NSArray *const booksOrNulls = [NYPLCatalogBookBuilder booksOrNullsWithEntries:groupedEntries];
+  
+  for(NSUInteger i = 0; i < groupedEntries.count; ++i) {
+    NYPLOPDSEntry *const entry = groupedEntries[i];
+    NYPLBook *const book = NYPLNullToNil(booksOrNulls[i]);
     if(!book) {
-      NYPLLOG_F(@"Failed to create book from entry: %@",entry.title);
-      continue;
-    }
-
-    if(!book.defaultAcquisition) {
-      // The application is not able to support this, so we ignore it.
       continue;
     }
     
-    NYPLBook *updatedBook = [[NYPLBookRegistry sharedRegistry] updatedBookMetadata:book];
-    if(updatedBook) {
-      book = updatedBook;
-    }
+    NSString *const groupTitle = entry.groupAttributes.title;
     
     NSMutableArray *const bookArray = groupTitleToMutableBookArray[groupTitle];
     if(bookArray) {
@@ -10,6 +10,7 @@
 #import "NYPLCatalogUngroupedFeed.h"
 #import "NYPLOpenSearchDescription.h"
 #import "NYPLReloadView.h"
+#import "UICollectionView+NYPLCollectionViewAdditions.h"
 #import "UIView+NYPLViewAdditions.h"
 #import "SimplyE-Swift.h"
 
@@ -181,11 +182,20 @@ didSelectItemAtIndexPath:(NSIndexPath *const)indexPath
 
 #pragma mark NYPLCatalogUngroupedFeedDelegate
 
-- (void)catalogUngroupedFeed:(__attribute__((unused))
-                              NYPLCatalogUngroupedFeed *)catalogUngroupedFeed
-              didUpdateBooks:(__attribute__((unused)) NSArray *)books
+- (void)catalogUngroupedFeed:(NYPLCatalogUngroupedFeed *)catalogUngroupedFeed
+     didUpdateBooksAtIndexes:(NSIndexSet *const)indexes
 {
-  [self.collectionView reloadData];
+  if(catalogUngroupedFeed != self.feed) {
+    return;
+  }
+
+  // Filtered results from the search description don't share the feed's indexes.
+  if(_books) {
+    [self.collectionView reloadData];
+    return;
+  }
+
+  [self.collectionView reloadItemsInFirstSectionAtIndexes:indexes];
 }
 
 - (void)catalogUngroupedFeed:(__unused NYPLCatalogUngroupedFeed *)catalogUngroupedFeed
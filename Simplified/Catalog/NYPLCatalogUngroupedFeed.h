@@ -4,9 +4,10 @@
 
 @protocol NYPLCatalogUngroupedFeedDelegate
 
-// Called only when existing books have been updated.
+// Called only when existing books have been updated. |indexes| are the indexes in |books| of the
+// books whose registry record changed.
 - (void)catalogUngroupedFeed:(NYPLCatalogUngroupedFeed *)catalogUngroupedFeed
-              didUpdateBooks:(NSArray *)books;
+     didUpdateBooksAtIndexes:(NSIndexSet *)indexes;
 
 // Called only when new books have been added.
 - (void)catalogUngroupedFeed:(NYPLCatalogUngroupedFeed *)catalogUngroupedFeed
@@ -27,6 +28,13 @@
 @property (nonatomic, readonly) BOOL currentlyFetchingNextURL;
 @property (nonatomic, readonly) NSArray<NYPLCatalogFacet *> *entryPoints;
 
+// Metrics about fetching further pages. |averagePageLoadTime| is a moving average of the time taken
+// to fetch and parse a page. |endOfListWaitTime| is the total time spent with the last loaded book
+// prepared while the next page was still loading, over |endOfListWaitCount| such waits.
+@property (nonatomic, readonly) NSTimeInterval averagePageLoadTime;
+@property (nonatomic, readonly) NSTimeInterval endOfListWaitTime;
+@property (nonatomic, readonly) NSUInteger endOfListWaitCount;
+
 + (id)new NS_UNAVAILABLE;
 - (id)init NS_UNAVAILABLE;
 
@@ -35,8 +43,10 @@
 
 // This method is used to inform a catalog category that the data of a book at the given index is
 // being used elsewhere. This knowledge allows preemptive retrieval of the next URL (if present) so
-// that later books will be available upon request. It is important to have a delegate receive
-// updates as it's the only way of knowing when data about new books has actually become available.
+// that later books will be available upon request. How early the next URL is retrieved depends on
+// how fast books are being prepared and on how long pages have been taking to load. It is
+// important to have a delegate receive updates as it's the only way of knowing when data about new
+// books has actually become available.
 // It is an error to attempt to prepare for a book index equal to greater than |books.count|,
 // something avoidable because book counts never decrease.
 - (void)prepareForBookIndex:(NSUInteger)bookIndex;
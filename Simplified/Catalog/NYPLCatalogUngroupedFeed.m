@@ -1,8 +1,10 @@
 #import "NYPLAsync.h"
 #import "NYPLBook.h"
 #import "NYPLBookRegistry.h"
+#import "NYPLCatalogBookBuilder.h"
 #import "NYPLCatalogFacet.h"
 #import "NYPLCatalogFacetGroup.h"
+#import "NYPLNull.h"
 #import "NYPLOPDS.h"
 #import "NYPLOpenSearchDescription.h"
 #import "SimplyE-Swift.h"
@@ -18,12 +20,41 @@
 @property (nonatomic) NSURL *nextURL;
 @property (nonatomic) NSURL *openSearchURL;
 @property (nonatomic) NSArray<NYPLCatalogFacet *> *entryPoints;
+@property (nonatomic) NSTimeInterval averagePageLoadTime;
+@property (nonatomic) NSTimeInterval endOfListWaitTime;
+@property (nonatomic) NSUInteger endOfListWaitCount;
+
+// Books prepared per second, smoothed, and when |greatestPreparationIndex| last increased.
+@property (nonatomic) double preparationRate;
+@property (nonatomic) NSTimeInterval lastPreparationTime;
+// When the last loaded book was prepared while the next page was loading, else 0.
+@property (nonatomic) NSTimeInterval endOfListWaitStartTime;
+
+// The indexes in |books| of each book identifier. Accessed under @synchronized(self) since registry
+// changes are matched against it off the main queue.
+@property (nonatomic) NSMutableDictionary<NSString *, NSMutableIndexSet *> *bookIndexesByIdentifier;
+@property (nonatomic) dispatch_queue_t refreshQueue;
 
 @end
 
 // If fewer than this many books are currently available when |prepareForBookIndex:| is called, an
-// attempt to fetch more books will be made.
-static NSUInteger const preloadThreshold = 100;
+// attempt to fetch more books will be made. The threshold grows when books are prepared faster than
+// pages can be loaded, see |preloadThreshold|.
+static NSUInteger const minimumPreloadThreshold = 100;
+static NSUInteger const maximumPreloadThreshold = 1000;
+
+// Assumed until a page load has been measured.
+static NSTimeInterval const initialPageLoadTime = 2.0;
+
+// Weight of the newest sample in the moving averages of page load time and preparation rate.
+static double const movingAverageWeight = 0.3;
+
+// A page may take longer than average to load, or turn out to have no supported books.
+static double const pageLoadSafetyFactor = 2.0;
+
+// Thumbnails of the first books of a new page are fetched as soon as the page is parsed, so that
+// they are cached by the time these books are shown.
+static NSUInteger const thumbnailWarmUpCount = 10;
 
 @implementation NYPLCatalogUngroupedFeed
 
@@ -38,25 +69,20 @@ static NSUInteger const preloadThreshold = 100;
   
   self.books = [NSMutableArray array];
   
-  for(NYPLOPDSEntry *const entry in feed.entries) {
-    NYPLBook *book = [NYPLBook bookWithEntry:entry];
-    if(!book) {
-      NYPLLOG(@"Failed to create book from entry.");
-      continue;
-    }
-
-    if(!book.defaultAcquisition) {
-      // The application is not able to support this, so we ignore it.
-      continue;
-    }
-    
-    NYPLBook *updatedBook = [[NYPLBookRegistry sharedRegistry] updatedBookMetadata:book];
-    if(updatedBook) {
-      book = updatedBook;
+  for(id const bookOrNull in [NYPLCatalogBookBuilder booksOrNullsWithEntries:feed.entries]) {
+    NYPLBook *const book = NYPLNullToNil(bookOrNull);
+    if(book) {
+      [self.books addObject:book];
     }
-    [self.books addObject:book];
   }
 
+  self.averagePageLoadTime = initialPageLoadTime;
+  self.bookIndexesByIdentifier = [NSMutableDictionary dictionary];
+  [self indexBooksInRange:NSMakeRange(0, self.books.count)];
+  self.refreshQueue =
+    dispatch_queue_create("org.nypl.labs.SimplyE.CatalogUngroupedFeed.refreshQueue",
+                          DISPATCH_QUEUE_SERIAL);
+
   NSMutableArray *const entryPointFacets = [NSMutableArray array];
   NSMutableArray *const facetGroupNames = [NSMutableArray array];
   NSMutableDictionary *const facetGroupNamesToMutableFacetArrays =
@@ -129,50 +155,105 @@ static NSUInteger const preloadThreshold = 100;
   
   [[NSNotificationCenter defaultCenter]
    addObserver:self
-   selector:@selector(refreshBooks)
+   selector:@selector(refreshBooks:)
    name:NSNotification.NYPLBookRegistryDidChange
    object:nil];
 
   return self;
 }
 
+- (NSUInteger)preloadThreshold
+{
+  double const booksNeededDuringPageLoad =
+    self.preparationRate * self.averagePageLoadTime * pageLoadSafetyFactor;
+  return MIN(maximumPreloadThreshold,
+             MAX(minimumPreloadThreshold, (NSUInteger)booksNeededDuringPageLoad));
+}
+
+- (void)updatePreparationRateForBookIndex:(NSUInteger const)bookIndex
+{
+  NSTimeInterval const now = [NSProcessInfo processInfo].systemUptime;
+  NSTimeInterval const elapsed = now - self.lastPreparationTime;
+  
+  if(self.lastPreparationTime > 0 && elapsed > 0) {
+    double const rate = (bookIndex - self.greatestPreparationIndex) / elapsed;
+    self.preparationRate = (movingAverageWeight * rate
+                            + (1 - movingAverageWeight) * self.preparationRate);
+  }
+  
+  self.lastPreparationTime = now;
+}
+
+- (void)noteEndOfListWaitIfNeededForBookIndex:(NSUInteger const)bookIndex
+{
+  if(bookIndex == self.books.count - 1
+     && self.currentlyFetchingNextURL
+     && !self.endOfListWaitStartTime) {
+    self.endOfListWaitStartTime = [NSProcessInfo processInfo].systemUptime;
+  }
+}
+
 - (void)prepareForBookIndex:(NSUInteger)bookIndex
 {
   if(bookIndex >= self.books.count) {
     @throw NSInvalidArgumentException;
   }
   
+  [self noteEndOfListWaitIfNeededForBookIndex:bookIndex];
+  
   if(bookIndex < self.greatestPreparationIndex) {
     return;
   }
   
+  if(bookIndex > self.greatestPreparationIndex) {
+    [self updatePreparationRateForBookIndex:bookIndex];
+  }
+  
   self.greatestPreparationIndex = bookIndex;
   
   if(self.currentlyFetchingNextURL) return;
   
   if(!self.nextURL) return;
   
-  if(self.books.count - bookIndex > preloadThreshold) {
+  if(self.books.count - bookIndex > [self preloadThreshold]) {
     return;
   }
   
   self.currentlyFetchingNextURL = YES;
+  [self noteEndOfListWaitIfNeededForBookIndex:bookIndex];
   
   NSUInteger const location = self.books.count;
+  NSTimeInterval const fetchStartTime = [NSProcessInfo processInfo].systemUptime;
   
   [NYPLOPDSFeedFetcher fetchCatalogUngroupedFeedWithUrl:self.nextURL
                                         networkExecutor:[NYPLNetworkExecutor shared]
                                              retryCount:0
                                              completion:^(NYPLCatalogUngroupedFeed * _Nullable feed) {
+    // Runs off the main queue: start fetching the thumbnails of the new books right away.
+    [self warmUpThumbnailsForBooks:feed.books];
+    
     [[NSOperationQueue mainQueue] addOperationWithBlock:^{
       self.currentlyFetchingNextURL = NO;
       
+      NSTimeInterval const now = [NSProcessInfo processInfo].systemUptime;
+      if(self.endOfListWaitStartTime) {
+        NSTimeInterval const waitTime = now - self.endOfListWaitStartTime;
+        self.endOfListWaitTime += waitTime;
+        ++self.endOfListWaitCount;
+        self.endOfListWaitStartTime = 0;
+        NYPLLOG_F(@"Waited %.2fs at the end of the list for the next page.", waitTime);
+      }
+      
       if(!feed) {
         NYPLLOG(@"Failed to fetch next page.");
         return;
       }
       
+      self.averagePageLoadTime = (movingAverageWeight * (now - fetchStartTime)
+                                  + (1 - movingAverageWeight) * self.averagePageLoadTime);
+      
       [self.books addObjectsFromArray:feed.books];
+      [self indexBooksInRange:NSMakeRange(location, feed.books.count)];
       self.nextURL = feed.nextURL;
       
       [self prepareForBookIndex:self.greatestPreparationIndex];
@@ -186,25 +267,111 @@ static NSUInteger const preloadThreshold = 100;
   }];
 }
 
-- (void)refreshBooks
+- (void)warmUpThumbnailsForBooks:(NSArray<NYPLBook *> *const)books
+{
+  NSMutableSet *const booksToWarmUp = [NSMutableSet setWithCapacity:thumbnailWarmUpCount];
+  for(NYPLBook *const book in books) {
+    if(booksToWarmUp.count == thumbnailWarmUpCount) {
+      break;
+    }
+    // Books without a thumbnail URL get a generated cover when shown, there is nothing to fetch.
+    if(book.imageThumbnailURL) {
+      [booksToWarmUp addObject:book];
+    }
+  }
+  
+  if(booksToWarmUp.count == 0) {
+    return;
+  }
+  
+  // Unlike |thumbnailImagesForBooks:handler:|, this doesn't generate covers on the main queue for
+  // thumbnails that fail to load.
+  [[NYPLBookRegistry sharedRegistry] warmUpThumbnailImagesForBooks:booksToWarmUp];
+}
+
+- (void)indexBooksInRange:(NSRange const)range
+{
+  @synchronized(self) {
+    for(NSUInteger i = range.location; i < NSMaxRange(range); ++i) {
+      NSString *const identifier = ((NYPLBook *)self.books[i]).identifier;
+      NSMutableIndexSet *indexes = self.bookIndexesByIdentifier[identifier];
+      if(!indexes) {
+        indexes = [NSMutableIndexSet indexSet];
+        self.bookIndexesByIdentifier[identifier] = indexes;
+      }
+      [indexes addIndex:i];
+    }
+  }
+}
+
+- (BOOL)containsBookWithIdentifier:(NSString *const)identifier
+{
+  @synchronized(self) {
+    return self.bookIndexesByIdentifier[identifier] != nil;
+  }
+}
+
+// Registry lookups happen on |refreshQueue|; only the books whose record changed are replaced, on
+// the main queue.
+- (void)refreshBooks:(NSNotification *const)note
 {
-  [[NSOperationQueue mainQueue] addOperationWithBlock:^{
-    NSMutableArray *const refreshedBooks = [NSMutableArray arrayWithCapacity:self.books.count];
+  // nil if any book may have changed
+  NSDictionary<NSString *, NSNumber *> *const changes =
+    note.userInfo[NYPLNotificationKeys.bookRegistryChangesKey];
+  
+  dispatch_async(self.refreshQueue, ^{
+    NSArray<NSString *> *identifiers = changes.allKeys;
+    if(!changes) {
+      @synchronized(self) {
+        identifiers = self.bookIndexesByIdentifier.allKeys;
+      }
+    }
     
-    for(NYPLBook *const book in self.books) {
+    NSMutableArray<NSString *> *const changedIdentifiers = [NSMutableArray array];
+    NSMutableDictionary<NSString *, NYPLBook *> *const refreshedBooks =
+      [NSMutableDictionary dictionary];
+    
+    for(NSString *const identifier in identifiers) {
+      if(![self containsBookWithIdentifier:identifier]) {
+        continue;
+      }
       NYPLBook *const refreshedBook = [[NYPLBookRegistry sharedRegistry]
-                                       bookForIdentifier:book.identifier];
+                                       bookForIdentifier:identifier];
       if(refreshedBook) {
-        [refreshedBooks addObject:refreshedBook];
-      } else {
-        [refreshedBooks addObject:book];
+        refreshedBooks[identifier] = refreshedBook;
+      } else if(!changes) {
+        // Not in the registry, so nothing about it may have changed.
+        continue;
       }
+      [changedIdentifiers addObject:identifier];
     }
     
-    self.books = refreshedBooks;
+    if(changedIdentifiers.count == 0) {
+      return;
+    }
     
-    [self.delegate catalogUngroupedFeed:self didUpdateBooks:self.books];
-  }];
+    [[NSOperationQueue mainQueue] addOperationWithBlock:^{
+      NSMutableIndexSet *const updatedIndexes = [NSMutableIndexSet indexSet];
+      @synchronized(self) {
+        for(NSString *const identifier in changedIdentifiers) {
+          NSIndexSet *const indexes = self.bookIndexesByIdentifier[identifier];
+          if(indexes) {
+            [updatedIndexes addIndexes:indexes];
+          }
+        }
+      }
+      
+      [updatedIndexes enumerateIndexesUsingBlock:^(NSUInteger const i,
+                                                   __attribute__((unused)) BOOL *stop) {
+        NYPLBook *const refreshedBook = refreshedBooks[((NYPLBook *)self.books[i]).identifier];
+        if(refreshedBook) {
+          self.books[i] = refreshedBook;
+        }
+      }];
+      
+      [self.delegate catalogUngroupedFeed:self didUpdateBooksAtIndexes:updatedIndexes];
+    }];
+  });
 }
 
 #pragma mark NSObject
@@ -12,6 +12,7 @@
 #import "NYPLOpenSearchDescription.h"
 #import "NYPLReloadView.h"
 #import "NYPLRemoteViewController.h"
+#import "UICollectionView+NYPLCollectionViewAdditions.h"
 #import "UIView+NYPLViewAdditions.h"
 
 #import "SimplyE-Swift.h"
@@ -178,11 +179,14 @@ didSelectItemAtIndexPath:(NSIndexPath *const)indexPath
 
 #pragma mark NYPLCatalogUngroupedFeedDelegate
 
-- (void)catalogUngroupedFeed:(__attribute__((unused))
-                              NYPLCatalogUngroupedFeed *)catalogUngroupedFeed
-              didUpdateBooks:(__attribute__((unused)) NSArray *)books
+- (void)catalogUngroupedFeed:(NYPLCatalogUngroupedFeed *)catalogUngroupedFeed
+     didUpdateBooksAtIndexes:(NSIndexSet *const)indexes
 {
-  [self.collectionView reloadData];
+  if(catalogUngroupedFeed != self.feed) {
+    return;
+  }
+
+  [self.collectionView reloadItemsInFirstSectionAtIndexes:indexes];
 }
 
 - (void)catalogUngroupedFeed:(__attribute__((unused))
@@ -254,6 +254,19 @@ didSelectItemAtIndexPath:(NSIndexPath *const)indexPath
   [self updateBadge];
 }
 
+- (NSArray<NSArray<NYPLBook *> *> *)booksBySection
+{
+  // mirrors |bookArrayForSection:|, empty sections are not shown
+  NSMutableArray *const sections = [NSMutableArray array];
+  if(self.reservedBooks.count > 0) {
+    [sections addObject:self.reservedBooks];
+  }
+  if(self.heldBooks.count > 0) {
+    [sections addObject:self.heldBooks];
+  }
+  return sections;
+}
+
 #pragma mark -
 
 - (void)updateBadge
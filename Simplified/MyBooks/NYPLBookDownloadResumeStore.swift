@@ -0,0 +1,145 @@
+//
+//  NYPLBookDownloadResumeStore.swift
+//  Simplified
+//
+//  Copyright © 2026 NYPL. All rights reserved.
+//
+
+import Foundation
+import NYPLUtilities
+
+/// Persists what is needed to resume an interrupted book download, one file
+/// per book identifier, so that a download that was cancelled, that failed
+/// or that was cut short by the app being terminated can pick up from the
+/// bytes already on disk instead of starting over.
+///
+/// The resume data produced by URLSession references the partial file and
+/// carries the validators of the original response: when it is handed back
+/// to `downloadTask(withResumeData:)` the session issues a `Range` request
+/// with an `If-Range` header, so the partial file is only reused if the
+/// resource did not change. Since a range can't be validated without a
+/// validator, resume data is only kept for responses that have an `ETag` or
+/// a `Last-Modified` header.
+@objcMembers final class NYPLBookDownloadResumeStore: NSObject {
+
+  private static let resumeDataKey = "resumeData"
+  private static let urlKey = "url"
+  private static let offsetKey = "offset"
+  private static let expectedLengthKey = "expectedLength"
+  private static let eTagKey = "eTag"
+  private static let lastModifiedKey = "lastModified"
+
+  let directoryURL: URL
+
+  //----------------------------------------------------------------------------
+  /// - Parameter directoryURL: The directory where resume data is written.
+  /// It is created when needed.
+  init(directoryURL: URL) {
+    self.directoryURL = directoryURL
+    super.init()
+  }
+
+  //----------------------------------------------------------------------------
+  /// Saves `resumeData` for the given book, replacing any previous one.
+  /// Nothing is saved, and any previous resume data is removed, if the
+  /// response has no validators.
+  ///
+  /// - Parameters:
+  ///   - resumeData: The data produced by URLSession when the download
+  ///   was interrupted.
+  ///   - identifier: The identifier of the book being downloaded.
+  ///   - url: The URL of the request the download task was created with.
+  ///   - response: The response received before the interruption.
+  ///   - offset: The number of bytes already on disk.
+  ///   - expectedLength: The total number of bytes expected, or a negative
+  ///   value if unknown.
+  func setResumeData(_ resumeData: Data,
+                     forBookIdentifier identifier: String,
+                     url: URL,
+                     response: URLResponse?,
+                     offset: Int64,
+                     expectedLength: Int64) {
+    let httpResponse = response as? HTTPURLResponse
+    let eTag = httpResponse?.eTagHeader
+    let lastModified = httpResponse?.lastModifiedHeader
+    guard eTag != nil || lastModified != nil else {
+      Log.info(#file, "Not keeping resume data for \(identifier): response has no validators")
+      removeResumeData(forBookIdentifier: identifier)
+      return
+    }
+
+    var record: [String: Any] = [
+      NYPLBookDownloadResumeStore.resumeDataKey: resumeData,
+      NYPLBookDownloadResumeStore.urlKey: url.absoluteString,
+      NYPLBookDownloadResumeStore.offsetKey: offset,
+      NYPLBookDownloadResumeStore.expectedLengthKey: expectedLength,
+    ]
+    record[NYPLBookDownloadResumeStore.eTagKey] = eTag
+    record[NYPLBookDownloadResumeStore.lastModifiedKey] = lastModified
+
+    do {
+      let data = try PropertyListSerialization.data(fromPropertyList: record,
+                                                    format: .binary,
+                                                    options: 0)
+      try FileManager.default.createDirectory(at: directoryURL,
+                                              withIntermediateDirectories: true)
+      try data.write(to: fileURL(forBookIdentifier: identifier), options: .atomic)
+      Log.debug(#file, "Saved resume data for \(identifier) at offset \(offset)")
+    } catch {
+      Log.error(#file, "Unable to save resume data for \(identifier): \(error)")
+    }
+  }
+
+  //----------------------------------------------------------------------------
+  /// - Returns: The resume data saved for the book, if it was saved for a
+  /// download of the same `url`.
+  func resumeData(forBookIdentifier identifier: String, url: URL) -> Data? {
+    return record(forBookIdentifier: identifier, url: url)?[NYPLBookDownloadResumeStore.resumeDataKey] as? Data
+  }
+
+  //----------------------------------------------------------------------------
+  /// - Returns: The fraction of the download of `url` that is already on
+  /// disk for the book, in the range [0.0, 1.0], or 0 if unknown.
+  func progress(forBookIdentifier identifier: String, url: URL) -> Double {
+    guard let record = record(forBookIdentifier: identifier, url: url),
+      let offset = record[NYPLBookDownloadResumeStore.offsetKey] as? Int64,
+      let expectedLength = record[NYPLBookDownloadResumeStore.expectedLengthKey] as? Int64,
+      expectedLength > 0 else {
+        return 0
+    }
+    return min(1, Double(max(0, offset)) / Double(expectedLength))
+  }
+
+  //----------------------------------------------------------------------------
+  func removeResumeData(forBookIdentifier identifier: String) {
+    let fileURL = self.fileURL(forBookIdentifier: identifier)
+    if FileManager.default.fileExists(atPath: fileURL.path) {
+      try? FileManager.default.removeItem(at: fileURL)
+    }
+  }
+
+  //----------------------------------------------------------------------------
+  func removeAll() {
+    try? FileManager.default.removeItem(at: directoryURL)
+  }
+
+  // MARK: - Private
+
+  //----------------------------------------------------------------------------
+  private func record(forBookIdentifier identifier: String, url: URL) -> [String: Any]? {
+    guard let data = try? Data(contentsOf: fileURL(forBookIdentifier: identifier)),
+      let plist = try? PropertyListSerialization.propertyList(from: data, format: nil),
+      let record = plist as? [String: Any],
+      record[NYPLBookDownloadResumeStore.urlKey] as? String == url.absoluteString else {
+        return nil
+    }
+    return record
+  }
+
+  //----------------------------------------------------------------------------
+  private func fileURL(forBookIdentifier identifier: String) -> URL {
+    return directoryURL
+      .appendingPathComponent(identifier.sha256())
+      .appendingPathExtension("plist")
+  }
+}
@@ -0,0 +1,163 @@
+//
+//  NYPLDownloadMetrics.swift
+//  Simplified
+//
+//  Copyright © 2026 NYPL. All rights reserved.
+//
+
+import Foundation
+
+@objc enum NYPLDownloadMode: Int {
+  case singleStream
+  case segmented
+
+  var name: String {
+    switch self {
+    case .singleStream:
+      return "single stream"
+    case .segmented:
+      return "segmented"
+    }
+  }
+}
+
+/// Time-to-complete statistics of the downloads of one distributor in one
+/// mode.
+@objcMembers final class NYPLDownloadMetricsSummary: NSObject {
+  let distributor: String
+  let mode: NYPLDownloadMode
+  let downloadCount: Int
+  let medianDuration: TimeInterval
+
+  /// In bytes per second, over all the recorded downloads.
+  let throughput: Double
+
+  init(distributor: String,
+       mode: NYPLDownloadMode,
+       downloadCount: Int,
+       medianDuration: TimeInterval,
+       throughput: Double) {
+    self.distributor = distributor
+    self.mode = mode
+    self.downloadCount = downloadCount
+    self.medianDuration = medianDuration
+    self.throughput = throughput
+    super.init()
+  }
+
+  /// e.g. "12 downloads, median 8.4 s, 2.10 MB/s"
+  var statistics: String {
+    return String(format: "%d downloads, median %.1f s, %.2f MB/s",
+                  downloadCount, medianDuration, throughput / (1024 * 1024))
+  }
+
+  override var description: String {
+    return "\(distributor) (\(mode.name)): \(statistics)"
+  }
+}
+
+/// Records how long book downloads take to complete, per distributor and
+/// per download mode, so that segmented downloads can be compared with
+/// single stream ones for the same content sources. Only the most recent
+/// downloads of each kind are kept, in memory. This class is thread-safe.
+@objcMembers final class NYPLDownloadMetrics: NSObject {
+
+  static let shared = NYPLDownloadMetrics()
+  static let unknownDistributor = "Unknown"
+
+  private struct Sample {
+    let byteCount: Int64
+    let duration: TimeInterval
+  }
+
+  private struct Key: Hashable {
+    let distributor: String
+    let mode: Int
+  }
+
+  let maxSamplesPerKey: Int
+  private let queue = DispatchQueue(label: "org.nypl.labs.SimplyE.NYPLDownloadMetrics.queue")
+  private var samples = [Key: [Sample]]()
+
+  //----------------------------------------------------------------------------
+  init(maxSamplesPerKey: Int = 50) {
+    self.maxSamplesPerKey = max(1, maxSamplesPerKey)
+    super.init()
+  }
+
+  //----------------------------------------------------------------------------
+  /// Records a completed download and logs the updated summary.
+  ///
+  /// - Parameters:
+  ///   - distributor: The distributor of the book, if known.
+  ///   - mode: How the book was downloaded.
+  ///   - byteCount: The size of the downloaded content.
+  ///   - duration: The time from the first request to the last byte.
+  func recordDownload(distributor: String?,
+                      mode: NYPLDownloadMode,
+                      byteCount: Int64,
+                      duration: TimeInterval) {
+    guard duration > 0, byteCount > 0 else {
+      return
+    }
+
+    let key = Key(distributor: distributor ?? NYPLDownloadMetrics.unknownDistributor,
+                  mode: mode.rawValue)
+    let summary: NYPLDownloadMetricsSummary? = queue.sync {
+      var keySamples = samples[key] ?? []
+      keySamples.append(Sample(byteCount: byteCount, duration: duration))
+      if keySamples.count > maxSamplesPerKey {
+        keySamples.removeFirst(keySamples.count - maxSamplesPerKey)
+      }
+      samples[key] = keySamples
+      return makeSummary(for: key, samples: keySamples)
+    }
+
+    if let summary = summary {
+      Log.info(#file, "Download metrics: \(summary)")
+    }
+  }
+
+  //----------------------------------------------------------------------------
+  /// - Returns: The summaries of all the recorded downloads, sorted by
+  /// distributor then mode.
+  func summaries() -> [NYPLDownloadMetricsSummary] {
+    return queue.sync {
+      samples
+        .sorted {
+          ($0.key.distributor, $0.key.mode) < ($1.key.distributor, $1.key.mode)
+        }
+        .compactMap { makeSummary(for: $0.key, samples: $0.value) }
+    }
+  }
+
+  //----------------------------------------------------------------------------
+  func removeAll() {
+    queue.sync {
+      samples.removeAll()
+    }
+  }
+
+  // MARK: - Private
+
+  //----------------------------------------------------------------------------
+  private func makeSummary(for key: Key, samples: [Sample]) -> NYPLDownloadMetricsSummary? {
+    guard !samples.isEmpty, let mode = NYPLDownloadMode(rawValue: key.mode) else {
+      return nil
+    }
+
+    let durations = samples.map { $0.duration }.sorted()
+    let middle = durations.count / 2
+    let median = (durations.count % 2 == 0)
+      ? (durations[middle - 1] + durations[middle]) / 2
+      : durations[middle]
+    let totalBytes = samples.reduce(Int64(0)) { $0 + $1.byteCount }
+    let totalDuration = durations.reduce(0, +)
+
+    return NYPLDownloadMetricsSummary(distributor: key.distributor,
+                                      mode: mode,
+                                      downloadCount: samples.count,
+                                      medianDuration: median,
+                                      throughput: Double(totalBytes) / totalDuration)
+  }
+}
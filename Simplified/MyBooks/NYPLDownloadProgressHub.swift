@@ -0,0 +1,128 @@
+//
+//  NYPLDownloadProgressHub.swift
+//  Simplified
+//
+//  Copyright © 2026 NYPL. All rights reserved.
+//
+
+import Foundation
+
+/// Coalesces the download updates of any number of books into a single
+/// `NYPLMyBooksDownloadCenterDidChange` notification per tick.
+///
+/// Every book recorded since the last notification is part of the next one,
+/// together with its download progress at the time the notification is
+/// posted, so that concurrent downloads don't hide each other's updates.
+/// Recording changes is thread-safe; notifications are posted on the main
+/// thread.
+@objcMembers final class NYPLDownloadProgressHub: NSObject {
+
+  static let defaultInterval: TimeInterval = 0.2
+
+  /// How long changes are accumulated before being posted.
+  let interval: TimeInterval
+
+  private weak var sender: AnyObject?
+  private let notificationCenter: NotificationCenter
+  private let progressProvider: (String) -> Double
+  private let lock = NSLock()
+  private var pendingIdentifiers = Set<String>()
+  private var firstPendingIdentifier: String?
+  private var isPublishScheduled = false
+
+  //----------------------------------------------------------------------------
+  /// - Parameters:
+  ///   - sender: The object of the posted notifications.
+  ///   - interval: How long changes are accumulated before being posted.
+  ///   - notificationCenter: Where notifications are posted.
+  ///   - progressProvider: Returns the current download progress of a book.
+  ///   It is called on the main thread.
+  init(sender: AnyObject?,
+       interval: TimeInterval = NYPLDownloadProgressHub.defaultInterval,
+       notificationCenter: NotificationCenter = .default,
+       progressProvider: @escaping (String) -> Double) {
+    self.sender = sender
+    self.interval = interval
+    self.notificationCenter = notificationCenter
+    self.progressProvider = progressProvider
+    super.init()
+  }
+
+  //----------------------------------------------------------------------------
+  /// Records that the download of a book changed. An empty identifier means
+  /// that any book may have changed, e.g. after a reset.
+  func recordChange(forBookIdentifier identifier: String) {
+    lock.lock()
+    defer { lock.unlock() }
+
+    addPending(identifier)
+    guard !isPublishScheduled else {
+      return
+    }
+    isPublishScheduled = true
+
+    // This needs to be queued on the main run loop. If we queue it elsewhere,
+    // it may end up never firing due to a run loop becoming inactive.
+    DispatchQueue.main.asyncAfter(deadline: .now() + interval) { [weak self] in
+      self?.publish(endingTick: true)
+    }
+  }
+
+  //----------------------------------------------------------------------------
+  /// Posts the changes recorded so far, plus the given book, without waiting
+  /// for the end of the current tick.
+  func publishNow(forBookIdentifier identifier: String) {
+    lock.lock()
+    addPending(identifier)
+    lock.unlock()
+
+    NYPLMainThreadRun.asyncIfNeeded { [weak self] in
+      self?.publish(endingTick: false)
+    }
+  }
+
+  // MARK: - Private
+
+  //----------------------------------------------------------------------------
+  /// Must be called while holding `lock`.
+  private func addPending(_ identifier: String) {
+    if pendingIdentifiers.isEmpty {
+      firstPendingIdentifier = identifier
+    }
+    pendingIdentifiers.insert(identifier)
+  }
+
+  //----------------------------------------------------------------------------
+  /// Must be called on the main thread.
+  private func publish(endingTick: Bool) {
+    lock.lock()
+    let identifiers = pendingIdentifiers
+    let firstIdentifier = firstPendingIdentifier
+    pendingIdentifiers.removeAll()
+    firstPendingIdentifier = nil
+    if endingTick {
+      isPublishScheduled = false
+    }
+    lock.unlock()
+
+    guard let bookID = firstIdentifier else {
+      return
+    }
+
+    var userInfo: [String: Any] = [:]
+    if identifiers.contains("") {
+      userInfo[NYPLNotificationKeys.bookIDKey] = ""
+    } else {
+      userInfo[NYPLNotificationKeys.bookIDKey] = bookID
+      var progress = [String: NSNumber]()
+      for identifier in identifiers {
+        progress[identifier] = NSNumber(value: progressProvider(identifier))
+      }
+      userInfo[NYPLNotificationKeys.downloadProgressChangesKey] = progress
+    }
+
+    notificationCenter.post(name: .NYPLMyBooksDownloadCenterDidChange,
+                            object: sender,
+                            userInfo: userInfo)
+  }
+}
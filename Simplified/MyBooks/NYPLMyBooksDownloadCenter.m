@@ -43,15 +43,41 @@
 @property (nonatomic) NSMutableDictionary *bookIdentifierToDownloadInfo;
 @property (nonatomic) NSMutableDictionary *bookIdentifierToDownloadProgress;
 @property (nonatomic) NSMutableDictionary *bookIdentifierToDownloadTask;
-@property (nonatomic) BOOL broadcastScheduled;
+@property (nonatomic) NYPLDownloadProgressHub *progressHub;
 @property (nonatomic) NSURLSession *session;
 @property (nonatomic) NSMutableDictionary *taskIdentifierToBook;
+
+/// Segmented downloads in progress, keyed by book identifier. Accessed under
+/// @c @synchronized(self).
+@property (nonatomic) NSMutableDictionary<NSString *, NYPLSegmentedDownload *> *bookIdentifierToSegmentedDownload;
 @property (nonatomic) NYPLReauthenticator *reauthenticator;
 
+/// The serial queue on which all the session delegate methods are called.
+/// It is only used for bookkeeping: the downloaded files are processed on
+/// @c processingQueue.
+@property (nonatomic) NSOperationQueue *delegateQueue;
+
+/// The serial queue on which downloaded files are moved into place and
+/// handed over for fulfillment.
+@property (nonatomic) dispatch_queue_t processingQueue;
+
+/// The resume data stores, keyed by account id. Accessed under
+/// @c @synchronized(self).
+@property (nonatomic) NSMutableDictionary<NSString *, NYPLBookDownloadResumeStore *> *accountToResumeStore;
+
+/// The number of download tasks that have been created and not completed yet.
+@property (nonatomic) NSUInteger activeTaskCount;
+
+#if DEBUG
+/// Records how often the main thread stalls while downloads are active.
+@property (nonatomic) NYPLMainThreadStallMonitor *stallMonitor;
+#endif
+
 /// Maps a task identifier to a non-negative redirect attempt count. This
 /// tracks the number of redirect attempts for a particular download task.
 /// If a task identifier is not present in the dictionary, the redirect
 /// attempt count for the associated task should be considered 0.
+/// This is only accessed on @c delegateQueue.
 ///
 /// Tracking this explicitly is required because we override
 /// @c URLSession:task:willPerformHTTPRedirection:newRequest:completionHandler
@@ -103,31 +129,95 @@
   self.bookIdentifierToDownloadInfo = [NSMutableDictionary dictionary];
   self.bookIdentifierToDownloadProgress = [NSMutableDictionary dictionary];
   self.bookIdentifierToDownloadTask = [NSMutableDictionary dictionary];
+  self.accountToResumeStore = [NSMutableDictionary dictionary];
   
+  self.processingQueue = dispatch_queue_create("org.nypl.labs.SimplyE.NYPLMyBooksDownloadCenter.processingQueue",
+                                               dispatch_queue_attr_make_with_qos_class(DISPATCH_QUEUE_SERIAL,
+                                                                                       QOS_CLASS_UTILITY,
+                                                                                       0));
+  self.delegateQueue = [[NSOperationQueue alloc] init];
+  self.delegateQueue.name = @"org.nypl.labs.SimplyE.NYPLMyBooksDownloadCenter.delegateQueue";
+  self.delegateQueue.maxConcurrentOperationCount = 1;
+  self.delegateQueue.qualityOfService = NSQualityOfServiceUtility;
+#if DEBUG
+  self.stallMonitor = [[NYPLMainThreadStallMonitor alloc] initWithName:@"Book downloads"
+                                                             threshold:0.05
+                                                              interval:0.02];
+#endif
+
+  __weak __auto_type wSelf = self;
+  self.progressHub = [[NYPLDownloadProgressHub alloc]
+                      initWithSender:self
+                      interval:NYPLDownloadProgressHub.defaultInterval
+                      notificationCenter:[NSNotificationCenter defaultCenter]
+                      progressProvider:^double(NSString *bookID) {
+    return [wSelf downloadProgressForBookIdentifier:bookID];
+  }];
+
   self.session = [NSURLSession
                   sessionWithConfiguration:configuration
                   delegate:self
-                  delegateQueue:[NSOperationQueue mainQueue]];
+                  delegateQueue:self.delegateQueue];
   
   self.taskIdentifierToBook = [NSMutableDictionary dictionary];
+  self.bookIdentifierToSegmentedDownload = [NSMutableDictionary dictionary];
   self.taskIdentifierToRedirectAttempts = [NSMutableDictionary dictionary];
   self.reauthenticator = [[NYPLReauthenticator alloc] init];
+
+  [[NSNotificationCenter defaultCenter]
+   addObserver:self
+   selector:@selector(applicationWillTerminate)
+   name:UIApplicationWillTerminateNotification
+   object:nil];
   
   return self;
 }
 
+- (void)dealloc
+{
+  [[NSNotificationCenter defaultCenter] removeObserver:self];
+}
+
 #pragma mark - NSURLSessionDownloadDelegate
 
 // All of these delegate methods can be called (in very rare circumstances) after the shared
 // download center has been reset. As such, they must be careful to bail out immediately if that is
-// the case.
+// the case. They are all called on |delegateQueue|.
 
 - (void)URLSession:(__attribute__((unused)) NSURLSession *)session
-      downloadTask:(__attribute__((unused)) NSURLSessionDownloadTask *)downloadTask
- didResumeAtOffset:(__attribute__((unused)) int64_t)fileOffset
-expectedTotalBytes:(__attribute__((unused)) int64_t)expectedTotalBytes
+      downloadTask:(NSURLSessionDownloadTask *const)downloadTask
+ didResumeAtOffset:(int64_t const)fileOffset
+expectedTotalBytes:(int64_t const)expectedTotalBytes
 {
-  NYPLLOG(@"Ignoring unexpected resumption.");
+  NYPLBook *const book = [self bookForTaskIdentifier:downloadTask.taskIdentifier];
+
+  if(!book) {
+    // A reset must have occurred.
+    return;
+  }
+
+  // An offset of 0 means the server did not honor the range, e.g. because the
+  // resource changed since the partial file was written, and the download
+  // starts over. The rights management is then determined as usual when the
+  // first bytes are written.
+  NYPLLOG_F(@"Resuming download of %@ at offset %lld of %lld",
+            book.identifier, fileOffset, expectedTotalBytes);
+  if(fileOffset == 0) {
+    return;
+  }
+
+  // |URLSession:downloadTask:didWriteData:...| won't see the first bytes of
+  // the response, so we determine the rights management here instead.
+  if(![self updateRightsManagementForBook:book downloadTask:downloadTask]) {
+    return;
+  }
+
+  if(expectedTotalBytes > 0) {
+    [self updateDownloadInfoForBookIdentifier:book.identifier
+                         withDownloadProgress:(fileOffset / (double) expectedTotalBytes)];
+
+    [self broadcastUpdate:book.identifier];
+  }
 }
 
 /// This appears to be called only once per book download for Adobe and Axis.
@@ -138,8 +228,7 @@ expectedTotalBytes:(__attribute__((unused)) int64_t)expectedTotalBytes
  totalBytesWritten:(int64_t const)totalBytesWritten
 totalBytesExpectedToWrite:(int64_t const)totalBytesExpectedToWrite
 {
-  NSNumber *const key = @(downloadTask.taskIdentifier);
-  NYPLBook *const book = self.taskIdentifierToBook[key];
+  NYPLBook *const book = [self bookForTaskIdentifier:downloadTask.taskIdentifier];
   
   if(!book) {
     // A reset must have occurred.
@@ -149,45 +238,7 @@ totalBytesExpectedToWrite:(int64_t const)totalBytesExpectedToWrite
   // We update the rights management status based on the MIME type given to us by the server. We do
   // this only once at the point when we first start receiving data.
   if(bytesWritten == totalBytesWritten) {
-    if([downloadTask.response.MIMEType isEqualToString:ContentTypeAdobeAdept]) {
-      self.bookIdentifierToDownloadInfo[book.identifier] =
-      [[self downloadInfoForBookIdentifier:book.identifier]
-       withRightsManagement:NYPLMyBooksDownloadRightsManagementAdobe];
-    } else if ([downloadTask.response.MIMEType isEqualToString:ContentTypeAxis360]) {
-      self.bookIdentifierToDownloadInfo[book.identifier] =
-      [[self downloadInfoForBookIdentifier:book.identifier]
-       withRightsManagement:NYPLMyBooksDownloadRightsManagementAxis];
-#if LCP
-    } else if([downloadTask.response.MIMEType isEqualToString:ContentTypeReadiumLCP]) {
-        self.bookIdentifierToDownloadInfo[book.identifier] =
-        [[self downloadInfoForBookIdentifier:book.identifier]
-         withRightsManagement:NYPLMyBooksDownloadRightsManagementLCP];
-#endif
-    } else if([downloadTask.response.MIMEType isEqualToString:ContentTypeEpubZip]) {
-      self.bookIdentifierToDownloadInfo[book.identifier] =
-      [[self downloadInfoForBookIdentifier:book.identifier]
-       withRightsManagement:NYPLMyBooksDownloadRightsManagementNone];
-    } else if ([downloadTask.response.MIMEType isEqualToString:ContentTypeBearerToken]) {
-      self.bookIdentifierToDownloadInfo[book.identifier] =
-        [[self downloadInfoForBookIdentifier:book.identifier]
-         withRightsManagement:NYPLMyBooksDownloadRightsManagementSimplifiedBearerTokenJSON];
-#if FEATURE_AUDIOBOOKS && FEATURE_OVERDRIVE_AUTH
-    } else if ([downloadTask.response.MIMEType isEqualToString:ContentTypeOverdriveAudiobookActual]) {
-      self.bookIdentifierToDownloadInfo[book.identifier] =
-      [[self downloadInfoForBookIdentifier:book.identifier]
-       withRightsManagement:NYPLMyBooksDownloadRightsManagementOverdriveManifestJSON];
-#endif
-    } else if ([NYPLOPDSAcquisitionPath.supportedTypes containsObject:downloadTask.response.MIMEType]) {
-      NYPLMyBooksDownloadInfo *info = [[self downloadInfoForBookIdentifier:book.identifier]
-                                       withRightsManagement:NYPLMyBooksDownloadRightsManagementNone];
-      if (info) {
-        self.bookIdentifierToDownloadInfo[book.identifier] = info;
-      }
-    } else {
-      NYPLLOG(@"Authentication might be needed after all");
-      [downloadTask cancel];
-      [[NYPLBookRegistry sharedRegistry] setState:NYPLBookStateDownloadFailed forIdentifier:book.identifier];
-      [self broadcastUpdate:book.identifier];
+    if(![self updateRightsManagementForBook:book downloadTask:downloadTask]) {
       return;
     }
   }
@@ -200,20 +251,62 @@ totalBytesExpectedToWrite:(int64_t const)totalBytesExpectedToWrite
      && (rightManagement != NYPLMyBooksDownloadRightsManagementOverdriveManifestJSON))
   {
     if(totalBytesExpectedToWrite > 0) {
-      self.bookIdentifierToDownloadInfo[book.identifier] =
-        [[self downloadInfoForBookIdentifier:book.identifier]
-         withDownloadProgress:(totalBytesWritten / (double) totalBytesExpectedToWrite)];
+      [self updateDownloadInfoForBookIdentifier:book.identifier
+                           withDownloadProgress:(totalBytesWritten / (double) totalBytesExpectedToWrite)];
       
       [self broadcastUpdate:book.identifier];
     }
   }
 }
 
+/// Updates the rights management of the book's download info based on the
+/// MIME type of the response.
+/// @return @c NO if the download was cancelled because the MIME type is not
+/// one we can handle.
+- (BOOL)updateRightsManagementForBook:(NYPLBook *const)book
+                         downloadTask:(NSURLSessionDownloadTask *const)downloadTask
+{
+  if([downloadTask.response.MIMEType isEqualToString:ContentTypeAdobeAdept]) {
+    [self updateDownloadInfoForBookIdentifier:book.identifier
+                         withRightsManagement:NYPLMyBooksDownloadRightsManagementAdobe];
+  } else if ([downloadTask.response.MIMEType isEqualToString:ContentTypeAxis360]) {
+    [self updateDownloadInfoForBookIdentifier:book.identifier
+                         withRightsManagement:NYPLMyBooksDownloadRightsManagementAxis];
+#if LCP
+  } else if([downloadTask.response.MIMEType isEqualToString:ContentTypeReadiumLCP]) {
+    [self updateDownloadInfoForBookIdentifier:book.identifier
+                         withRightsManagement:NYPLMyBooksDownloadRightsManagementLCP];
+#endif
+  } else if([downloadTask.response.MIMEType isEqualToString:ContentTypeEpubZip]) {
+    [self updateDownloadInfoForBookIdentifier:book.identifier
+                         withRightsManagement:NYPLMyBooksDownloadRightsManagementNone];
+  } else if ([downloadTask.response.MIMEType isEqualToString:ContentTypeBearerToken]) {
+    [self updateDownloadInfoForBookIdentifier:book.identifier
+                         withRightsManagement:NYPLMyBooksDownloadRightsManagementSimplifiedBearerTokenJSON];
+#if FEATURE_AUDIOBOOKS && FEATURE_OVERDRIVE_AUTH
+  } else if ([downloadTask.response.MIMEType isEqualToString:ContentTypeOverdriveAudiobookActual]) {
+    [self updateDownloadInfoForBookIdentifier:book.identifier
+                         withRightsManagement:NYPLMyBooksDownloadRightsManagementOverdriveManifestJSON];
+#endif
+  } else if ([NYPLOPDSAcquisitionPath.supportedTypes containsObject:downloadTask.response.MIMEType]) {
+    [self updateDownloadInfoForBookIdentifier:book.identifier
+                         withRightsManagement:NYPLMyBooksDownloadRightsManagementNone];
+  } else {
+    NYPLLOG(@"Authentication might be needed after all");
+    [downloadTask cancel];
+    [[NYPLBookRegistry sharedRegistry] setState:NYPLBookStateDownloadFailed forIdentifier:book.identifier];
+    [self broadcastUpdate:book.identifier];
+    return NO;
+  }
+
+  return YES;
+}
+
 - (void)URLSession:(__attribute__((unused)) NSURLSession *)session
       downloadTask:(NSURLSessionDownloadTask *const)downloadTask
 didFinishDownloadingToURL:(NSURL *const)tmpSavedFileURL
 {
-  NYPLBook *const book = self.taskIdentifierToBook[@(downloadTask.taskIdentifier)];
+  NYPLBook *const book = [self bookForTaskIdentifier:downloadTask.taskIdentifier];
   
   if(!book) {
     // A reset must have occurred.
@@ -221,12 +314,50 @@ didFinishDownloadingToURL:(NSURL *const)tmpSavedFileURL
   }
 
   [self.taskIdentifierToRedirectAttempts removeObjectForKey:@(downloadTask.taskIdentifier)];
-  
+
+  // The file at |tmpSavedFileURL| is removed as soon as this method returns. We move it aside so
+  // that it can be processed on |processingQueue| while this queue keeps handling the progress of
+  // other downloads.
+  NSURL *const stagedFileURL = [[NSURL fileURLWithPath:NSTemporaryDirectory()]
+                                URLByAppendingPathComponent:[NSUUID UUID].UUIDString];
+  NSError *stagingError = nil;
+  if (![[NSFileManager defaultManager] moveItemAtURL:tmpSavedFileURL
+                                               toURL:stagedFileURL
+                                               error:&stagingError]) {
+    [self logBookDownloadFailure:book
+                          reason:@"Couldn't move downloaded file aside for processing"
+                    downloadTask:downloadTask
+                        metadata:@{@"stagingError": stagingError ?: @"N/A"}];
+    [self failDownloadWithAlertForBook:book];
+    return;
+  }
+
+  dispatch_async(self.processingQueue, ^{
+    // A reset may have occurred while the file was waiting to be processed.
+    if ([self bookForTaskIdentifier:downloadTask.taskIdentifier]) {
+      [self processDownloadedFileAtURL:stagedFileURL forBook:book downloadTask:downloadTask];
+    }
+    [[NSFileManager defaultManager] removeItemAtURL:stagedFileURL error:NULL];
+  });
+}
+
+/// Handles a downloaded file according to the rights management of the
+/// download, on @c processingQueue. The file is removed once this returns.
+- (void)processDownloadedFileAtURL:(NSURL *const)tmpSavedFileURL
+                           forBook:(NYPLBook *const)book
+                      downloadTask:(NSURLSessionDownloadTask *const)downloadTask
+{
   BOOL failureRequiringAlert = NO;
   NSError *failureError = downloadTask.error;
   NYPLProblemDocument *problemDoc = nil;
   NYPLMyBooksDownloadRightsManagement rights = [self downloadInfoForBookIdentifier:book.identifier].rightsManagement;
 
+  // The bearer token document is followed by the download of the actual
+  // content, which may itself be resumable.
+  if (rights != NYPLMyBooksDownloadRightsManagementSimplifiedBearerTokenJSON) {
+    [[self resumeStore] removeResumeDataForBookIdentifier:book.identifier];
+  }
+
   if ([downloadTask.response isProblemDocument]) {
     NSError *problemDocumentParseError = nil;
     NSData *problemDocData = [NSData dataWithContentsOfURL:tmpSavedFileURL];
@@ -285,20 +416,23 @@ didFinishDownloadingToURL:(NSURL *const)tmpSavedFileURL
           failureRequiringAlert = YES;
         } else {
           NYPLLOG_F(@"Download finished. Fulfilling with userID: %@",[[NYPLUserAccount sharedAccount] userID]);
-          [[NYPLADEPT sharedInstance]
-           fulfillWithACSMData:ACSMData
-           tag:book.identifier
-           userID:[[NYPLUserAccount sharedAccount] userID]
-           deviceID:[[NYPLUserAccount sharedAccount] deviceID]
-           completion:^(NSError *fulfillError) {
-            if (fulfillError) {
-              [self logBookDownloadFailure:book
-                                    reason:@"Unable to fulfill loan with Adobe"
-                              downloadTask:downloadTask
-                                  metadata:nil];
-              [self failDownloadWithAlertForBook:book error:fulfillError];
-            }
-          }];
+          // The DRM connector has always been driven from the main thread.
+          dispatch_async(dispatch_get_main_queue(), ^{
+            [[NYPLADEPT sharedInstance]
+             fulfillWithACSMData:ACSMData
+             tag:book.identifier
+             userID:[[NYPLUserAccount sharedAccount] userID]
+             deviceID:[[NYPLUserAccount sharedAccount] deviceID]
+             completion:^(NSError *fulfillError) {
+              if (fulfillError) {
+                [self logBookDownloadFailure:book
+                                      reason:@"Unable to fulfill loan with Adobe"
+                                downloadTask:downloadTask
+                                    metadata:nil];
+                [self failDownloadWithAlertForBook:book error:fulfillError];
+              }
+            }];
+          });
         }
 #endif
         break;
@@ -344,13 +478,16 @@ didFinishDownloadingToURL:(NSURL *const)tmpSavedFileURL
         NSMutableURLRequest *const mutableRequest = [NSMutableURLRequest requestWithURL:simplifiedBearerToken.location];
         [mutableRequest setValue:[NSString stringWithFormat:@"Bearer %@", simplifiedBearerToken.accessToken]
               forHTTPHeaderField:@"Authorization"];
-        NSURLSessionDownloadTask *const task = [self.session downloadTaskWithRequest:mutableRequest];
-        self.bookIdentifierToDownloadInfo[book.identifier] =
+        NSURLSessionDownloadTask *const task = [self downloadTaskWithRequest:mutableRequest
+                                                                     forBook:book];
+        [self setDownloadInfo:
           [[NYPLMyBooksDownloadInfo alloc]
-           initWithDownloadProgress:0.0
+           initWithDownloadProgress:[[self resumeStore] progressForBookIdentifier:book.identifier
+                                                                              url:mutableRequest.URL]
            downloadTask:task
-           rightsManagement:NYPLMyBooksDownloadRightsManagementNone];
-        self.taskIdentifierToBook[@(task.taskIdentifier)] = book;
+           rightsManagement:NYPLMyBooksDownloadRightsManagementNone]
+           forBookIdentifier:book.identifier];
+        [self setBook:book forTaskIdentifier:task.taskIdentifier];
         [task resume];
         break;
       }
@@ -375,7 +512,9 @@ didFinishDownloadingToURL:(NSURL *const)tmpSavedFileURL
                                                 downloadBroadcaster:self
                                                 fileURL:tmpSavedFileURL];
         
-        [self.bookIdentifierToAxisAdapter setValue:adapter forKey:book.identifier];
+        @synchronized(self) {
+          [self.bookIdentifierToAxisAdapter setValue:adapter forKey:book.identifier];
+        }
         [adapter downloadBook];
 #endif
         break;
@@ -404,7 +543,9 @@ didFinishDownloadingToURL:(NSURL *const)tmpSavedFileURL
   
 #if FEATURE_AUDIOBOOKS
   if (book.defaultBookContentType == NYPLBookContentTypeAudiobook) {
-    [self downloadAudiobookForBook:book];
+    dispatch_async(dispatch_get_main_queue(), ^{
+      [self downloadAudiobookForBook:book];
+    });
   }
 #else
   [self broadcastUpdate:book.identifier];
@@ -485,7 +626,9 @@ willPerformHTTPRedirection:(__unused NSHTTPURLResponse *)response
               task:(NSURLSessionTask *)task
 didCompleteWithError:(NSError *)error
 {
-  NYPLBook *const book = self.taskIdentifierToBook[@(task.taskIdentifier)];
+  [self taskDidComplete];
+
+  NYPLBook *const book = [self bookForTaskIdentifier:task.taskIdentifier];
   
   if(!book) {
     // A reset must have occurred.
@@ -505,6 +648,10 @@ didCompleteWithError:(NSError *)error
       @(task.taskIdentifier)];
   */
   
+  if(error) {
+    [self saveResumeDataFromError:error forBook:book downloadTask:task];
+  }
+
   if(error && error.code != NSURLErrorCancelled) {
     [self logBookDownloadFailure:book
                           reason:@"networking error"
@@ -516,6 +663,31 @@ didCompleteWithError:(NSError *)error
   }
 }
 
+- (void)URLSession:(__attribute__((unused)) NSURLSession *)session
+              task:(NSURLSessionTask *const)task
+didFinishCollectingMetrics:(NSURLSessionTaskMetrics *const)metrics
+{
+  NYPLBook *const book = [self bookForTaskIdentifier:task.taskIdentifier];
+  NSHTTPURLResponse *const response = (NSHTTPURLResponse *)task.response;
+
+  if(!book || task.error || ![response isKindOfClass:[NSHTTPURLResponse class]]
+     || response.statusCode < 200 || response.statusCode > 299) {
+    return;
+  }
+
+  // Only the downloads of the content itself are comparable with segmented
+  // downloads: DRM documents and bearer tokens are tiny.
+  if([self downloadInfoForBookIdentifier:book.identifier].rightsManagement
+     != NYPLMyBooksDownloadRightsManagementNone) {
+    return;
+  }
+
+  [[NYPLDownloadMetrics shared] recordDownloadWithDistributor:book.distributor
+                                                         mode:NYPLDownloadModeSingleStream
+                                                    byteCount:task.countOfBytesReceived
+                                                     duration:metrics.taskInterval.duration];
+}
+
 #pragma mark - File Management
 
 - (BOOL)moveFileAtURL:(NSURL *)sourceLocation
@@ -580,7 +752,9 @@ didCompleteWithError:(NSError *)error
     }];
   }
 #if defined(AXIS)
-  [self.bookIdentifierToAxisAdapter removeObjectForKey:book.identifier];
+  @synchronized(self) {
+    [self.bookIdentifierToAxisAdapter removeObjectForKey:book.identifier];
+  }
 #endif
 
   return success;
@@ -600,6 +774,7 @@ didCompleteWithError:(NSError *)error
   }
   
   NSURL *bookURL = [self fileURLForBookIndentifier:identifier account:account];
+  [[self resumeStoreForAccount:account] removeResumeDataForBookIdentifier:identifier];
   
   switch (book.defaultBookContentType) {
     case NYPLBookContentTypeEPUB: {
@@ -772,6 +947,7 @@ didCompleteWithError:(NSError *)error
   else
   {
     [self deleteAudiobooksForAccount:account];
+    [[self resumeStoreForAccount:account] removeAll];
     [[NSFileManager defaultManager]
      removeItemAtURL:[self contentDirectoryURL:account]
      error:NULL];
@@ -782,13 +958,24 @@ didCompleteWithError:(NSError *)error
 {
   [self deleteAudiobooksForAccount:[AccountsManager sharedInstance].currentAccount.uuid];
 
-  for(NYPLMyBooksDownloadInfo *const info in [self.bookIdentifierToDownloadInfo allValues]) {
-    [info.downloadTask cancelByProducingResumeData:^(__unused NSData *resumeData) {}];
+  NSArray<NYPLMyBooksDownloadInfo *> *infos = nil;
+  NSArray<NYPLSegmentedDownload *> *segmentedDownloads = nil;
+  @synchronized(self) {
+    infos = [self.bookIdentifierToDownloadInfo allValues];
+    segmentedDownloads = [self.bookIdentifierToSegmentedDownload allValues];
+    [self.bookIdentifierToDownloadInfo removeAllObjects];
+    [self.bookIdentifierToSegmentedDownload removeAllObjects];
+    [self.taskIdentifierToBook removeAllObjects];
+    self.bookIdentifierOfBookToRemove = nil;
   }
 
-  [self.bookIdentifierToDownloadInfo removeAllObjects];
-  [self.taskIdentifierToBook removeAllObjects];
-  self.bookIdentifierOfBookToRemove = nil;
+  for(NYPLMyBooksDownloadInfo *const info in infos) {
+    [info.downloadTask cancelByProducingResumeData:^(__unused NSData *resumeData) {}];
+  }
+  for(NYPLSegmentedDownload *const segmentedDownload in segmentedDownloads) {
+    [segmentedDownload cancel];
+  }
+  [[self resumeStore] removeAll];
 
   [[NSFileManager defaultManager]
    removeItemAtURL:[self contentDirectoryURL]
@@ -799,9 +986,64 @@ didCompleteWithError:(NSError *)error
 
 #pragma mark - Download Logic
 
+// The maps below are accessed both from the main thread and from |delegateQueue|.
+
 - (NYPLMyBooksDownloadInfo *)downloadInfoForBookIdentifier:(NSString *const)bookIdentifier
 {
-  return self.bookIdentifierToDownloadInfo[bookIdentifier];
+  @synchronized(self) {
+    return self.bookIdentifierToDownloadInfo[bookIdentifier];
+  }
+}
+
+- (void)setDownloadInfo:(NYPLMyBooksDownloadInfo *const)info
+      forBookIdentifier:(NSString *const)bookIdentifier
+{
+  if (!bookIdentifier) {
+    return;
+  }
+  @synchronized(self) {
+    self.bookIdentifierToDownloadInfo[bookIdentifier] = info;
+  }
+}
+
+// Does nothing if there is no download info for the book.
+- (void)updateDownloadInfoForBookIdentifier:(NSString *const)bookIdentifier
+                       withRightsManagement:(NYPLMyBooksDownloadRightsManagement const)rightsManagement
+{
+  if (!bookIdentifier) {
+    return;
+  }
+  @synchronized(self) {
+    self.bookIdentifierToDownloadInfo[bookIdentifier] =
+      [self.bookIdentifierToDownloadInfo[bookIdentifier] withRightsManagement:rightsManagement];
+  }
+}
+
+// Does nothing if there is no download info for the book.
+- (void)updateDownloadInfoForBookIdentifier:(NSString *const)bookIdentifier
+                       withDownloadProgress:(double const)downloadProgress
+{
+  if (!bookIdentifier) {
+    return;
+  }
+  @synchronized(self) {
+    self.bookIdentifierToDownloadInfo[bookIdentifier] =
+      [self.bookIdentifierToDownloadInfo[bookIdentifier] withDownloadProgress:downloadProgress];
+  }
+}
+
+- (NYPLBook *)bookForTaskIdentifier:(NSUInteger const)taskIdentifier
+{
+  @synchronized(self) {
+    return self.taskIdentifierToBook[@(taskIdentifier)];
+  }
+}
+
+- (void)setBook:(NYPLBook *const)book forTaskIdentifier:(NSUInteger const)taskIdentifier
+{
+  @synchronized(self) {
+    self.taskIdentifierToBook[@(taskIdentifier)] = book;
+  }
 }
 
 - (void)handleBorrowError:(NSDictionary<NSString *,id> * _Nullable)errorDict
@@ -1148,19 +1390,37 @@ didCompleteWithError:(NSError *)error
     [self alertForProblemDocument:nil error:nil book:book];
     return;
   }
-    
-  NSURLSessionDownloadTask *const task = [self.session downloadTaskWithRequest:request];
+
+  if ([self shouldAttemptSegmentedDownloadWithRequest:request book:book]) {
+    [self startSegmentedDownloadWithRequest:request book:book];
+    return;
+  }
+
+  [self addSingleStreamDownloadTaskWithRequest:request book:book];
+}
+
+- (void)addSingleStreamDownloadTaskWithRequest:(NSURLRequest *)request
+                                          book:(NYPLBook *)book
+{
+  NSURLSessionDownloadTask *const task = [self downloadTaskWithRequest:request forBook:book];
   
-  self.bookIdentifierToDownloadInfo[book.identifier] =
+  [self setDownloadInfo:
     [[NYPLMyBooksDownloadInfo alloc]
-     initWithDownloadProgress:0.0
+     initWithDownloadProgress:[[self resumeStore] progressForBookIdentifier:book.identifier
+                                                                        url:request.URL]
      downloadTask:task
-     rightsManagement:NYPLMyBooksDownloadRightsManagementUnknown];
+     rightsManagement:NYPLMyBooksDownloadRightsManagementUnknown]
+       forBookIdentifier:book.identifier];
   
-  self.taskIdentifierToBook[@(task.taskIdentifier)] = book;
+  [self setBook:book forTaskIdentifier:task.taskIdentifier];
   
   [task resume];
   
+  [self registerDownloadingBook:book];
+}
+
+- (void)registerDownloadingBook:(NYPLBook *)book
+{
   [[NYPLBookRegistry sharedRegistry]
    addBook:book
    location:nil
@@ -1175,14 +1435,287 @@ didCompleteWithError:(NSError *)error
   assert(book.identifier != nil);
 
   // It is important to issue this immediately because a previous download may have left the
-  // progress for the book at greater than 0.0 and we do not want that to be temporarily shown to
-  // the user. As such, calling |broadcastUpdate| is not appropriate due to the delay.
-  [[NSNotificationCenter defaultCenter]
-   postNotificationName:NSNotification.NYPLMyBooksDownloadCenterDidChange
-   object:self
-   userInfo:@{
-     NYPLNotificationKeys.bookIDKey: book.identifier ?: @""
-   }];
+  // progress for the book at a different value than the one it resumes from and we do not want
+  // that to be temporarily shown to the user. As such, calling |broadcastUpdate| is not
+  // appropriate due to the delay.
+  [self.progressHub publishNowForBookIdentifier:book.identifier ?: @""];
+}
+
+#pragma mark - Segmented Downloads
+
+/// Segmented downloads are only attempted for DRM-free content, whose
+/// response is the book itself, and when there is no partial single stream
+/// download to resume.
+- (BOOL)shouldAttemptSegmentedDownloadWithRequest:(NSURLRequest *const)request
+                                             book:(NYPLBook *const)book
+{
+  if (![NYPLSettings sharedSettings].useSegmentedDownloads) {
+    return NO;
+  }
+  if (request.HTTPMethod && ![request.HTTPMethod isEqualToString:@"GET"]) {
+    return NO;
+  }
+  if ([[self resumeStore] resumeDataForBookIdentifier:book.identifier url:request.URL]) {
+    return NO;
+  }
+  return [[self segmentedDownloadContentTypes] containsObject:
+          book.defaultAcquisition.type.lowercaseString];
+}
+
+- (NSSet<NSString *> *)segmentedDownloadContentTypes
+{
+  return [NSSet setWithObjects:ContentTypeEpubZip, ContentTypeOpenAccessPDF, nil];
+}
+
+/// Downloads the book over several connections, falling back to a single
+/// stream if the server doesn't support range requests.
+- (void)startSegmentedDownloadWithRequest:(NSURLRequest *const)request
+                                     book:(NYPLBook *const)book
+{
+  NSURL *const fileURL = [[NSURL fileURLWithPath:NSTemporaryDirectory()]
+                          URLByAppendingPathComponent:[NSUUID UUID].UUIDString];
+  NYPLSegmentedDownload *const segmentedDownload =
+    [[NYPLSegmentedDownload alloc] initWithRequest:request
+                                     configuration:self.session.configuration
+                                    destinationURL:fileURL
+                                      segmentCount:NYPLSegmentedDownload.defaultSegmentCount
+                              minimumContentLength:NYPLSegmentedDownload.defaultMinimumContentLength];
+  segmentedDownload.acceptableContentTypes = [self segmentedDownloadContentTypes];
+  segmentedDownload.challengeHandler = ^(NSURLAuthenticationChallenge *challenge,
+                                         void (^completionHandler)(NSURLSessionAuthChallengeDisposition,
+                                                                   NSURLCredential *)) {
+    NYPLBasicAuth *handler = [[NYPLBasicAuth alloc] initWithCredentialsProvider:NYPLUserAccount.sharedAccount];
+    [handler handleChallenge:challenge completion:completionHandler];
+  };
+
+  __weak __auto_type wSelf = self;
+  segmentedDownload.progressHandler = ^(int64_t written, int64_t total) {
+    [wSelf updateDownloadInfoForBookIdentifier:book.identifier
+                          withDownloadProgress:(written / (double) total)];
+    [wSelf broadcastUpdate:book.identifier];
+  };
+
+  @synchronized(self) {
+    self.bookIdentifierToSegmentedDownload[book.identifier] = segmentedDownload;
+  }
+  [self setDownloadInfo:
+    [[NYPLMyBooksDownloadInfo alloc]
+     initWithDownloadProgress:0
+     downloadTask:nil
+     rightsManagement:NYPLMyBooksDownloadRightsManagementUnknown]
+       forBookIdentifier:book.identifier];
+  [self taskWillStart];
+
+  [segmentedDownload startWithCompletion:^(NYPLSegmentedDownloadOutcome outcome,
+                                           NSURL *downloadedFileURL,
+                                           NSHTTPURLResponse *response,
+                                           NSError *error) {
+    [wSelf   segmentedDownload:segmentedDownload
+                       forBook:book
+                       request:request
+          didFinishWithOutcome:outcome
+                       fileURL:downloadedFileURL
+                      response:response
+                         error:error];
+  }];
+
+  [self registerDownloadingBook:book];
+}
+
+- (void)segmentedDownload:(NYPLSegmentedDownload *const)segmentedDownload
+                  forBook:(NYPLBook *const)book
+                  request:(NSURLRequest *const)request
+     didFinishWithOutcome:(NYPLSegmentedDownloadOutcome const)outcome
+                  fileURL:(NSURL *const)fileURL
+                 response:(NSHTTPURLResponse *const)response
+                    error:(NSError *const)error
+{
+  [self taskDidComplete];
+
+  @synchronized(self) {
+    if (self.bookIdentifierToSegmentedDownload[book.identifier] != segmentedDownload) {
+      // The download was cancelled or a reset occurred.
+      if (fileURL) {
+        [[NSFileManager defaultManager] removeItemAtURL:fileURL error:NULL];
+      }
+      return;
+    }
+    [self.bookIdentifierToSegmentedDownload removeObjectForKey:book.identifier];
+  }
+
+  switch (outcome) {
+    case NYPLSegmentedDownloadOutcomeCompleted: {
+      [[NYPLDownloadMetrics shared] recordDownloadWithDistributor:book.distributor
+                                                             mode:NYPLDownloadModeSegmented
+                                                        byteCount:segmentedDownload.expectedLength
+                                                         duration:segmentedDownload.duration];
+      [self updateDownloadInfoForBookIdentifier:book.identifier
+                           withRightsManagement:NYPLMyBooksDownloadRightsManagementNone];
+      dispatch_async(self.processingQueue, ^{
+        if (![self moveFileAtURL:fileURL toDestinationForBook:book forDownloadTask:nil]) {
+          [[NSFileManager defaultManager] removeItemAtURL:fileURL error:NULL];
+          [self failDownloadWithAlertForBook:book];
+          return;
+        }
+        [self broadcastUpdate:book.identifier];
+      });
+      break;
+    }
+    case NYPLSegmentedDownloadOutcomeUnsupported:
+      NYPLLOG_F(@"Segmented download not supported for %@, downloading in a single stream",
+                book.identifier);
+      [self addSingleStreamDownloadTaskWithRequest:request book:book];
+      break;
+    case NYPLSegmentedDownloadOutcomeFailed:
+      [self logBookDownloadFailure:book
+                            reason:@"segmented download error"
+                      downloadTask:nil
+                          metadata:@{
+                            @"urlSessionError": error ?: @"N/A",
+                            @"response": response ?: @"N/A",
+                          }];
+      [self failDownloadWithAlertForBook:book error:error];
+      break;
+    case NYPLSegmentedDownloadOutcomeCancelled:
+      break;
+  }
+}
+
+/// Creates a task resuming the previous download of @c book if resume data
+/// was saved for the same URL, or a new task otherwise.
+- (NSURLSessionDownloadTask *)downloadTaskWithRequest:(NSURLRequest *const)request
+                                              forBook:(NYPLBook *const)book
+{
+  NSURLSessionDownloadTask *task = nil;
+  NSData *const resumeData = [[self resumeStore] resumeDataForBookIdentifier:book.identifier
+                                                                         url:request.URL];
+  if (resumeData) {
+    NYPLLOG_F(@"Resuming previous download of %@", book.identifier);
+    task = [self.session downloadTaskWithResumeData:resumeData];
+    if (!task) {
+      [[self resumeStore] removeResumeDataForBookIdentifier:book.identifier];
+    }
+  }
+  if (!task) {
+    task = [self.session downloadTaskWithRequest:request];
+  }
+
+  [self taskWillStart];
+  return task;
+}
+
+/// Counts a download task that is about to start. In debug builds, starts
+/// monitoring main thread stalls when the first download starts.
+- (void)taskWillStart
+{
+  @synchronized(self) {
+#if DEBUG
+    if (self.activeTaskCount == 0) {
+      [self.stallMonitor start];
+    }
+#endif
+    self.activeTaskCount += 1;
+  }
+}
+
+/// Counts a download task that completed. In debug builds, stops monitoring
+/// main thread stalls, logging a summary, when the last download completes.
+- (void)taskDidComplete
+{
+  @synchronized(self) {
+    if (self.activeTaskCount == 0) {
+      return;
+    }
+    self.activeTaskCount -= 1;
+#if DEBUG
+    if (self.activeTaskCount == 0) {
+      [self.stallMonitor stop];
+    }
+#endif
+  }
+}
+
+- (void)saveResumeData:(NSData *const)resumeData
+     forBookIdentifier:(NSString *const)identifier
+          downloadTask:(NSURLSessionTask *const)task
+{
+  if (!resumeData || !identifier || !task.originalRequest.URL) {
+    return;
+  }
+  [[self resumeStore] setResumeData:resumeData
+                  forBookIdentifier:identifier
+                                url:task.originalRequest.URL
+                           response:task.response
+                             offset:task.countOfBytesReceived
+                     expectedLength:task.countOfBytesExpectedToReceive];
+}
+
+/// Saves the resume data of a task that failed or was cancelled. If there is
+/// none, any resume data used to start the task is obsolete, unless the task
+/// was cancelled since the data is then provided to the cancellation handler.
+- (void)saveResumeDataFromError:(NSError *const)error
+                        forBook:(NYPLBook *const)book
+                   downloadTask:(NSURLSessionTask *const)task
+{
+  NSData *const resumeData = error.userInfo[NSURLSessionDownloadTaskResumeData];
+  if (resumeData) {
+    [self saveResumeData:resumeData forBookIdentifier:book.identifier downloadTask:task];
+  } else if (error.code != NSURLErrorCancelled) {
+    [[self resumeStore] removeResumeDataForBookIdentifier:book.identifier];
+  }
+}
+
+- (NYPLBookDownloadResumeStore *)resumeStore
+{
+  return [self resumeStoreForAccount:[AccountsManager sharedInstance].currentAccount.uuid];
+}
+
+- (NYPLBookDownloadResumeStore *)resumeStoreForAccount:(NSString *const)account
+{
+  @synchronized(self) {
+    NYPLBookDownloadResumeStore *store = account ? self.accountToResumeStore[account] : nil;
+    if (!store) {
+      NSURL *const directoryURL = [[NYPLBookContentMetadataFilesHelper directoryFor:account]
+                                   URLByAppendingPathComponent:@"resume"];
+      store = [[NYPLBookDownloadResumeStore alloc] initWithDirectoryURL:directoryURL];
+      if (account) {
+        self.accountToResumeStore[account] = store;
+      }
+    }
+    return store;
+  }
+}
+
+/// Gives in-flight downloads a chance to be resumed on the next launch.
+/// The wait is bounded since the app is about to be terminated. Rather than
+/// blocking the main thread, which may be the one delivering the resume
+/// data, its run loop keeps running until the data is saved.
+- (void)applicationWillTerminate
+{
+  dispatch_group_t const group = dispatch_group_create();
+  NSArray<NSString *> *identifiers = nil;
+  @synchronized(self) {
+    identifiers = [self.bookIdentifierToDownloadInfo allKeys];
+  }
+  for(NSString *const identifier in identifiers) {
+    NSURLSessionDownloadTask *const task =
+      [self downloadInfoForBookIdentifier:identifier].downloadTask;
+    if(!task || task.state != NSURLSessionTaskStateRunning) {
+      continue;
+    }
+    dispatch_group_enter(group);
+    [task cancelByProducingResumeData:^(NSData *resumeData) {
+      [self saveResumeData:resumeData forBookIdentifier:identifier downloadTask:task];
+      dispatch_group_leave(group);
+    }];
+  }
+
+  NSDate *const deadline = [NSDate dateWithTimeIntervalSinceNow:1];
+  while(dispatch_group_wait(group, DISPATCH_TIME_NOW) != 0
+        && [deadline timeIntervalSinceNow] > 0) {
+    [[NSRunLoop currentRunLoop] runMode:NSDefaultRunLoopMode
+                             beforeDate:[NSDate dateWithTimeIntervalSinceNow:0.01]];
+  }
 }
 
 - (void)cancelDownloadForBookIdentifier:(NSString *)identifier
@@ -1198,14 +1731,31 @@ didCompleteWithError:(NSError *)error
     #endif
     
 #if defined(AXIS)
-    NYPLAxisBookDownloadAdapter *adapter = [self.bookIdentifierToAxisAdapter
-                                    objectForKey:identifier];
+    NYPLAxisBookDownloadAdapter *adapter = nil;
+    @synchronized(self) {
+      adapter = [self.bookIdentifierToAxisAdapter objectForKey:identifier];
+      [self.bookIdentifierToAxisAdapter removeObjectForKey:identifier];
+    }
     [adapter downloadCancelledByUser];
-    [self.bookIdentifierToAxisAdapter removeObjectForKey:identifier];
 #endif
     
-    [info.downloadTask
-     cancelByProducingResumeData:^(__attribute__((unused)) NSData *resumeData) {
+    NYPLSegmentedDownload *segmentedDownload = nil;
+    @synchronized(self) {
+      segmentedDownload = self.bookIdentifierToSegmentedDownload[identifier];
+      [self.bookIdentifierToSegmentedDownload removeObjectForKey:identifier];
+    }
+    if (segmentedDownload) {
+      [segmentedDownload cancel];
+      [[NYPLBookRegistry sharedRegistry]
+       setState:NYPLBookStateDownloadNeeded forIdentifier:identifier];
+      [self broadcastUpdate:identifier];
+      return;
+    }
+
+    NSURLSessionDownloadTask *const task = info.downloadTask;
+    [task
+     cancelByProducingResumeData:^(NSData *resumeData) {
+       [self saveResumeData:resumeData forBookIdentifier:identifier downloadTask:task];
        [[NYPLBookRegistry sharedRegistry]
         setState:NYPLBookStateDownloadNeeded forIdentifier:identifier];
        
@@ -1250,28 +1800,13 @@ didCompleteWithError:(NSError *)error
 
 - (void)broadcastUpdate:(NSString *)bookID
 {
-  // We avoid issuing redundant notifications to prevent overwhelming UI updates.
-  if(self.broadcastScheduled) return;
-  
-  self.broadcastScheduled = YES;
-  
-  // This needs to be queued on the main run loop. If we queue it elsewhere, it may end up never
-  // firing due to a run loop becoming inactive.
-  dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(0.2 * NSEC_PER_SEC)),
-                 dispatch_get_main_queue(), ^{
-    self.broadcastScheduled = NO;
-
-    // if the book ID is nil something seriously wrong is happening that should
-    // be looked at *right now*
-    assert(bookID != nil);
-
-    [[NSNotificationCenter defaultCenter]
-     postNotificationName:NSNotification.NYPLMyBooksDownloadCenterDidChange
-     object:self
-     userInfo:@{
-       NYPLNotificationKeys.bookIDKey: bookID ?: @""
-     }];
-  });
+  // if the book ID is nil something seriously wrong is happening that should
+  // be looked at *right now*
+  assert(bookID != nil);
+
+  // We avoid issuing redundant notifications to prevent overwhelming UI updates: all the books
+  // updated until the end of the current tick are reported in a single notification.
+  [self.progressHub recordChangeForBookIdentifier:bookID ?: @""];
 }
 
 #pragma mark - Return Logic
@@ -1400,7 +1935,9 @@ didCompleteWithError:(NSError *)error
    genericBookmarks:nil];
 
 #if defined(AXIS)
-  [self.bookIdentifierToAxisAdapter removeObjectForKey:book.identifier];
+  @synchronized(self) {
+    [self.bookIdentifierToAxisAdapter removeObjectForKey:book.identifier];
+  }
 #endif
 
   dispatch_async(dispatch_get_main_queue(), ^{
@@ -1509,8 +2046,8 @@ didCompleteWithError:(NSError *)error
   
 - (void)adept:(__attribute__((unused)) NYPLADEPT *)adept didUpdateProgress:(double)progress tag:(NSString *)tag
 {
-  self.bookIdentifierToDownloadInfo[tag] =
-  [[self downloadInfoForBookIdentifier:tag] withDownloadProgress:progress];
+  [self updateDownloadInfoForBookIdentifier:tag
+                       withDownloadProgress:progress];
 
   [self broadcastUpdate:tag];
 }
@@ -1688,9 +2225,8 @@ didFinishDownload:(BOOL)didFinishDownload
 
 #if defined(AXIS)
 - (void)downloadProgressDidUpdateTo:(double)progress forBook:(NYPLBook * _Nonnull)book {
-  self.bookIdentifierToDownloadInfo[book.identifier] =
-  [[self downloadInfoForBookIdentifier:book.identifier]
-   withDownloadProgress:progress];
+  [self updateDownloadInfoForBookIdentifier:book.identifier
+                       withDownloadProgress:progress];
 
   [self broadcastUpdate:book.identifier];
 }
@@ -1699,8 +2235,8 @@ didFinishDownload:(BOOL)didFinishDownload
 #if FEATURE_AUDIOBOOKS
 - (void)downloadProgressDidUpdateTo:(double)progress forBookIdentifier:(NSString *)bookID {
   NYPLLOG_F(@"Download progress updated to %f for %@", progress, bookID);
-  self.bookIdentifierToDownloadInfo[bookID] = [[self downloadInfoForBookIdentifier:bookID]
-                                               withDownloadProgress:progress];
+  [self updateDownloadInfoForBookIdentifier:bookID
+                       withDownloadProgress:progress];
 
   [self broadcastUpdate:bookID];
 }
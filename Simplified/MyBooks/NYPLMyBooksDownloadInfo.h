@@ -13,6 +13,7 @@ typedef NS_ENUM(NSInteger, NYPLMyBooksDownloadRightsManagement) {
 @interface NYPLMyBooksDownloadInfo : NSObject
 
 @property (nonatomic, readonly) CGFloat downloadProgress;
+/// Nil for segmented downloads, which use several tasks.
 @property (nonatomic, readonly) NSURLSessionDownloadTask *downloadTask;
 @property (nonatomic, readonly) NYPLMyBooksDownloadRightsManagement rightsManagement;
 
@@ -18,8 +18,6 @@
   if(!self) return nil;
   
   self.downloadProgress = downloadProgress;
-  
-  if(!downloadTask) @throw NSInvalidArgumentException;
   self.downloadTask = downloadTask;
 
   self.rightsManagement = rightsManagement;
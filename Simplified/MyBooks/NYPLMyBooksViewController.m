@@ -257,6 +257,11 @@ didSelectItemAtIndexPath:(NSIndexPath *const)indexPath
   }
 }
 
+- (NSArray<NSArray<NYPLBook *> *> *)booksBySection
+{
+  return @[self.books ?: @[]];
+}
+
 #pragma mark NYPLFacetViewDataSource
 
 - (NSUInteger)numberOfFacetGroupsInFacetView:(__attribute__((unused)) NYPLFacetView *)facetView
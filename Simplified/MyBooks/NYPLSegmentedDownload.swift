@@ -0,0 +1,442 @@
+//
+//  NYPLSegmentedDownload.swift
+//  Simplified
+//
+//  Copyright © 2026 NYPL. All rights reserved.
+//
+
+import Foundation
+
+@objc enum NYPLSegmentedDownloadOutcome: Int {
+  /// The whole resource was written to the destination file.
+  case completed
+  /// The server doesn't support range requests for this resource, or
+  /// stopped honoring them. The resource should be downloaded in a single
+  /// stream instead.
+  case unsupported
+  /// A segment could not be downloaded after several attempts.
+  case failed
+  case cancelled
+}
+
+/// Downloads a resource over several connections at once.
+///
+/// The server is first probed with a `Range: bytes=0-0` request. If it
+/// answers with `206 Partial Content`, a total length of at least
+/// `minimumContentLength` and a strong `ETag`, the destination file is
+/// preallocated to the total length and split into `segmentCount` byte
+/// ranges which are downloaded in parallel, each written in place at its
+/// offset. Every range request carries the `ETag` in an `If-Range` header,
+/// so that a resource changing during the download is detected rather than
+/// corrupting the file. A `Last-Modified` date is not enough, since it only
+/// makes a strong validator when the resource can't change twice in the
+/// same second, which the client has no way to know.
+///
+/// A segment that fails or is cut short is requested again from the first
+/// missing byte, up to `maxAttemptsPerSegment` times. Any answer other than
+/// the expected partial content ends the download as `unsupported`, so that
+/// the caller can fall back to a single stream.
+@objcMembers final class NYPLSegmentedDownload: NSObject {
+
+  static let defaultSegmentCount = 4
+  static let defaultMinimumContentLength: Int64 = 8 * 1024 * 1024
+  static let minimumSegmentLength: Int64 = 1024 * 1024
+  static let maxAttemptsPerSegment = 3
+
+  typealias ChallengeHandler = (URLAuthenticationChallenge,
+    @escaping (URLSession.AuthChallengeDisposition, URLCredential?) -> Void) -> Void
+
+  private final class Segment {
+    let start: Int64
+    let end: Int64
+    var received: Int64 = 0
+    var attempts = 0
+    var task: URLSessionDataTask?
+
+    init(start: Int64, end: Int64) {
+      self.start = start
+      self.end = end
+    }
+
+    var nextOffset: Int64 {
+      return start + received
+    }
+
+    var isComplete: Bool {
+      return nextOffset > end
+    }
+  }
+
+  let request: URLRequest
+  let destinationURL: URL
+  let segmentCount: Int
+  let minimumContentLength: Int64
+
+  /// If set, the download is `unsupported` unless the MIME type of the
+  /// resource is one of these.
+  var acceptableContentTypes: Set<String>?
+
+  /// Handles the authentication challenges of all the requests.
+  var challengeHandler: ChallengeHandler?
+
+  /// Called with the number of bytes written and the total length, on an
+  /// internal serial queue.
+  var progressHandler: ((Int64, Int64) -> Void)?
+
+  /// The time from `start` to completion, in seconds.
+  private(set) var duration: TimeInterval = 0
+
+  /// The total length of the resource, once known.
+  private(set) var expectedLength: Int64 = 0
+
+  private let configuration: URLSessionConfiguration
+  private let delegateQueue: OperationQueue
+  private var session: URLSession?
+  private var completion: ((NYPLSegmentedDownloadOutcome, URL?, HTTPURLResponse?, Error?) -> Void)?
+  private var probeTask: URLSessionDataTask?
+  private var response: HTTPURLResponse?
+  private var validator: String?
+  private var fileHandle: FileHandle?
+  private var segments = [Segment]()
+  private var startTime: TimeInterval = 0
+  private var isFinished = false
+
+  //----------------------------------------------------------------------------
+  /// - Parameters:
+  ///   - request: The request of the resource. Its headers are sent with
+  ///   every range request, except `Authorization` which is only sent to
+  ///   the host of the request.
+  ///   - configuration: The configuration of the session used for the
+  ///   range requests.
+  ///   - destinationURL: Where the resource is written. Any existing file
+  ///   is replaced.
+  ///   - segmentCount: The number of parallel range requests. Fewer are
+  ///   used for resources smaller than `segmentCount` megabytes.
+  ///   - minimumContentLength: Smaller resources are `unsupported`, since
+  ///   they would not benefit from several connections.
+  init(request: URLRequest,
+       configuration: URLSessionConfiguration,
+       destinationURL: URL,
+       segmentCount: Int = NYPLSegmentedDownload.defaultSegmentCount,
+       minimumContentLength: Int64 = NYPLSegmentedDownload.defaultMinimumContentLength) {
+    self.request = request
+    self.configuration = configuration
+    self.destinationURL = destinationURL
+    self.segmentCount = max(1, segmentCount)
+    self.minimumContentLength = minimumContentLength
+    self.delegateQueue = OperationQueue()
+    self.delegateQueue.name = "org.nypl.labs.SimplyE.NYPLSegmentedDownload.delegateQueue"
+    self.delegateQueue.maxConcurrentOperationCount = 1
+    self.delegateQueue.qualityOfService = .utility
+    super.init()
+  }
+
+  //----------------------------------------------------------------------------
+  /// Starts probing the server, then downloading.
+  ///
+  /// - Parameter completion: Called once, on an internal serial queue, with
+  /// the destination URL and the response to the probe when `completed`, or
+  /// the error of the last attempt when `failed`.
+  func start(completion: @escaping (NYPLSegmentedDownloadOutcome, URL?, HTTPURLResponse?, Error?) -> Void) {
+    delegateQueue.addOperation {
+      guard self.session == nil, !self.isFinished else {
+        return
+      }
+      self.completion = completion
+      self.startTime = ProcessInfo.processInfo.systemUptime
+      self.session = URLSession(configuration: self.configuration,
+                                delegate: self,
+                                delegateQueue: self.delegateQueue)
+
+      var probeRequest = self.request
+      probeRequest.setValue("bytes=0-0", forHTTPHeaderField: "Range")
+      let task = self.session?.dataTask(with: probeRequest)
+      self.probeTask = task
+      task?.resume()
+    }
+  }
+
+  //----------------------------------------------------------------------------
+  /// Stops all the requests and removes the partial file.
+  func cancel() {
+    delegateQueue.addOperation {
+      self.finish(.cancelled, error: nil)
+    }
+  }
+
+  // MARK: - Private
+
+  //----------------------------------------------------------------------------
+  private func segment(for task: URLSessionTask) -> Segment? {
+    return segments.first { $0.task === task }
+  }
+
+  //----------------------------------------------------------------------------
+  /// - Returns: Whether the response to the probe allows a segmented
+  /// download, after recording the total length and the entity tag.
+  private func acceptProbeResponse(_ response: URLResponse) -> Bool {
+    guard let httpResponse = response as? HTTPURLResponse,
+      httpResponse.statusCode == 206,
+      let contentRange = NYPLSegmentedDownload.contentRange(of: httpResponse),
+      contentRange.start == 0,
+      let total = contentRange.total,
+      total >= minimumContentLength else {
+        return false
+    }
+
+    if let acceptableContentTypes = acceptableContentTypes {
+      guard let mimeType = httpResponse.mimeType?.lowercased(),
+        acceptableContentTypes.contains(mimeType) else {
+          return false
+      }
+    }
+
+    // If-Range can only be used with a strong entity tag.
+    guard let eTag = httpResponse.eTagHeader, !eTag.hasPrefix("W/") else {
+      return false
+    }
+    validator = eTag
+
+    self.response = httpResponse
+    expectedLength = total
+    return true
+  }
+
+  //----------------------------------------------------------------------------
+  private func startSegments() {
+    do {
+      let fileManager = FileManager.default
+      if fileManager.fileExists(atPath: destinationURL.path) {
+        try fileManager.removeItem(at: destinationURL)
+      }
+      guard fileManager.createFile(atPath: destinationURL.path, contents: nil) else {
+        throw CocoaError(.fileWriteUnknown)
+      }
+      let fileHandle = try FileHandle(forWritingTo: destinationURL)
+      fileHandle.truncateFile(atOffset: UInt64(expectedLength))
+      self.fileHandle = fileHandle
+    } catch {
+      Log.error(#file, "Unable to preallocate \(expectedLength) bytes for segmented download: \(error)")
+      finish(.failed, error: error)
+      return
+    }
+
+    let maxCount = max(1, expectedLength / NYPLSegmentedDownload.minimumSegmentLength)
+    let count = Int64(min(Int64(segmentCount), maxCount))
+    let length = expectedLength / count
+    for index in 0..<count {
+      let start = index * length
+      let end = (index == count - 1) ? expectedLength - 1 : start + length - 1
+      segments.append(Segment(start: start, end: end))
+    }
+
+    Log.info(#file, "Downloading \(expectedLength) bytes in \(count) segments from \(request.url?.absoluteString ?? "N/A")")
+    segments.forEach { requestRemainder(of: $0) }
+  }
+
+  //----------------------------------------------------------------------------
+  private func requestRemainder(of segment: Segment) {
+    guard !isFinished else {
+      return
+    }
+
+    // Range requests go straight to where the probe was redirected.
+    var rangeRequest = request
+    rangeRequest.url = response?.url ?? request.url
+    rangeRequest = authorizedRequest(rangeRequest)
+    rangeRequest.setValue("bytes=\(segment.nextOffset)-\(segment.end)", forHTTPHeaderField: "Range")
+    rangeRequest.setValue(validator, forHTTPHeaderField: "If-Range")
+
+    segment.attempts += 1
+    segment.task = session?.dataTask(with: rangeRequest)
+    segment.task?.resume()
+  }
+
+  //----------------------------------------------------------------------------
+  /// The `Authorization` header of `request` is only sent to its host. Its
+  /// bearer token belongs to the patron and must not leak to another host,
+  /// such as a CDN, which could besides reject a second authorization
+  /// mechanism when the URL is presigned.
+  private func authorizedRequest(_ newRequest: URLRequest) -> URLRequest {
+    var authorizedRequest = newRequest
+    let authorizationKey = "Authorization"
+    if newRequest.url?.host?.lowercased() == request.url?.host?.lowercased() {
+      authorizedRequest.setValue(request.value(forHTTPHeaderField: authorizationKey),
+                                 forHTTPHeaderField: authorizationKey)
+    } else {
+      authorizedRequest.setValue(nil, forHTTPHeaderField: authorizationKey)
+    }
+    return authorizedRequest
+  }
+
+  //----------------------------------------------------------------------------
+  private func write(_ data: Data, for segment: Segment) {
+    guard let fileHandle = fileHandle else {
+      return
+    }
+
+    let remaining = segment.end - segment.nextOffset + 1
+    let chunk = (Int64(data.count) > remaining) ? data.prefix(Int(remaining)) : data
+    fileHandle.seek(toFileOffset: UInt64(segment.nextOffset))
+    fileHandle.write(chunk)
+    segment.received += Int64(chunk.count)
+
+    let written = segments.reduce(Int64(0)) { $0 + $1.received }
+    progressHandler?(written, expectedLength)
+  }
+
+  //----------------------------------------------------------------------------
+  private func finish(_ outcome: NYPLSegmentedDownloadOutcome, error: Error?) {
+    guard !isFinished else {
+      return
+    }
+    isFinished = true
+    duration = ProcessInfo.processInfo.systemUptime - startTime
+
+    session?.invalidateAndCancel()
+    session = nil
+    fileHandle?.closeFile()
+    fileHandle = nil
+    if outcome != .completed {
+      try? FileManager.default.removeItem(at: destinationURL)
+    }
+
+    let completion = self.completion
+    self.completion = nil
+    completion?(outcome,
+                (outcome == .completed) ? destinationURL : nil,
+                response,
+                error)
+  }
+
+  //----------------------------------------------------------------------------
+  /// Parses a `Content-Range: bytes <start>-<end>/<total>` header. The total
+  /// is nil if unknown.
+  private class func contentRange(of response: HTTPURLResponse) -> (start: Int64, end: Int64, total: Int64?)? {
+    let header = response.allHeaderFields.first {
+      ($0.key as? String)?.lowercased() == "content-range"
+    }
+    guard let value = header?.value as? String, value.hasPrefix("bytes ") else {
+      return nil
+    }
+
+    let parts = value.dropFirst("bytes ".count).split(separator: "/")
+    let bounds = parts.first?.split(separator: "-") ?? []
+    guard parts.count == 2, bounds.count == 2,
+      let start = Int64(bounds[0]),
+      let end = Int64(bounds[1]) else {
+        return nil
+    }
+    return (start, end, Int64(parts[1]))
+  }
+}
+
+extension NYPLSegmentedDownload: URLSessionDataDelegate {
+  //----------------------------------------------------------------------------
+  func urlSession(_ session: URLSession,
+                  task: URLSessionTask,
+                  didReceive challenge: URLAuthenticationChallenge,
+                  completionHandler: @escaping (URLSession.AuthChallengeDisposition, URLCredential?) -> Void) {
+    if let challengeHandler = challengeHandler {
+      challengeHandler(challenge, completionHandler)
+    } else {
+      completionHandler(.performDefaultHandling, nil)
+    }
+  }
+
+  //----------------------------------------------------------------------------
+  func urlSession(_ session: URLSession,
+                  task: URLSessionTask,
+                  willPerformHTTPRedirection response: HTTPURLResponse,
+                  newRequest request: URLRequest,
+                  completionHandler: @escaping (URLRequest?) -> Void) {
+    completionHandler(authorizedRequest(request))
+  }
+
+  //----------------------------------------------------------------------------
+  func urlSession(_ session: URLSession,
+                  dataTask: URLSessionDataTask,
+                  didReceive response: URLResponse,
+                  completionHandler: @escaping (URLSession.ResponseDisposition) -> Void) {
+    guard !isFinished else {
+      completionHandler(.cancel)
+      return
+    }
+
+    if dataTask === probeTask {
+      probeTask = nil
+      completionHandler(.cancel)
+      if acceptProbeResponse(response) {
+        startSegments()
+      } else {
+        finish(.unsupported, error: nil)
+      }
+      return
+    }
+
+    // The server must send exactly the missing part of the same resource,
+    // otherwise the partial file can't be completed.
+    guard let segment = segment(for: dataTask),
+      let httpResponse = response as? HTTPURLResponse,
+      httpResponse.statusCode == 206,
+      let contentRange = NYPLSegmentedDownload.contentRange(of: httpResponse),
+      contentRange.start == segment.nextOffset,
+      contentRange.total == expectedLength else {
+        Log.info(#file, "Server stopped honoring range requests for \(request.url?.absoluteString ?? "N/A")")
+        completionHandler(.cancel)
+        finish(.unsupported, error: nil)
+        return
+    }
+    completionHandler(.allow)
+  }
+
+  //----------------------------------------------------------------------------
+  func urlSession(_ session: URLSession, dataTask: URLSessionDataTask, didReceive data: Data) {
+    guard !isFinished, let segment = segment(for: dataTask) else {
+      return
+    }
+    write(data, for: segment)
+  }
+
+  //----------------------------------------------------------------------------
+  func urlSession(_ session: URLSession, task: URLSessionTask, didCompleteWithError error: Error?) {
+    guard !isFinished else {
+      return
+    }
+
+    if task === probeTask {
+      // The probe failed before a response was received: the single stream
+      // download will report the error as usual.
+      probeTask = nil
+      finish(.unsupported, error: error)
+      return
+    }
+
+    guard let segment = segment(for: task) else {
+      return
+    }
+    segment.task = nil
+
+    if segment.isComplete {
+      if segments.allSatisfy({ $0.isComplete }) {
+        finish(.completed, error: nil)
+      }
+      return
+    }
+
+    guard segment.attempts < NYPLSegmentedDownload.maxAttemptsPerSegment else {
+      Log.error(#file, "Segment \(segment.start)-\(segment.end) failed \(segment.attempts) times: \(String(describing: error))")
+      finish(.failed, error: error ?? NSError(domain: NSURLErrorDomain,
+                                              code: NSURLErrorNetworkConnectionLost))
+      return
+    }
+
+    Log.info(#file, "Retrying segment \(segment.start)-\(segment.end) from offset \(segment.nextOffset)")
+    let delay = DispatchTime.now() + .milliseconds(500 * segment.attempts)
+    DispatchQueue.global(qos: .utility).asyncAfter(deadline: delay) {
+      self.delegateQueue.addOperation {
+        self.requestRemainder(of: segment)
+      }
+    }
+  }
+}
@@ -29,6 +29,11 @@ enum NYPLResult<SuccessInfo> {
   /// The delegate of the URLSession.
   private let responder: NYPLNetworkResponder
 
+  /// The OPDS feeds parsed from responses of this executor, following the
+  /// same caching strategy as the URL cache. Executors with persistent
+  /// caching strategies share the same cache.
+  let parsedFeedCache: NYPLOPDSFeedCache
+
   /// Designated initializer.
   /// - Parameter credentialsSource: The object responsible with providing credentials.
   /// - Parameter cachingStrategy: The strategy to cache responses with.
@@ -49,6 +54,9 @@ enum NYPLResult<SuccessInfo> {
     self.urlSession = URLSession(configuration: config,
                                  delegate: self.responder,
                                  delegateQueue: delegateQueue)
+    self.parsedFeedCache = (cachingStrategy == .ephemeral)
+      ? NYPLOPDSFeedCache(cachingStrategy: .ephemeral, directoryURL: nil)
+      : NYPLOPDSFeedCache.shared
     super.init()
   }
 
@@ -58,6 +66,7 @@ enum NYPLResult<SuccessInfo> {
 
   @objc func clearCache() {
     urlSession.configuration.urlCache?.removeAllCachedResponses()
+    parsedFeedCache.removeAll()
   }
 
   /// A shared generic executor with enabled fallback caching.
@@ -159,17 +168,30 @@ extension NYPLNetworkExecutor: NYPLOAuthTokenFetching {
     }
   }
 
-  /// Resets internal state that's related to a specific library.
+  /// Resets internal state that's related to a specific library, including
+  /// the parsed feeds, which may be specific to the patron.
   ///
   /// - Important: this leaves network cache unaltered.
   func resetLibrarySpecificInfo() {
     responder.oauthTokenRefresher = nil
     NYPLNetworkExecutor.shared.responder.oauthTokenRefresher = nil
+    parsedFeedCache.removeAll()
+    NYPLNetworkExecutor.shared.parsedFeedCache.removeAll()
   }
 }
 
 extension NYPLNetworkExecutor: NYPLRequestExecuting {
 
+  /// Builds a request carrying the authorization headers of the current
+  /// user, see `request(for:cachePolicy:additionalHeaders:httpMethod:httpBody:)`.
+  func request(for url: URL, httpMethod: String, httpBody: Data?) -> URLRequest {
+    return request(for: url,
+                   cachePolicy: nil,
+                   additionalHeaders: nil,
+                   httpMethod: httpMethod,
+                   httpBody: httpBody)
+  }
+
   /// Executes a given request.
   /// - Parameters:
   ///   - req: The request to perform.
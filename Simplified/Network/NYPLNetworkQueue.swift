@@ -16,10 +16,17 @@ extension Connection {
  The NetworkQueue is insantiated once on app startup and listens
  for a valid network notification from a reachability class. It then
  will retry any queued requests and purge them if necessary.
+
+ The queue keeps a single connection to its database for its whole lifetime.
+ Queued requests are retried a few at a time; if connectivity is lost again
+ during a retry pass, the remaining requests are left for a later pass,
+ scheduled with exponential backoff.
  */
 final class NetworkQueue: NSObject {
 
-  @objc static let shared = NetworkQueue()
+  @objc static let shared = NetworkQueue(
+    databasePath: NSSearchPathForDirectoriesInDomains(.applicationSupportDirectory, .userDomainMask, true).first! + "/simplified.db",
+    executor: NYPLNetworkExecutor.shared)
 
   deinit {
     NotificationCenter.default.removeObserver(self)
@@ -36,6 +43,14 @@ final class NetworkQueue: NSObject {
                             NSURLErrorSecureConnectionFailed]
   let MaxRetriesInQueue = 5
 
+  /// The maximum number of queued requests retried at the same time.
+  let MaxConcurrentRetries = 4
+
+  /// Delay before retrying again after connectivity was lost during a retry
+  /// pass. Doubles after each interrupted pass, up to `MaxRetryBackoff`.
+  static let InitialRetryBackoff: TimeInterval = 5
+  static let MaxRetryBackoff: TimeInterval = 300
+
   let serialQueue = DispatchQueue(label: Bundle.main.bundleIdentifier!
                                   + "."
                                   + String(describing: NetworkQueue.self))
@@ -47,11 +62,33 @@ final class NetworkQueue: NSObject {
     case GET, POST, HEAD, PUT, DELETE, OPTIONS, CONNECT
   }
 
-  private var retryRequestCount = 0
-  private let path = NSSearchPathForDirectoriesInDomains(.applicationSupportDirectory, .userDomainMask, true).first!
-  
+  private let databasePath: String
+  private let executor: NYPLRequestExecuting
+
+  // The following state is only accessed on `serialQueue`.
+
+  /// Opened on first use, see `databaseConnection()`.
+  private var db: Connection?
+  /// Prepared statements, keyed by their SQL.
+  private var statements = [String: Statement]()
+
+  private struct QueuedRequest {
+    let id: Int
+    let request: URLRequest
+  }
+
+  /// Requests of the current retry pass that haven't been dispatched yet,
+  /// last one first.
+  private var pendingRetries = [QueuedRequest]()
+  private var retriesInFlight = 0
+  private var failedRetryIDs = [Int]()
+  private var retryPassInterrupted = false
+  private var retryPassCompletion: (() -> Void)?
+  private var retryBackoff = NetworkQueue.InitialRetryBackoff
+  private var scheduledRetry: DispatchWorkItem?
+
   private let sqlTable = Table(NetworkQueue.TableName)
-  
+
   private let sqlID = Expression<Int>("id")
   private let sqlLibraryID = Expression<String>("library_identifier")
   private let sqlUpdateID = Expression<String?>("update_identifier")
@@ -61,8 +98,30 @@ final class NetworkQueue: NSObject {
   private let sqlHeader = Expression<Data?>("request_header")
   private let sqlRetries = Expression<Int>("retry_count")
   private let sqlDateCreated = Expression<Data>("date_created")
-  
-  
+
+  private static let DeleteRowSQL = "DELETE FROM \(TableName) WHERE id = ?"
+  private static let IncrementRetriesSQL = "UPDATE \(TableName) SET retry_count = retry_count + 1 WHERE id = ?"
+
+  /// Deletes the rows superseded by a more recent row: rows updating the
+  /// same item (e.g. the reading position of a book), and PUT requests to the
+  /// same URL.
+  private static let DeleteSupersededRowsSQL = """
+    DELETE FROM \(TableName) WHERE id NOT IN (
+      SELECT MAX(id) FROM \(TableName)
+      GROUP BY library_identifier, request_url, request_method, update_identifier,
+        CASE WHEN update_identifier IS NULL AND request_method <> 'PUT' THEN id END)
+    """
+
+  //----------------------------------------------------------------------------
+  /// - Parameters:
+  ///   - databasePath: The path of the SQLite database storing the queue.
+  ///   - executor: The executor used to retry the queued requests.
+  init(databasePath: String, executor: NYPLRequestExecuting) {
+    self.databasePath = databasePath
+    self.executor = executor
+    super.init()
+  }
+
   // MARK: - Public Functions
 
   @objc func addObserverForOfflineQueue() {
@@ -86,15 +145,28 @@ final class NetworkQueue: NSObject {
       // left for backward compatibility
       let headerData: Data? = nil
 
-      guard let db = self.startDatabaseConnection() else { return }
-      
-      // Update (not insert) if uniqueID and libraryID match existing row in table
-      let query = self.sqlTable.filter(self.sqlLibraryID == libraryID && self.sqlUpdateID == updateID)
-        .filter(self.sqlUpdateID != nil)
-      
+      guard let db = self.databaseConnection() else { return }
+
+      // Update (not insert) if uniqueID and libraryID match existing row in
+      // table. A PUT replaces any queued PUT to the same URL.
+      let query: Table?
+      if updateID != nil {
+        query = self.sqlTable.filter(self.sqlLibraryID == libraryID && self.sqlUpdateID == updateID)
+      } else if method == .PUT {
+        query = self.sqlTable.filter(self.sqlLibraryID == libraryID
+          && self.sqlUpdateID == nil
+          && self.sqlUrl == urlString
+          && self.sqlMethod == methodString)
+      } else {
+        query = nil
+      }
+
       do {
         //Try to update row
-        let result = try db.run(query.update(self.sqlParameters <- parameters, self.sqlHeader <- headerData))
+        var result = 0
+        if let query = query {
+          result = try db.run(query.update(self.sqlParameters <- parameters, self.sqlHeader <- headerData))
+        }
         if result > 0 {
           Log.debug(#file, "SQLite: Row Updated")
         } else {
@@ -118,11 +190,11 @@ final class NetworkQueue: NSObject {
   func migrateOrSetUpIfNeeded()
   {
     self.serialQueue.async {
-      guard let db = self.startDatabaseConnection() else {
+      guard let db = self.databaseConnection() else {
         Log.error(#file, "Failed to start database connection for a retry attempt.")
         return
       }
-      
+
       let tableCount = Int(try! db.scalar("SELECT count(*) FROM sqlite_master WHERE type = 'table' AND name = '\(NetworkQueue.TableName)'") as! Int64)
       if tableCount < 1 {
         self.createTable(db: db)
@@ -137,6 +209,7 @@ final class NetworkQueue: NSObject {
           while dbVersion < NetworkQueue.DBVersion { // Iterate
             switch dbVersion {
             case 0:
+              self.statements.removeAll()
               try db.run(self.sqlTable.drop(ifExists: true))
               self.createTable(db: db)
               dbVersion = NetworkQueue.DBVersion
@@ -153,6 +226,17 @@ final class NetworkQueue: NSObject {
     }
   }
 
+  /// Retries all the queued requests, unless a retry pass is already in
+  /// progress.
+  /// - Parameter completion: Called on `serialQueue` when the retry pass
+  /// is over, or right away if it couldn't start.
+  func retryQueue(completion: (() -> Void)? = nil)
+  {
+    self.serialQueue.async {
+      self.startRetryPass(completion: completion)
+    }
+  }
+
   // MARK: - Private Functions
 
   private func createTable(db: Connection)
@@ -174,62 +258,89 @@ final class NetworkQueue: NSObject {
     }
   }
 
-  private func retryQueue()
+  private func startRetryPass(completion: (() -> Void)?)
   {
-    self.serialQueue.async {
-
-      if self.retryRequestCount > 0 {
-        Log.debug(#file, "Retry requests are still in progress. Cancelling this attempt.")
-        return
-      }
+    if retriesInFlight > 0 || !pendingRetries.isEmpty {
+      Log.debug(#file, "Retry requests are still in progress. Cancelling this attempt.")
+      completion?()
+      return
+    }
 
-      guard let db = self.startDatabaseConnection() else {
-        Log.error(#file, "Failed to start database connection for a retry attempt.")
-        return
-      }
+    scheduledRetry?.cancel()
+    scheduledRetry = nil
 
-      let expiredRows = self.sqlTable.filter(self.sqlRetries > self.MaxRetriesInQueue)
-      do {
-        try db.run(expiredRows.delete())
+    guard let db = databaseConnection() else {
+      Log.error(#file, "Failed to start database connection for a retry attempt.")
+      completion?()
+      return
+    }
 
-        self.retryRequestCount = try db.scalar(self.sqlTable.count)
-        Log.debug(#file, "Executing \"retry\" with \(self.retryRequestCount) row(s) in the table.")
+    var queuedRequests = [QueuedRequest]()
+    do {
+      try db.transaction {
+        try db.run(self.sqlTable.filter(self.sqlRetries > self.MaxRetriesInQueue).delete())
+        try db.execute(NetworkQueue.DeleteSupersededRowsSQL)
+      }
 
-        for row in try db.prepare(self.sqlTable) {
-          Log.debug(#file, "Retrying row: \(row[self.sqlID])")
-          self.retry(db, requestRow: row)
+      for row in try db.prepare(sqlTable.order(sqlID)) {
+        guard let url = URL(string: row[sqlUrl]) else {
+          deleteRow(row[sqlID], db: db)
+          continue
         }
-      } catch {
-        Log.error(#file, "SQLite Error: Failure to prepare table or run deletion")
+        let urlRequest = executor.request(for: url,
+                                          httpMethod: row[sqlMethod],
+                                          httpBody: row[sqlParameters])
+        queuedRequests.append(QueuedRequest(id: row[sqlID], request: urlRequest))
       }
+    } catch {
+      Log.error(#file, "SQLite Error: Failure to prepare table or run deletion: \(error)")
     }
+
+    Log.debug(#file, "Executing \"retry\" with \(queuedRequests.count) row(s) in the table.")
+
+    pendingRetries = queuedRequests.reversed()
+    failedRetryIDs = []
+    retryPassInterrupted = false
+    retryPassCompletion = completion
+    dispatchRetries()
   }
 
-  private func retry(_ db: Connection, requestRow: Row)
+  /// Starts retrying pending requests until `MaxConcurrentRetries` are in
+  /// flight, or ends the retry pass if there's nothing left to do.
+  private func dispatchRetries()
   {
-    do {
-      let ID = Int(requestRow[sqlID])
-      let newValue = Int(requestRow[sqlRetries]) + 1
-      try db.run(sqlTable.filter(sqlID == ID).update(sqlRetries <- newValue))
-    } catch {
-      Log.error(#file, "SQLite Error incrementing retry count")
+    while retriesInFlight < MaxConcurrentRetries && !retryPassInterrupted,
+      let queuedRequest = pendingRetries.popLast() {
+        retriesInFlight += 1
+        retry(queuedRequest)
     }
-    
-    // Re-attempt network request
-    let urlRequest = NYPLNetworkExecutor.shared
-      .request(for: URL(string: requestRow[sqlUrl])!,
-               httpMethod: requestRow[sqlMethod],
-               httpBody: requestRow[sqlParameters])
 
+    if retriesInFlight == 0 && (pendingRetries.isEmpty || retryPassInterrupted) {
+      finishRetryPass()
+    }
+  }
+
+  private func retry(_ queuedRequest: QueuedRequest)
+  {
+    let urlRequest = queuedRequest.request
     Log.info(#file, "Retrying request from offline queue: \(urlRequest)")
-    NYPLNetworkExecutor.shared.executeRequest(urlRequest) { result in
+    executor.executeRequest(urlRequest) { result in
       self.serialQueue.async { [weak self] in
         guard let self = self else { return }
         switch result {
         case .success(_, _):
           Log.info(#file, "Queued Request Upload: Success")
-          self.deleteRow(db, id: requestRow[self.sqlID])
+          if let db = self.databaseConnection() {
+            self.deleteRow(queuedRequest.id, db: db)
+          }
         case .failure(let error, let response):
+          // Losing connectivity says nothing about the request itself, so
+          // it doesn't count against its retries.
+          if NetworkQueue.StatusCodes.contains((error as NSError).code) {
+            self.retryPassInterrupted = true
+          } else {
+            self.failedRetryIDs.append(queuedRequest.id)
+          }
           NYPLErrorLogger.logNetworkError(error,
                                           code: .responseFail,
                                           summary: "Error retrying request from offline queue",
@@ -237,30 +348,97 @@ final class NetworkQueue: NSObject {
                                           response: response)
         }
 
-        self.retryRequestCount -= 1
+        self.retriesInFlight -= 1
+        self.dispatchRetries()
       }
     }
   }
 
-  private func deleteRow(_ db: Connection, id: Int)
+  private func finishRetryPass()
   {
-    let rowToDelete = sqlTable.filter(sqlID == id)
-    if let _ = try? db.run(rowToDelete.delete()) {
-      Log.info(#file, "SQLite: deleted row from queue")
+    incrementRetryCount(ofRows: failedRetryIDs)
+    failedRetryIDs = []
+
+    if retryPassInterrupted {
+      Log.info(#file, "Lost connectivity while retrying the offline queue; \(pendingRetries.count) request(s) left for a retry in \(retryBackoff)s.")
+      pendingRetries = []
+      let retryWorkItem = DispatchWorkItem { [weak self] in
+        self?.startRetryPass(completion: nil)
+      }
+      scheduledRetry = retryWorkItem
+      serialQueue.asyncAfter(deadline: .now() + retryBackoff, execute: retryWorkItem)
+      retryBackoff = min(retryBackoff * 2, NetworkQueue.MaxRetryBackoff)
     } else {
+      retryBackoff = NetworkQueue.InitialRetryBackoff
+    }
+
+    let completion = retryPassCompletion
+    retryPassCompletion = nil
+    completion?()
+  }
+
+  private func incrementRetryCount(ofRows ids: [Int])
+  {
+    guard !ids.isEmpty, let db = databaseConnection() else {
+      return
+    }
+
+    do {
+      let statement = try preparedStatement(NetworkQueue.IncrementRetriesSQL, db: db)
+      try db.transaction {
+        for id in ids {
+          try statement.run(Int64(id))
+        }
+      }
+    } catch {
+      Log.error(#file, "SQLite Error incrementing retry count: \(error)")
+    }
+  }
+
+  private func deleteRow(_ id: Int, db: Connection)
+  {
+    do {
+      try preparedStatement(NetworkQueue.DeleteRowSQL, db: db).run(Int64(id))
+      Log.info(#file, "SQLite: deleted row from queue")
+    } catch {
       Log.error(#file, "SQLite Error: Could not delete row")
     }
   }
-  
-  private func startDatabaseConnection() -> Connection?
+
+  private func preparedStatement(_ sql: String, db: Connection) throws -> Statement
+  {
+    if let statement = statements[sql] {
+      return statement
+    }
+    let statement = try db.prepare(sql)
+    statements[sql] = statement
+    return statement
+  }
+
+  /// Opens the database connection the first time it's needed, in WAL mode
+  /// so that writing to the queue doesn't block reading from it.
+  private func databaseConnection() -> Connection?
   {
-    let db: Connection
+    if let db = db {
+      return db
+    }
+
     do {
-      db = try Connection("\(path)/simplified.db")
+      let connection = try Connection(databasePath)
+      connection.busyTimeout = 5
+      try connection.execute("PRAGMA journal_mode = WAL")
+      db = connection
     } catch {
       Log.error(#file, "SQLite: Could not start DB connection.")
-      return nil
     }
     return db
   }
 }
+
+extension NetworkQueue {
+  func test_queuedRequestCount() -> Int {
+    return serialQueue.sync {
+      (try? databaseConnection()?.scalar(sqlTable.count)) ?? 0
+    }
+  }
+}
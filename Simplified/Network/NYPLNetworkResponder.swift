@@ -8,29 +8,92 @@
 
 import Foundation
 
-fileprivate struct NYPLNetworkTaskInfo {
-  var progressData: Data
-  var startDate: Date
-  var completion: ((NYPLResult<Data>) -> Void)
+/// Accumulates the body of a response as a list of the chunks received from
+/// URLSession, joining them only once when the body is read. This way each
+/// byte is copied at most once regardless of how many chunks the body arrives
+/// in, while appending the whole body to a single `Data` on every chunk
+/// may cause the bytes received so far to be copied over and over.
+struct NYPLResponseBodyBuffer {
+  private var chunks = [Data]()
+
+  /// The number of bytes received so far.
+  private(set) var count = 0
+
+  /// The number of bytes copied to assemble the body. Useful to verify that
+  /// accumulating a response stays linear in its size.
+  private(set) var copiedByteCount = 0
+
+  //----------------------------------------------------------------------------
+  mutating func append(_ chunk: Data) {
+    guard !chunk.isEmpty else {
+      return
+    }
+    chunks.append(chunk)
+    count += chunk.count
+  }
+
+  //----------------------------------------------------------------------------
+  /// Joins the chunks received so far into a single `Data`. The result
+  /// replaces the chunks, so reading the body again does not copy anything.
+  mutating func data() -> Data {
+    if chunks.count <= 1 {
+      return chunks.first ?? Data()
+    }
+
+    var joined = Data(capacity: count)
+    for chunk in chunks {
+      joined.append(chunk)
+    }
+    copiedByteCount += count
+    chunks = [joined]
+    return joined
+  }
+}
+
+/// A reference type so that appending to `body` mutates the buffer in place
+/// instead of a copy taken out of (and written back to) a dictionary.
+fileprivate final class NYPLNetworkTaskInfo {
+  var body: NYPLResponseBodyBuffer
+  let startDate: Date
+  let completion: ((NYPLResult<Data>) -> Void)
 
   //----------------------------------------------------------------------------
   init(completion: (@escaping (NYPLResult<Data>) -> Void)) {
-    self.progressData = Data()
+    self.body = NYPLResponseBodyBuffer()
     self.startDate = Date()
     self.completion = completion
   }
 }
 
+/// A portion of the task info table, with its own lock. Tasks are spread
+/// across several shards so that chunks received for different tasks don't
+/// all contend for the same lock.
+fileprivate final class NYPLNetworkTaskInfoShard {
+  private var taskInfo = [NYPLNetworkResponder.TaskID: NYPLNetworkTaskInfo]()
+  private let lock = NSLock()
+
+  //----------------------------------------------------------------------------
+  func withLock<T>(_ body: (inout [NYPLNetworkResponder.TaskID: NYPLNetworkTaskInfo]) -> T) -> T {
+    lock.lock()
+    defer {
+      lock.unlock()
+    }
+    return body(&taskInfo)
+  }
+}
+
 /// This class responds to URLSession events related to the tasks being
 /// issued on the URLSession, keeping a tally of the related completion
 /// handlers in a thread-safe way.
 class NYPLNetworkResponder: NSObject {
   typealias TaskID = Int
 
-  private var taskInfo: [TaskID: NYPLNetworkTaskInfo]
+  /// Number of shards the task info table is split into.
+  private static let shardCount = 8
 
-  /// Protects access to `taskInfo` to ensure thread-safety.
-  private let taskInfoLock: NSRecursiveLock
+  /// The info of the tasks in flight, sharded by task identifier. Each shard
+  /// protects its own portion of the table to ensure thread-safety.
+  private let taskInfoShards: [NYPLNetworkTaskInfoShard]
 
   /// Whether the fallback caching system should be active or not.
   private let useFallbackCaching: Bool
@@ -49,8 +112,9 @@ class NYPLNetworkResponder: NSObject {
   /// to respond to an authentication challenge.
   init(credentialsSource: NYPLBasicAuthCredentialsProvider & NYPLOAuthTokenSource,
        useFallbackCaching: Bool = false) {
-    self.taskInfo = [Int: NYPLNetworkTaskInfo]()
-    self.taskInfoLock = NSRecursiveLock()
+    self.taskInfoShards = (0..<NYPLNetworkResponder.shardCount).map { _ in
+      NYPLNetworkTaskInfoShard()
+    }
     self.useFallbackCaching = useFallbackCaching
     self.credentialsSource = credentialsSource
     super.init()
@@ -59,12 +123,14 @@ class NYPLNetworkResponder: NSObject {
   //----------------------------------------------------------------------------
   func addCompletion(_ completion: @escaping (NYPLResult<Data>) -> Void,
                      taskID: TaskID) {
-    taskInfoLock.lock()
-    defer {
-      taskInfoLock.unlock()
-    }
+    let info = NYPLNetworkTaskInfo(completion: completion)
+    shard(for: taskID).withLock { $0[taskID] = info }
+  }
 
-    taskInfo[taskID] = NYPLNetworkTaskInfo(completion: completion)
+  //----------------------------------------------------------------------------
+  private func shard(for taskID: TaskID) -> NYPLNetworkTaskInfoShard {
+    let index = Int(UInt(bitPattern: taskID) % UInt(taskInfoShards.count))
+    return taskInfoShards[index]
   }
 }
 
@@ -76,12 +142,9 @@ extension NYPLNetworkResponder: URLSessionDelegate {
       NYPLErrorLogger.logError(err, summary: "URLSession became invalid")
     }
 
-    taskInfoLock.lock()
-    defer {
-      taskInfoLock.unlock()
+    for shard in taskInfoShards {
+      shard.withLock { $0.removeAll() }
     }
-
-    taskInfo.removeAll()
   }
 }
 
@@ -92,14 +155,12 @@ extension NYPLNetworkResponder: URLSessionDataDelegate {
   func urlSession(_ session: URLSession,
                   dataTask: URLSessionDataTask,
                   didReceive data: Data) {
-    taskInfoLock.lock()
-    defer {
-      taskInfoLock.unlock()
-    }
+    let taskID = dataTask.taskIdentifier
+    let currentTaskInfo = shard(for: taskID).withLock { $0[taskID] }
 
-    var currentTaskInfo = taskInfo[dataTask.taskIdentifier]
-    currentTaskInfo?.progressData.append(data)
-    taskInfo[dataTask.taskIdentifier] = currentTaskInfo
+    // The session's delegate queue is serial, so the callbacks of a task never
+    // overlap and its buffer can be appended to without holding the lock.
+    currentTaskInfo?.body.append(data)
   }
 
   //----------------------------------------------------------------------------
@@ -132,9 +193,10 @@ extension NYPLNetworkResponder: URLSessionDataDelegate {
       "taskID": taskID,
     ]
 
-    taskInfoLock.lock()
-    guard let currentTaskInfo = taskInfo.removeValue(forKey: taskID) else {
-      taskInfoLock.unlock()
+    let removedTaskInfo = shard(for: taskID).withLock {
+      $0.removeValue(forKey: taskID)
+    }
+    guard let currentTaskInfo = removedTaskInfo else {
       logMetadata["NYPLNetworkResponder context"] = "No task info available for task \(taskID). Completion closure could not be called."
       NYPLErrorLogger.logNetworkError(
         networkError,
@@ -145,9 +207,8 @@ extension NYPLNetworkResponder: URLSessionDataDelegate {
         metadata: logMetadata)
       return
     }
-    taskInfoLock.unlock()
 
-    let responseData = currentTaskInfo.progressData
+    let responseData = currentTaskInfo.body.data()
     let elapsed = Date().timeIntervalSince(currentTaskInfo.startDate)
     logMetadata["elapsedTime"] = elapsed
     Log.info(#file, "Task \(taskID) completed, elapsed time: \(elapsed) sec")
@@ -189,7 +250,12 @@ extension NYPLNetworkResponder: URLSessionDataDelegate {
 
     // no problem document nor error, but response could still be a failure
     if let httpResponse = task.response as? HTTPURLResponse {
-      guard httpResponse.isSuccess() else {
+      // URLSession resolves a 304 into the cached response when it revalidates
+      // on its own, so a 304 only gets here for conditional requests whose
+      // validators were set by the caller, which expects it.
+      let isExpectedNotModified = httpResponse.statusCode == 304
+        && task.originalRequest?.isConditional == true
+      guard httpResponse.isSuccess() || isExpectedNotModified else {
         if let responseContent = String(data: responseData, encoding: .utf8) {
           logMetadata[NSError.httpResponseContentKey] = responseContent
         }
@@ -293,6 +359,18 @@ extension URLSessionTask {
   }
 }
 
+//------------------------------------------------------------------------------
+// MARK: - URLRequest extensions
+
+extension URLRequest {
+  /// Whether the request carries validators of its own, so that the caller
+  /// expects a `304 Not Modified` response.
+  var isConditional: Bool {
+    return value(forHTTPHeaderField: "If-None-Match") != nil
+      || value(forHTTPHeaderField: "If-Modified-Since") != nil
+  }
+}
+
 //----------------------------------------------------------------------------
 // MARK: - URLSessionTaskDelegate
 extension NYPLNetworkResponder: URLSessionTaskDelegate {
@@ -0,0 +1,238 @@
+//
+//  NYPLOPDSFeedCache.swift
+//  Simplified
+//
+//  Copyright © 2026 NYPL. All rights reserved.
+//
+
+import UIKit
+import CommonCrypto
+
+/// Keeps OPDS feeds that were already parsed, so that a feed whose data did
+/// not change since the last time it was fetched doesn't need to be parsed
+/// again.
+///
+/// URLCache only saves the network roundtrip: the executor still hands the
+/// whole XML over to be parsed. This cache sits next to it and maps a feed URL
+/// plus a digest of the response body to the parsed feed, which is much
+/// cheaper than parsing. Response validators are not used: `Last-Modified`
+/// only has a one second resolution, and the feeds of different patrons may
+/// share validators. Since feeds may be specific to a patron, the cache is
+/// emptied on sign out and when the current account changes.
+///
+/// Feeds are kept in a cost-bounded LRU cache in memory and, unless the
+/// caching strategy is `ephemeral`, in a size-bounded directory in Caches as
+/// binary property lists of their `dictionaryRepresentation`. The oldest
+/// files are removed first when the directory exceeds its limit. This class
+/// is thread-safe.
+final class NYPLOPDSFeedCache {
+
+  static let defaultMemoryCostLimit = 8 * 1024 * 1024
+  static let defaultDiskByteLimit = 30 * 1024 * 1024
+
+  /// The cache of all the executors with persistent caching strategies.
+  /// There is a single instance for its directory, so that the files are
+  /// only ever written, trimmed and removed on one queue.
+  static let shared = NYPLOPDSFeedCache(
+    cachingStrategy: .default,
+    directoryURL: FileManager.default
+      .urls(for: .cachesDirectory, in: .userDomainMask).first?
+      .appendingPathComponent("NYPLOPDSFeedCache", isDirectory: true))
+
+  private let memoryCache: NYPLLRUCache<String, NYPLOPDSFeed>
+  private let directoryURL: URL?
+  private let diskByteLimit: Int
+  private let diskQueue = DispatchQueue(label: "org.nypl.labs.SimplyE.NYPLOPDSFeedCache.diskQueue",
+                                        qos: .utility)
+  private var memoryWarningObserver: NSObjectProtocol?
+
+  //----------------------------------------------------------------------------
+  /// - Parameters:
+  ///   - cachingStrategy: Feeds are only kept in memory for `ephemeral`.
+  ///   - directoryURL: Where feeds are persisted for the other strategies.
+  ///   No other cache may use the same directory.
+  ///   - memoryCostLimit: The maximum number of bytes of feed data whose
+  ///   parsed feeds are kept in memory.
+  ///   - diskByteLimit: The maximum size of the files in `directoryURL`.
+  init(cachingStrategy: NYPLCachingStrategy,
+       directoryURL: URL?,
+       memoryCostLimit: Int = NYPLOPDSFeedCache.defaultMemoryCostLimit,
+       diskByteLimit: Int = NYPLOPDSFeedCache.defaultDiskByteLimit) {
+    self.memoryCache = NYPLLRUCache(costLimit: memoryCostLimit)
+    self.directoryURL = (cachingStrategy == .ephemeral) ? nil : directoryURL
+    self.diskByteLimit = diskByteLimit
+    self.memoryWarningObserver = NotificationCenter.default.addObserver(
+      forName: UIApplication.didReceiveMemoryWarningNotification,
+      object: nil,
+      queue: nil) { [weak self] _ in
+        self?.memoryCache.removeAll()
+    }
+  }
+
+  deinit {
+    if let observer = memoryWarningObserver {
+      NotificationCenter.default.removeObserver(observer)
+    }
+  }
+
+  var hitCount: Int {
+    return memoryCache.hitCount
+  }
+
+  var missCount: Int {
+    return memoryCache.missCount
+  }
+
+  //----------------------------------------------------------------------------
+  /// - Returns: The key identifying the feed that `data` would parse into.
+  class func key(for url: URL, data: Data) -> String {
+    return "\(url.absoluteString) sha256:\(digest(of: data))"
+  }
+
+  //----------------------------------------------------------------------------
+  /// Looks up the feed in memory first, then on disk.
+  ///
+  /// - Note: Reading from disk happens on the calling thread.
+  func feed(forKey key: String) -> NYPLOPDSFeed? {
+    if let feed = memoryCache.value(forKey: key) {
+      return feed
+    }
+
+    guard let fileURL = fileURL(forKey: key),
+      let data = try? Data(contentsOf: fileURL),
+      let dictionary = try? PropertyListSerialization.propertyList(from: data,
+                                                                   format: nil) as? [String: Any],
+      let feed = NYPLOPDSFeed(dictionary: dictionary) else {
+        return nil
+    }
+
+    memoryCache.setValue(feed, forKey: key, cost: data.count)
+    diskQueue.async {
+      // keep the file from being the next one evicted
+      try? FileManager.default.setAttributes([.modificationDate: Date()],
+                                             ofItemAtPath: fileURL.path)
+    }
+    return feed
+  }
+
+  //----------------------------------------------------------------------------
+  /// Caches `feed`. Writing to disk happens in the background.
+  ///
+  /// - Parameter cost: The size of the data the feed was parsed from.
+  func setFeed(_ feed: NYPLOPDSFeed, forKey key: String, cost: Int) {
+    memoryCache.setValue(feed, forKey: key, cost: cost)
+
+    guard let fileURL = fileURL(forKey: key) else {
+      return
+    }
+
+    diskQueue.async {
+      let representation: [AnyHashable: Any] = feed.dictionaryRepresentation()
+      let plist = NYPLOPDSFeedCache.removingNulls(from: representation)
+      do {
+        let data = try PropertyListSerialization.data(fromPropertyList: plist,
+                                                      format: .binary,
+                                                      options: 0)
+        try FileManager.default.createDirectory(at: fileURL.deletingLastPathComponent(),
+                                                withIntermediateDirectories: true)
+        try data.write(to: fileURL, options: .atomic)
+      } catch {
+        Log.error(#file, "Unable to persist parsed feed: \(error)")
+        return
+      }
+      self.trimDirectory()
+    }
+  }
+
+  //----------------------------------------------------------------------------
+  func removeAll() {
+    memoryCache.removeAll()
+
+    guard let directoryURL = directoryURL else {
+      return
+    }
+    diskQueue.async {
+      try? FileManager.default.removeItem(at: directoryURL)
+    }
+  }
+
+  // MARK: - Private
+
+  //----------------------------------------------------------------------------
+  private func fileURL(forKey key: String) -> URL? {
+    return directoryURL?.appendingPathComponent(
+      NYPLOPDSFeedCache.digest(of: Data(key.utf8)) + ".plist")
+  }
+
+  //----------------------------------------------------------------------------
+  /// Removes the least recently used files until the directory fits within
+  /// `diskByteLimit`. Must be called on `diskQueue`.
+  private func trimDirectory() {
+    guard let directoryURL = directoryURL else {
+      return
+    }
+
+    let keys: [URLResourceKey] = [.fileSizeKey, .contentModificationDateKey]
+    guard let urls = try? FileManager.default.contentsOfDirectory(
+      at: directoryURL,
+      includingPropertiesForKeys: keys) else {
+        return
+    }
+
+    var files = urls.compactMap { url -> (url: URL, size: Int, date: Date)? in
+      guard let values = try? url.resourceValues(forKeys: Set(keys)) else {
+        return nil
+      }
+      return (url, values.fileSize ?? 0, values.contentModificationDate ?? .distantPast)
+    }
+
+    var totalSize = files.reduce(0) { $0 + $1.size }
+    guard totalSize > diskByteLimit else {
+      return
+    }
+
+    files.sort { $0.date < $1.date }
+    for file in files where totalSize > diskByteLimit {
+      try? FileManager.default.removeItem(at: file.url)
+      totalSize -= file.size
+    }
+  }
+
+  //----------------------------------------------------------------------------
+  /// Availability dates are serialized as `NSNull` when missing, which
+  /// property lists can't hold. Missing values are read back as nil anyway.
+  private class func removingNulls(from object: Any) -> Any {
+    if let dictionary = object as? NSDictionary {
+      let result = NSMutableDictionary(capacity: dictionary.count)
+      for (key, value) in dictionary where !(value is NSNull) {
+        result[key] = removingNulls(from: value)
+      }
+      return result
+    }
+    if let array = object as? NSArray {
+      return array.compactMap { $0 is NSNull ? nil : removingNulls(from: $0) }
+    }
+    return object
+  }
+
+  //----------------------------------------------------------------------------
+  private class func digest(of data: Data) -> String {
+    var digest = [UInt8](repeating: 0, count: Int(CC_SHA256_DIGEST_LENGTH))
+    data.withUnsafeBytes {
+      _ = CC_SHA256($0.baseAddress, CC_LONG(data.count), &digest)
+    }
+    return digest.map { String(format: "%02hhx", $0) }.joined()
+  }
+}
+
+extension NYPLOPDSFeedCache {
+  //----------------------------------------------------------------------------
+  func test_waitForDiskQueue() {
+    diskQueue.sync {}
+  }
+
+  //----------------------------------------------------------------------------
+  func test_removeAllFromMemory() {
+    memoryCache.removeAll()
+  }
+}
@@ -22,12 +22,27 @@ protocol NYPLRequestExecuting {
   func executeRequest(_ req: URLRequest,
                       completion: @escaping (_: NYPLResult<Data>) -> Void) -> URLSessionDataTask
 
+  /// Builds a request to be passed to `executeRequest(_:completion:)`.
+  /// - Parameters:
+  ///   - url: The URL of the request.
+  ///   - httpMethod: The HTTP method of the request.
+  ///   - httpBody: The body of the request, if any.
+  /// - Returns: A request carrying whatever credentials the executor uses.
+  func request(for url: URL, httpMethod: String, httpBody: Data?) -> URLRequest
+
   var requestTimeout: TimeInterval {get}
 
   static var defaultRequestTimeout: TimeInterval {get}
 }
 
 extension NYPLRequestExecuting {
+  func request(for url: URL, httpMethod: String, httpBody: Data?) -> URLRequest {
+    var request = URLRequest(url: url)
+    request.httpMethod = httpMethod
+    request.httpBody = httpBody
+    return request
+  }
+
   var requestTimeout: TimeInterval {
     return Self.defaultRequestTimeout
   }
@@ -6,6 +6,7 @@
 #import "NYPLOPDSEntry.h"
 #import "NYPLOPDSEntryGroupAttributes.h"
 #import "NYPLOPDSFeed.h"
+#import "NYPLOPDSFeedParser.h"
 #import "NYPLOPDSIndirectAcquisition.h"
 #import "NYPLOPDSLink.h"
 #import "NYPLOPDSRelation.h"
@@ -245,9 +245,11 @@ NYPLOPDSAcquisitionAvailabilityDictionaryRepresentation(id<NYPLOPDSAcquisitionAv
        sinceKey: NYPLNullFromNil([reserved.since rfc3339String]),
        untilKey: NYPLNullFromNil([reserved.until rfc3339String])
      };
-   } ready:^(__unused NYPLOPDSAcquisitionAvailabilityReady * _Nonnull ready) {
+   } ready:^(NYPLOPDSAcquisitionAvailabilityReady * _Nonnull ready) {
      result = @{
-       caseKey: readyCase
+       caseKey: readyCase,
+       sinceKey: NYPLNullFromNil([ready.since rfc3339String]),
+       untilKey: NYPLNullFromNil([ready.until rfc3339String])
      };
    }];
 
@@ -33,4 +33,12 @@
 // designated initializer
 - (instancetype)initWithXML:(NYPLXML *)entryXML;
 
+/// @param dictionary A dictionary created with @c dictionaryRepresentation.
+/// @return An entry, or @c nil if the dictionary is missing required values.
+- (instancetype)initWithDictionary:(NSDictionary *)dictionary;
+
+/// @return A serialized form of the entry made only of property list types,
+/// except for the @c NSNull values of acquisition availability dates.
+- (NSDictionary *)dictionaryRepresentation;
+
 @end
@@ -33,6 +33,60 @@
 
 @end
 
+static NSString *const acquisitionsKey = @"acquisitions";
+static NSString *const alternateKey = @"alternate";
+static NSString *const alternativeHeadlineKey = @"alternativeHeadline";
+static NSString *const annotationsKey = @"annotations";
+static NSString *const authorLinksKey = @"authorLinks";
+static NSString *const authorStringsKey = @"authorStrings";
+static NSString *const categoriesKey = @"categories";
+static NSString *const categoryLabelKey = @"label";
+static NSString *const categorySchemeKey = @"scheme";
+static NSString *const categoryTermKey = @"term";
+static NSString *const identifierKey = @"identifier";
+static NSString *const linksKey = @"links";
+static NSString *const providerNameKey = @"providerName";
+static NSString *const publishedKey = @"published";
+static NSString *const publisherKey = @"publisher";
+static NSString *const relatedWorksKey = @"relatedWorks";
+static NSString *const seriesLinkKey = @"seriesLink";
+static NSString *const summaryKey = @"summary";
+static NSString *const titleKey = @"title";
+static NSString *const updatedKey = @"updated";
+
+static NSArray *LinksWithDictionaries(NSArray *const dictionaries)
+{
+  if(![dictionaries isKindOfClass:[NSArray class]]) {
+    return @[];
+  }
+
+  NSMutableArray *const links = [NSMutableArray arrayWithCapacity:dictionaries.count];
+  for(NSDictionary *const dictionary in dictionaries) {
+    NYPLOPDSLink *const link = [[NYPLOPDSLink alloc] initWithDictionary:dictionary];
+    if(link) {
+      [links addObject:link];
+    }
+  }
+  return links;
+}
+
+static NSArray *DictionariesWithLinks(NSArray<NYPLOPDSLink *> *const links)
+{
+  NSMutableArray *const dictionaries = [NSMutableArray arrayWithCapacity:links.count];
+  for(NYPLOPDSLink *const link in links) {
+    [dictionaries addObject:link.dictionaryRepresentation];
+  }
+  return dictionaries;
+}
+
+static NYPLOPDSLink *LinkWithDictionary(NSDictionary *const dictionary)
+{
+  if(![dictionary isKindOfClass:[NSDictionary class]]) {
+    return nil;
+  }
+  return [[NYPLOPDSLink alloc] initWithDictionary:dictionary];
+}
+
 @implementation NYPLOPDSEntry
 
 - (instancetype)initWithXML:(NYPLXML *const)entryXML
@@ -179,6 +233,108 @@
   
   return self;
 }
+
+- (instancetype)initWithDictionary:(NSDictionary *const)dictionary
+{
+  self = [super init];
+  if(!self) return nil;
+
+  self.identifier = dictionary[identifierKey];
+  self.title = dictionary[titleKey];
+  self.updated = dictionary[updatedKey];
+  if(![self.identifier isKindOfClass:[NSString class]]
+     || ![self.title isKindOfClass:[NSString class]]
+     || ![self.updated isKindOfClass:[NSDate class]]) {
+    NYPLLOG(@"Missing required entry values.");
+    return nil;
+  }
+
+  {
+    NSMutableArray<NYPLOPDSAcquisition *> *const acquisitions = [NSMutableArray array];
+    for(NSDictionary *const acquisitionDictionary in dictionary[acquisitionsKey]) {
+      NYPLOPDSAcquisition *const acquisition =
+        [NYPLOPDSAcquisition acquisitionWithDictionary:acquisitionDictionary];
+      if(!acquisition) {
+        NYPLLOG(@"Ignoring invalid acquisition.");
+        continue;
+      }
+      [acquisitions addObject:acquisition];
+    }
+    self.acquisitions = [acquisitions copy];
+  }
+
+  {
+    NSMutableArray<NYPLOPDSCategory *> *const categories = [NSMutableArray array];
+    for(NSDictionary *const categoryDictionary in dictionary[categoriesKey]) {
+      NSString *const term = categoryDictionary[categoryTermKey];
+      if(!term) {
+        continue;
+      }
+      NSString *const schemeString = categoryDictionary[categorySchemeKey];
+      [categories addObject:[NYPLOPDSCategory
+                             categoryWithTerm:term
+                             label:categoryDictionary[categoryLabelKey]
+                             scheme:schemeString ? [NSURL URLWithString:schemeString] : nil]];
+    }
+    self.categories = [categories copy];
+  }
+
+  self.alternativeHeadline = dictionary[alternativeHeadlineKey];
+  self.authorStrings = dictionary[authorStringsKey] ?: @[];
+  self.authorLinks = LinksWithDictionaries(dictionary[authorLinksKey]);
+  self.links = LinksWithDictionaries(dictionary[linksKey]);
+  self.annotations = LinkWithDictionary(dictionary[annotationsKey]);
+  self.alternate = LinkWithDictionary(dictionary[alternateKey]);
+  if(self.alternate) {
+    self.analytics = [NSURL URLWithString:[self.alternate.href.absoluteString stringByReplacingOccurrencesOfString:@"/works/" withString:@"/analytics/"]];
+  }
+  self.relatedWorks = LinkWithDictionary(dictionary[relatedWorksKey]);
+  self.seriesLink = LinkWithDictionary(dictionary[seriesLinkKey]);
+  self.providerName = dictionary[providerNameKey];
+  self.published = dictionary[publishedKey];
+  self.publisher = dictionary[publisherKey];
+  self.summary = dictionary[summaryKey];
+
+  return self;
+}
+
+- (NSDictionary *)dictionaryRepresentation
+{
+  NSMutableArray *const acquisitions = [NSMutableArray arrayWithCapacity:self.acquisitions.count];
+  for(NYPLOPDSAcquisition *const acquisition in self.acquisitions) {
+    [acquisitions addObject:acquisition.dictionaryRepresentation];
+  }
+
+  NSMutableArray *const categories = [NSMutableArray arrayWithCapacity:self.categories.count];
+  for(NYPLOPDSCategory *const category in self.categories) {
+    NSMutableDictionary *const categoryDictionary = [NSMutableDictionary dictionary];
+    categoryDictionary[categoryTermKey] = category.term;
+    categoryDictionary[categoryLabelKey] = category.label;
+    categoryDictionary[categorySchemeKey] = category.scheme.absoluteString;
+    [categories addObject:categoryDictionary];
+  }
+
+  NSMutableDictionary *const dictionary = [NSMutableDictionary dictionary];
+  dictionary[acquisitionsKey] = acquisitions;
+  dictionary[alternativeHeadlineKey] = self.alternativeHeadline;
+  dictionary[authorStringsKey] = self.authorStrings;
+  dictionary[authorLinksKey] = DictionariesWithLinks(self.authorLinks);
+  dictionary[categoriesKey] = categories;
+  dictionary[identifierKey] = self.identifier;
+  dictionary[linksKey] = DictionariesWithLinks(self.links);
+  dictionary[annotationsKey] = self.annotations.dictionaryRepresentation;
+  dictionary[alternateKey] = self.alternate.dictionaryRepresentation;
+  dictionary[relatedWorksKey] = self.relatedWorks.dictionaryRepresentation;
+  dictionary[seriesLinkKey] = self.seriesLink.dictionaryRepresentation;
+  dictionary[providerNameKey] = self.providerName;
+  dictionary[publishedKey] = self.published;
+  dictionary[publisherKey] = self.publisher;
+  dictionary[summaryKey] = self.summary;
+  dictionary[titleKey] = self.title;
+  dictionary[updatedKey] = self.updated;
+  return dictionary;
+}
+
 - (NYPLOPDSEntryGroupAttributes *)groupAttributes
 {
   for(NYPLOPDSLink *const link in self.links) {
@@ -1,3 +1,4 @@
+@class NYPLOPDSEntry;
 @class NYPLXML;
 
 typedef NS_ENUM(NSInteger, NYPLOPDSFeedType) {
@@ -21,7 +22,23 @@ typedef NS_ENUM(NSInteger, NYPLOPDSFeedType) {
 + (id)new NS_UNAVAILABLE;
 - (id)init NS_UNAVAILABLE;
 
-/// Designated initializer.
+/// Builds the feed and all of its entries from @c feedXML.
 - (instancetype)initWithXML:(NYPLXML *)feedXML;
 
+/// Designated initializer.
+/// @param feedXML The feed element. Its @c entry children are ignored if
+/// @c entries is not nil.
+/// @param entries The entries of the feed, already built by the caller, e.g.
+/// while streaming the XML. Pass nil to build them from @c feedXML.
+- (instancetype)initWithXML:(NYPLXML *)feedXML
+                    entries:(NSArray<NYPLOPDSEntry *> *)entries;
+
+/// @param dictionary A dictionary created with @c dictionaryRepresentation.
+/// @return A feed, or @c nil if the dictionary is missing required values.
+- (instancetype)initWithDictionary:(NSDictionary *)dictionary;
+
+/// @return A serialized form of the feed and its entries suitable for passing
+/// to @c initWithDictionary: later on, e.g. to cache a parsed feed.
+- (NSDictionary *)dictionaryRepresentation;
+
 @end
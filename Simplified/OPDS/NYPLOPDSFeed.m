@@ -55,9 +55,23 @@ static NYPLOPDSFeedType TypeImpliedByEntry(NYPLOPDSEntry *const entry)
           : NYPLOPDSFeedTypeNavigation);
 }
 
+static NSString *const authorizationIdentifierKey = @"authorizationIdentifier";
+static NSString *const entriesKey = @"entries";
+static NSString *const identifierKey = @"identifier";
+static NSString *const licensorKey = @"licensor";
+static NSString *const linksKey = @"links";
+static NSString *const titleKey = @"title";
+static NSString *const updatedKey = @"updated";
+
 @implementation NYPLOPDSFeed
 
 - (instancetype)initWithXML:(NYPLXML *const)feedXML
+{
+  return [self initWithXML:feedXML entries:nil];
+}
+
+- (instancetype)initWithXML:(NYPLXML *const)feedXML
+                    entries:(NSArray<NYPLOPDSEntry *> *const)entries
 {
   self = [super init];
   if(!self) return nil;
@@ -118,8 +132,10 @@ static NYPLOPDSFeedType TypeImpliedByEntry(NYPLOPDSEntry *const entry)
     }
   }
   
-  {
-    NSMutableArray *const entries = [NSMutableArray array];
+  if(entries) {
+    self.entries = entries;
+  } else {
+    NSMutableArray *const mutableEntries = [NSMutableArray array];
     
     for(NYPLXML *const entryXML in [feedXML childrenWithName:@"entry"]) {
       NYPLOPDSEntry *const entry = [[NYPLOPDSEntry alloc] initWithXML:entryXML];
@@ -127,10 +143,10 @@ static NYPLOPDSFeedType TypeImpliedByEntry(NYPLOPDSEntry *const entry)
         NYPLLOG(@"Ingoring malformed 'entry' element.");
         continue;
       }
-      [entries addObject:entry];
+      [mutableEntries addObject:entry];
     }
     
-    self.entries = entries;
+    self.entries = mutableEntries;
   }
   
   {
@@ -162,6 +178,83 @@ static NYPLOPDSFeedType TypeImpliedByEntry(NYPLOPDSEntry *const entry)
   return self;
 }
 
+- (instancetype)initWithDictionary:(NSDictionary *const)dictionary
+{
+  self = [super init];
+  if(!self) return nil;
+
+  NSArray *const entryDictionaries = dictionary[entriesKey];
+  if(![entryDictionaries isKindOfClass:[NSArray class]]) {
+    NYPLLOG(@"Missing required entries.");
+    return nil;
+  }
+
+  {
+    NSMutableArray *const entries = [NSMutableArray arrayWithCapacity:entryDictionaries.count];
+    for(NSDictionary *const entryDictionary in entryDictionaries) {
+      NYPLOPDSEntry *const entry = [[NYPLOPDSEntry alloc] initWithDictionary:entryDictionary];
+      if(!entry) {
+        NYPLLOG(@"Ignoring invalid entry.");
+        continue;
+      }
+      [entries addObject:entry];
+    }
+    self.entries = entries;
+  }
+
+  // A feed made of a single entry has nothing else set.
+  self.identifier = dictionary[identifierKey];
+  if(!self.identifier) {
+    return self;
+  }
+
+  self.title = dictionary[titleKey];
+  self.updated = dictionary[updatedKey];
+  if(![self.title isKindOfClass:[NSString class]] || ![self.updated isKindOfClass:[NSDate class]]) {
+    NYPLLOG(@"Missing required feed values.");
+    return nil;
+  }
+
+  {
+    NSMutableArray *const links = [NSMutableArray array];
+    for(NSDictionary *const linkDictionary in dictionary[linksKey]) {
+      NYPLOPDSLink *const link = [[NYPLOPDSLink alloc] initWithDictionary:linkDictionary];
+      if(link) {
+        [links addObject:link];
+      }
+    }
+    self.links = links;
+  }
+
+  self.licensor = [dictionary[licensorKey] mutableCopy];
+  self.authorizationIdentifier = dictionary[authorizationIdentifierKey];
+
+  return self;
+}
+
+- (NSDictionary *)dictionaryRepresentation
+{
+  NSMutableArray *const entries = [NSMutableArray arrayWithCapacity:self.entries.count];
+  for(NYPLOPDSEntry *const entry in self.entries) {
+    [entries addObject:entry.dictionaryRepresentation];
+  }
+
+  NSMutableArray *const links = [NSMutableArray arrayWithCapacity:self.links.count];
+  for(NYPLOPDSLink *const link in self.links) {
+    [links addObject:link.dictionaryRepresentation];
+  }
+
+  NSMutableDictionary *const dictionary = [NSMutableDictionary dictionary];
+  dictionary[entriesKey] = entries;
+  dictionary[identifierKey] = self.identifier;
+  dictionary[linksKey] = links;
+  dictionary[titleKey] = self.title;
+  dictionary[updatedKey] = self.updated;
+  dictionary[licensorKey] = self.licensor;
+  dictionary[authorizationIdentifierKey] = self.authorizationIdentifier;
+  return dictionary;
+}
+
 - (NYPLOPDSFeedType)type
 {
   if(self.typeIsCached) {
@@ -45,7 +45,9 @@ import Foundation
         return
       }
     
+      let buildStartDate = Date()
       let catalogFeed = NYPLCatalogUngroupedFeed.init(opdsFeed: feed)
+      Log.debug(#function, "Built catalog feed from \(url) in \(Date().timeIntervalSince(buildStartDate)) sec")
       if let catalogFeed = catalogFeed,
          catalogFeed.books.count == 0,
          let nextURL = catalogFeed.nextURL {
@@ -88,42 +90,136 @@ import Foundation
         return
       }
       
-      guard let feedXML = NYPLXML.init(data: result) else {
-        Log.info(#function, "Failed to parse data as XML.")
-        NYPLErrorLogger.logError(withCode: .feedParseFail,
-                                 summary: "NYPLOPDSFeed: Failed to parse data as XML",
-                                 metadata: [
-                                  "requestURL": url.absoluteString as Any,
-                                  "response":response != nil ? response as Any : "N/A"
-                                 ])
-        var errorDict: [String: Any]? = nil
-        if let data = result,
-           let jsonObject = try? JSONSerialization.jsonObject(with: data, options: []) as? [String: Any] {
-          errorDict = jsonObject
-        }
+      let feed = makeFeed(from: result,
+                          url: url,
+                          response: response,
+                          networkExecutor: networkExecutor)
+      DispatchQueue.global(qos: .default).async {
+        completion(feed.feed, feed.error)
+      }
+    }
+  }
+
+  ///   Fetch the OPDS feed at `url` only if it changed since it was last
+  ///   fetched, with a conditional GET that bypasses the local URL cache.
+  ///
+  ///   - Parameter url: The URL to contact
+  ///   - Parameter validators: The `ETag` and/or `Last-Modified` values of
+  ///   the response the caller last processed, keyed by header name, as
+  ///   handed to a previous `completion`. Pass nil to fetch unconditionally.
+  ///   - Parameter completion: Always invoked at the end no matter what.
+  ///   `notModified` is true if the server replied 304, in which case `feed`
+  ///   and `error` are nil. Otherwise the parameters are the same as for
+  ///   `fetchOPDSFeed`, plus the `validators` of the new response.
+  ///
+  ///   - Note: This function logs events for all error situations.
+  class func fetchOPDSFeedIfModified(url: URL,
+                                     networkExecutor: NYPLNetworkExecutor,
+                                     validators: [String: String]?,
+                                     completion: @escaping (_ feed: NYPLOPDSFeed?,
+                                                            _ validators: [String: String]?,
+                                                            _ notModified: Bool,
+                                                            _ error: [String: Any]?) -> Void) {
+    var conditionalHeaders = [String: String]()
+    if let eTag = validators?[eTagHeader] {
+      conditionalHeaders["If-None-Match"] = eTag
+    }
+    if let lastModified = validators?[lastModifiedHeader] {
+      conditionalHeaders["If-Modified-Since"] = lastModified
+    }
+
+    // URLSession would otherwise answer from its own cache or replace our
+    // validators with the ones of its cached response.
+    let req = networkExecutor.request(for: url,
+                                      cachePolicy: .reloadIgnoringLocalCacheData,
+                                      additionalHeaders: conditionalHeaders)
+    networkExecutor.executeRequest(req) { result in
+      switch result {
+      case let .failure(error, _):
+        // Note: NYPLNetworkExecutor already logged this error
         DispatchQueue.global(qos: .default).async {
-          completion(nil, errorDict)
+          completion(nil, nil, false, (error as NSError).problemDocument?.dictionaryValue)
         }
-        return
-      }
-      
-      guard let feed = NYPLOPDSFeed.init(xml: feedXML) else {
-        Log.info(#function, "Could not interpret XML as OPDS..")
-        NYPLErrorLogger.logError(withCode: .feedParseFail,
-                                 summary: "NYPLOPDSFeed: Failed to parse XML as OPDS",
-                                 metadata: [
-                                  "requestURL": url.absoluteString as Any,
-                                  "response":response != nil ? response as Any : "N/A"
-                                 ])
+      case let .success(data, response):
+        let httpResponse = response as? HTTPURLResponse
+        if httpResponse?.statusCode == 304 {
+          Log.debug(#function, "Feed at \(url) not modified")
+          DispatchQueue.global(qos: .default).async {
+            completion(nil, validators, true, nil)
+          }
+          return
+        }
+
+        var newValidators = [String: String]()
+        newValidators[eTagHeader] = httpResponse?.eTagHeader
+        newValidators[lastModifiedHeader] = httpResponse?.lastModifiedHeader
+
+        let feed = makeFeed(from: data,
+                            url: url,
+                            response: response,
+                            networkExecutor: networkExecutor)
         DispatchQueue.global(qos: .default).async {
-          completion(nil, nil)
+          completion(feed.feed, newValidators.isEmpty ? nil : newValidators, false, feed.error)
         }
-        return
       }
-      
-      DispatchQueue.global(qos: .default).async {
-        completion(feed, nil)
+    }
+  }
+
+  private static let eTagHeader = "ETag"
+  private static let lastModifiedHeader = "Last-Modified"
+
+  /// Parses `result` into a feed, or takes the feed previously parsed from the
+  /// same data out of the executor's parsed feed cache.
+  ///
+  /// - Returns: The feed, or error information if `result` isn't a valid feed.
+  private class func makeFeed(from result: Data?,
+                              url: URL,
+                              response: URLResponse?,
+                              networkExecutor: NYPLHTTPRequestExecutingBasic) -> (feed: NYPLOPDSFeed?, error: [String: Any]?) {
+    // Skip parsing altogether if this same feed data was parsed before.
+    let feedCache = (networkExecutor as? NYPLNetworkExecutor)?.parsedFeedCache
+    let feedCacheKey = result.map { NYPLOPDSFeedCache.key(for: url, data: $0) }
+    if let feedCacheKey = feedCacheKey,
+       let feed = feedCache?.feed(forKey: feedCacheKey) {
+      Log.debug(#function, "Using previously parsed feed for \(url)")
+      return (feed, nil)
+    }
+
+    // Entries are built while the XML is being parsed, so that the XML tree
+    // of the whole feed is never held in memory at once.
+    let parseStartDate = Date()
+    let parser = result.map { NYPLOPDSFeedParser(data: $0) }
+    guard let parser = parser, parser.parse() else {
+      Log.info(#function, "Failed to parse data as XML.")
+      NYPLErrorLogger.logError(withCode: .feedParseFail,
+                               summary: "NYPLOPDSFeed: Failed to parse data as XML",
+                               metadata: [
+                                "requestURL": url.absoluteString as Any,
+                                "response":response != nil ? response as Any : "N/A"
+                               ])
+      var errorDict: [String: Any]? = nil
+      if let data = result,
+         let jsonObject = try? JSONSerialization.jsonObject(with: data, options: []) as? [String: Any] {
+        errorDict = jsonObject
       }
+      return (nil, errorDict)
+    }
+    
+    guard let feed = parser.feed else {
+      Log.info(#function, "Could not interpret XML as OPDS..")
+      NYPLErrorLogger.logError(withCode: .feedParseFail,
+                               summary: "NYPLOPDSFeed: Failed to parse XML as OPDS",
+                               metadata: [
+                                "requestURL": url.absoluteString as Any,
+                                "response":response != nil ? response as Any : "N/A"
+                               ])
+      return (nil, nil)
+    }
+    
+    Log.debug(#function, "Parsed \(feed.entries.count) entries from \(url) in \(Date().timeIntervalSince(parseStartDate)) sec")
+    if let feedCacheKey = feedCacheKey, let data = result {
+      feedCache?.setFeed(feed, forKey: feedCacheKey, cost: data.count)
     }
+    return (feed, nil)
   }
 }
@@ -0,0 +1,32 @@
+@class NYPLOPDSFeed;
+@class NYPLXML;
+
+/**
+ Builds an NYPLOPDSFeed from raw OPDS 1.x data without keeping the XML tree
+ of the whole document in memory.
+
+ Each @c entry element is turned into an NYPLOPDSEntry as soon as the parser
+ reaches its end tag, after which its XML is released. Peak memory is
+ therefore bounded by the feed-level elements plus a single entry, rather
+ than by the full document as with @c +[NYPLXML @c XMLWithData:].
+ */
+@interface NYPLOPDSFeedParser : NSObject
+
+/// The feed built by @c parse, or nil if @c parse was not called, failed, or
+/// the data is well-formed XML but not a valid OPDS feed.
+@property (nonatomic, readonly, nullable) NYPLOPDSFeed *feed;
+
+/// The root element parsed by @c parse, without its @c entry children.
+@property (nonatomic, readonly, nullable) NYPLXML *feedXML;
+
++ (nonnull id)new NS_UNAVAILABLE;
+- (nonnull id)init NS_UNAVAILABLE;
+
+/// Designated initializer.
+- (nonnull instancetype)initWithData:(nonnull NSData *)data;
+
+/// Parses the data synchronously.
+/// @return NO if the data is not well-formed XML.
+- (BOOL)parse;
+
+@end
@@ -0,0 +1,64 @@
+#import "NYPLOPDSEntry.h"
+#import "NYPLOPDSFeed.h"
+#import "NYPLXML.h"
+
+#import "NYPLOPDSFeedParser.h"
+
+@interface NYPLOPDSFeedParser ()
+
+@property (nonatomic) NSData *data;
+@property (nonatomic) NYPLOPDSFeed *feed;
+@property (nonatomic) NYPLXML *feedXML;
+
+@end
+
+@implementation NYPLOPDSFeedParser
+
+- (instancetype)initWithData:(NSData *const)data
+{
+  self = [super init];
+  if(!self) return nil;
+  
+  if(!data) {
+    @throw NSInvalidArgumentException;
+  }
+  
+  self.data = data;
+  
+  return self;
+}
+
+- (BOOL)parse
+{
+  self.feed = nil;
+  self.feedXML = nil;
+  
+  NSMutableArray<NYPLOPDSEntry *> *const entries = [NSMutableArray array];
+  NYPLXML *const feedXML = [NYPLXML XMLWithData:self.data
+                         streamingChildrenNamed:[NSSet setWithObject:@"entry"]
+                                        handler:^(NYPLXML *const entryXML) {
+    NYPLOPDSEntry *const entry = [[NYPLOPDSEntry alloc] initWithXML:entryXML];
+    if(!entry) {
+      NYPLLOG(@"Ignoring malformed 'entry' element.");
+      return;
+    }
+    [entries addObject:entry];
+  }];
+  
+  if(!feedXML) {
+    return NO;
+  }
+  
+  self.feedXML = feedXML;
+  
+  // Sometimes we get back JUST an entry, in which case nothing was streamed.
+  if([feedXML.name isEqual:@"entry"]) {
+    self.feed = [[NYPLOPDSFeed alloc] initWithXML:feedXML];
+  } else {
+    self.feed = [[NYPLOPDSFeed alloc] initWithXML:feedXML entries:entries];
+  }
+  
+  return YES;
+}
+
+@end
@@ -15,4 +15,10 @@
 // designated initializer
 - (instancetype)initWithXML:(NYPLXML *)linkXML;
 
+// |dictionaryRepresentation| holds the attributes of the link element, so this is the same as
+// building the link from an element with those attributes.
+- (instancetype)initWithDictionary:(NSDictionary *)dictionary;
+
+- (NSDictionary *)dictionaryRepresentation;
+
 @end
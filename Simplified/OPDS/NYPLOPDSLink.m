@@ -18,13 +18,18 @@
 @implementation NYPLOPDSLink
 
 - (instancetype)initWithXML:(NYPLXML *const)linkXML
+{
+  return [self initWithDictionary:linkXML.attributes];
+}
+
+- (instancetype)initWithDictionary:(NSDictionary *const)attributes
 {
   self = [super init];
   if(!self) return nil;
   
   {
-    NSString *const hrefString = linkXML.attributes[@"href"];
-    if(!hrefString) {
+    NSString *const hrefString = attributes[@"href"];
+    if(![hrefString isKindOfClass:[NSString class]]) {
       NYPLLOG(@"Missing required 'href' attribute.");
       return nil;
     }
@@ -37,13 +42,18 @@
     }
   }
   
-  self.attributes = linkXML.attributes;
-  self.rel = linkXML.attributes[@"rel"];
-  self.type = linkXML.attributes[@"type"];
-  self.hreflang = linkXML.attributes[@"hreflang"];
-  self.title = linkXML.attributes[@"title"];
+  self.attributes = attributes;
+  self.rel = attributes[@"rel"];
+  self.type = attributes[@"type"];
+  self.hreflang = attributes[@"hreflang"];
+  self.title = attributes[@"title"];
 
   return self;
 }
 
+- (NSDictionary *)dictionaryRepresentation
+{
+  return self.attributes;
+}
+
 @end
@@ -0,0 +1,163 @@
+//
+//  NYPLReadiumBookmarkIndex.swift
+//  Simplified
+//
+//  Copyright © 2026 NYPL. All rights reserved.
+//
+
+import Foundation
+import R2Shared
+import NYPLUtilities
+
+/// The bookmarks of a publication, kept sorted for display and indexed by
+/// chapter for location lookups.
+///
+/// `bookmarks` is ordered with `NYPLReadiumBookmark::lessThan(_:)`, the same
+/// order the bookmarks list has always used. In addition, the bookmarks of
+/// each chapter are kept ordered by `progressWithinChapter`, so that finding
+/// the bookmark at a given locator only requires a binary search in the
+/// locator's chapter.
+struct NYPLReadiumBookmarkIndex {
+
+  /// All bookmarks, in display order.
+  private(set) var bookmarks: [NYPLReadiumBookmark]
+
+  /// Bookmarks with an `href`, grouped by `href` and sorted by
+  /// `progressWithinChapter` within each group.
+  private var bookmarksByHref: [String: [NYPLReadiumBookmark]]
+
+  //----------------------------------------------------------------------------
+  init(bookmarks: [NYPLReadiumBookmark] = []) {
+    self.bookmarks = bookmarks.sorted { $0.lessThan($1) }
+    self.bookmarksByHref = [:]
+    for bookmark in self.bookmarks {
+      guard let href = bookmark.href else {
+        continue
+      }
+      bookmarksByHref[href, default: []].append(bookmark)
+    }
+    for href in bookmarksByHref.keys {
+      bookmarksByHref[href]?.sort { $0.progressWithinChapter < $1.progressWithinChapter }
+    }
+  }
+
+  var count: Int {
+    return bookmarks.count
+  }
+
+  //----------------------------------------------------------------------------
+  /// Finds the bookmark addressing the same location as `locator`, with the
+  /// same tolerance as `NYPLReadiumBookmark::locationMatches(_:inPublication:)`.
+  ///
+  /// - Complexity: O(*log n*), where *n* is the number of bookmarks in the
+  /// locator's chapter.
+  func bookmark(at locator: Locator,
+                inPublication publication: Publication) -> NYPLReadiumBookmark? {
+    guard let chapterBookmarks = bookmarksByHref[locator.href] else {
+      return nil
+    }
+
+    guard let progression = locator.locations.progression else {
+      // nothing to search on, let the bookmark decide
+      return chapterBookmarks.first {
+        $0.locationMatches(locator, inPublication: publication)
+      }
+    }
+
+    // Bookmarks within the tolerance of `progression` are contiguous in the
+    // sorted chapter, around the position `progression` would be inserted at.
+    let target = Float(progression)
+    let locatorChapterProgress: Float? = target
+    let index = NYPLReadiumBookmarkIndex.insertionIndex(in: chapterBookmarks) {
+      $0.progressWithinChapter < target
+    }
+    for candidate in [index, index - 1] where chapterBookmarks.indices.contains(candidate) {
+      let bookmark = chapterBookmarks[candidate]
+      if bookmark.progressWithinChapter =~= locatorChapterProgress {
+        return bookmark
+      }
+    }
+
+    return nil
+  }
+
+  //----------------------------------------------------------------------------
+  /// Inserts `bookmark` in display order and in its chapter.
+  ///
+  /// - Complexity: O(*log n*) comparisons.
+  mutating func insert(_ bookmark: NYPLReadiumBookmark) {
+    let index = NYPLReadiumBookmarkIndex.insertionIndex(in: bookmarks) {
+      !bookmark.lessThan($0)
+    }
+    bookmarks.insert(bookmark, at: index)
+
+    guard let href = bookmark.href else {
+      return
+    }
+    var chapterBookmarks = bookmarksByHref.removeValue(forKey: href) ?? []
+    let chapterIndex = NYPLReadiumBookmarkIndex.insertionIndex(in: chapterBookmarks) {
+      $0.progressWithinChapter <= bookmark.progressWithinChapter
+    }
+    chapterBookmarks.insert(bookmark, at: chapterIndex)
+    bookmarksByHref[href] = chapterBookmarks
+  }
+
+  //----------------------------------------------------------------------------
+  /// Removes the bookmarks equal to `bookmark`.
+  ///
+  /// - Returns: `true` if any bookmark was removed.
+  mutating func remove(_ bookmark: NYPLReadiumBookmark) -> Bool {
+    var removedBookmarks = [NYPLReadiumBookmark]()
+    bookmarks.removeAll {
+      let isMatching = $0.isEqual(bookmark)
+      if isMatching {
+        removedBookmarks.append($0)
+      }
+      return isMatching
+    }
+
+    removedBookmarks.forEach { removeFromChapter($0) }
+    return !removedBookmarks.isEmpty
+  }
+
+  //----------------------------------------------------------------------------
+  /// Removes the bookmark at `index` in display order.
+  mutating func remove(at index: Int) -> NYPLReadiumBookmark {
+    let bookmark = bookmarks.remove(at: index)
+    removeFromChapter(bookmark)
+    return bookmark
+  }
+
+  // MARK: - Private
+
+  //----------------------------------------------------------------------------
+  private mutating func removeFromChapter(_ bookmark: NYPLReadiumBookmark) {
+    guard let href = bookmark.href else {
+      return
+    }
+    bookmarksByHref[href]?.removeAll { $0 === bookmark }
+    if bookmarksByHref[href]?.isEmpty == true {
+      bookmarksByHref[href] = nil
+    }
+  }
+
+  //----------------------------------------------------------------------------
+  /// - Returns: The index of the first element of `array` for which
+  /// `isBefore` is false, `isBefore` being true for a prefix of `array`.
+  private static func insertionIndex(
+    in array: [NYPLReadiumBookmark],
+    isBefore: (NYPLReadiumBookmark) -> Bool) -> Int {
+
+    var low = 0
+    var high = array.count
+    while low < high {
+      let mid = (low + high) / 2
+      if isBefore(array[mid]) {
+        low = mid + 1
+      } else {
+        high = mid
+      }
+    }
+    return low
+  }
+}
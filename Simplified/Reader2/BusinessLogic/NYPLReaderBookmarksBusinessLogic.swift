@@ -14,7 +14,16 @@ import R2Navigator
 /// for a given book.
 class NYPLReaderBookmarksBusinessLogic: NSObject {
 
-  var bookmarks: [NYPLReadiumBookmark] = []
+  /// The bookmarks of the book, sorted by progression within the book.
+  var bookmarks: [NYPLReadiumBookmark] {
+    get {
+      return bookmarkIndex.bookmarks
+    }
+    set {
+      bookmarkIndex = NYPLReadiumBookmarkIndex(bookmarks: newValue)
+    }
+  }
+  private var bookmarkIndex = NYPLReadiumBookmarkIndex()
   let book: NYPLBook
   private let publication: Publication
   private let drmDeviceID: String?
@@ -33,7 +42,8 @@ class NYPLReaderBookmarksBusinessLogic: NSObject {
     self.publication = r2Publication
     self.drmDeviceID = drmDeviceID
     self.bookRegistry = bookRegistryProvider
-    bookmarks = bookRegistryProvider.readiumBookmarks(forIdentifier: book.identifier)
+    self.bookmarkIndex = NYPLReadiumBookmarkIndex(
+      bookmarks: bookRegistryProvider.readiumBookmarks(forIdentifier: book.identifier))
     self.syncPermission = syncPermission
     self.bookmarksFactory = NYPLReadiumBookmarkFactory(publication: publication,
                                                        drmDeviceID: drmDeviceID)
@@ -75,8 +85,7 @@ class NYPLReaderBookmarksBusinessLogic: NSObject {
       return nil
     }
 
-    return bookmarks.first { $0.locationMatches(currentLocator,
-                                                inPublication: publication)}
+    return bookmarkIndex.bookmark(at: currentLocator, inPublication: publication)
   }
 
   /// Creates a new bookmark at the given location for the publication.
@@ -99,8 +108,7 @@ class NYPLReaderBookmarksBusinessLogic: NSObject {
       return nil
     }
 
-    bookmarks.append(bookmark)
-    bookmarks.sort { $0.lessThan($1) }
+    bookmarkIndex.insert(bookmark)
 
     postBookmark(bookmark)
 
@@ -121,16 +129,7 @@ class NYPLReaderBookmarksBusinessLogic: NSObject {
   }
 
   func deleteBookmark(_ bookmark: NYPLReadiumBookmark) {
-    var wasDeleted = false
-    bookmarks.removeAll  {
-      let isMatching = $0.isEqual(bookmark)
-      if isMatching {
-        wasDeleted = true
-      }
-      return isMatching
-    }
-
-    if wasDeleted {
+    if bookmarkIndex.remove(bookmark) {
       didDeleteBookmark(bookmark)
     }
   }
@@ -140,7 +139,7 @@ class NYPLReaderBookmarksBusinessLogic: NSObject {
       return nil
     }
 
-    let bookmark = bookmarks.remove(at: index)
+    let bookmark = bookmarkIndex.remove(at: index)
     didDeleteBookmark(bookmark)
 
     return bookmark
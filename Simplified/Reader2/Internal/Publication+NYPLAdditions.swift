@@ -9,16 +9,85 @@
 import Foundation
 import R2Shared
 
+/// Lookup tables mapping the idrefs and hrefs of a publication's
+/// `readingOrder` to their position in it.
+///
+/// The tables are built the first time one of the lookups below is used, and
+/// are then attached to the publication, so that they live as long as it does.
+final class NYPLPublicationReadingOrderIndex {
+  private static var associationKey: UInt8 = 0
+  private static let lock = NSLock()
+
+  private let readingOrder: [Link]
+  private let positionsByIdref: [String: Int]
+  private let positionsByHref: [String: Int]
+
+  //----------------------------------------------------------------------------
+  init(readingOrder: [Link]) {
+    var positionsByIdref = [String: Int]()
+    var positionsByHref = [String: Int]()
+    // keep the first occurrence, as linear scans would find
+    for (position, link) in readingOrder.enumerated().reversed() {
+      if let idref = link.properties[Publication.idrefKey] as? String {
+        positionsByIdref[idref] = position
+      }
+      positionsByHref[link.href] = position
+    }
+
+    self.readingOrder = readingOrder
+    self.positionsByIdref = positionsByIdref
+    self.positionsByHref = positionsByHref
+  }
+
+  //----------------------------------------------------------------------------
+  /// - Returns: The index of `publication`, built if needed.
+  static func index(for publication: Publication) -> NYPLPublicationReadingOrderIndex {
+    lock.lock()
+    defer {
+      lock.unlock()
+    }
+
+    if let index = objc_getAssociatedObject(publication, &associationKey)
+      as? NYPLPublicationReadingOrderIndex {
+      return index
+    }
+
+    let index = NYPLPublicationReadingOrderIndex(readingOrder: publication.readingOrder)
+    objc_setAssociatedObject(publication, &associationKey, index,
+                             .OBJC_ASSOCIATION_RETAIN_NONATOMIC)
+    return index
+  }
+
+  func position(forIdref idref: String) -> Int? {
+    return positionsByIdref[idref]
+  }
+
+  func position(forHref href: String) -> Int? {
+    return positionsByHref[href]
+  }
+
+  func link(at position: Int?) -> Link? {
+    guard let position = position else {
+      return nil
+    }
+    return readingOrder[position]
+  }
+}
+
 extension Publication {
   static let idrefKey = "id"
 
+  private var readingOrderIndex: NYPLPublicationReadingOrderIndex {
+    return NYPLPublicationReadingOrderIndex.index(for: self)
+  }
+
   /// Obtains a R2 Link object from a given ID reference.
   ///
   /// This for example can be used to get the link object related to a R1
   /// bookmark by passing in the NYPLReadiumBookmark::idref.
   ///
-  /// - Complexity: O(*n*), where *n* is the length of `readingOrder`
-  /// data structure internal to this Publication.
+  /// - Complexity: O(*1*), after a first call building the publication's
+  /// lookup tables in O(*n*), where *n* is the length of `readingOrder`.
   ///
   /// - Parameter idref: The ID for the given chapter in the publication.
   ///
@@ -28,13 +97,13 @@ extension Publication {
     // The Publication stores all bookmarks (and TOC; positions in general) in
     // the `readingOrder` list of Links. Each `Link` stores its metadata in a
     // `properties` dictionary.
-    return readingOrder.first { $0.properties[Publication.idrefKey] as? String == idref }
+    let index = readingOrderIndex
+    return index.link(at: index.position(forIdref: idref))
   }
 
   /// Obtains a R2 HREF from a given ID reference.
   ///
-  /// - Complexity: O(*n*), where *n* is the length of `readingOrder`
-  /// data structure internal to this Publication.
+  /// - Complexity: O(*1*), see `link(withIDref:)`.
   ///
   /// - Parameter idref: The ID for the given chapter in the publication.
   ///
@@ -54,15 +123,16 @@ extension Publication {
   /// resource URI (for example from a `Link` or a `Locator` object) and
   /// need to obtain the ID of the related resource.
   ///
-  /// - Complexity: O(*n*), where *n* is the length of `readingOrder`
-  /// data structure internal to this Publication.
+  /// - Complexity: O(*1*) for resources in `readingOrder`, see
+  /// `link(withIDref:)`. Other resources are searched in O(*n*).
   ///
   /// - Parameter href: The URI of a resource in R2.
   ///
   /// - Returns: The `idref` related to the resource in question. This *must*
   /// be usable in R1 contexts.
   func idref(forHref href: String) -> String? {
-    let link = self.link(withHREF: href)
+    let index = readingOrderIndex
+    let link = index.link(at: index.position(forHref: href)) ?? self.link(withHREF: href)
     return link?.properties[Publication.idrefKey] as? String
   }
 
@@ -73,8 +143,11 @@ extension Publication {
 
   /// Shortcut to get the resource index (stored within internal R2 data
   /// structures) pointed at by the given Locator.
+  ///
+  /// - Complexity: O(*1*), see `link(withIDref:)`.
+  ///
   /// - parameter locator: The location for which we want the resource index of.
   func resourceIndex(forLocator locator: Locator) -> Int? {
-    return readingOrder.firstIndex(withHREF: locator.href)
+    return readingOrderIndex.position(forHref: locator.href)
   }
 }
@@ -13,6 +13,24 @@
 
 #define ADOBE_RIGHTS_XML_SUFFIX @"_rights.xml"
 
+/// Decrypts a single resource block by block, so that it never needs to be
+/// entirely in memory. Blocks must be passed in order, starting from the
+/// beginning of the encrypted resource.
+@interface AdobeDRMStreamDecryptor : NSObject
+NS_ASSUME_NONNULL_BEGIN
+- (instancetype)init NS_UNAVAILABLE;
+/// Decrypts the next block of the resource.
+/// @param block Encrypted data following the previous block
+/// @param isFinal Whether `block` ends the resource
+/// @return The decrypted data, possibly empty, or `nil` on failure
+- (nullable NSData *)decryptBlock:(NSData *)block final:(BOOL)isFinal;
+NS_ASSUME_NONNULL_END
+/// Whether the final block has been decrypted.
+@property (nonatomic, readonly) BOOL finished;
+/// Error message of the last failed decryption
+@property (nonatomic, strong, readonly) NSString * _Nullable error;
+@end
+
 @interface AdobeDRMContainer : NSObject
 NS_ASSUME_NONNULL_BEGIN
 - (instancetype)init NS_UNAVAILABLE;
@@ -24,9 +42,28 @@ NS_ASSUME_NONNULL_BEGIN
 /// @param data Encrypted data
 /// @param path File path inside ePub file
 - (NSData *)decodeData:(NSData *)data at:(NSString *)path;
+/// Whether encryption.xml lists the file at path inside ePub file
+/// @param path File path inside ePub file
+- (BOOL)isEncryptedAt:(NSString *)path;
+/// Creates a decryptor for the file at path inside ePub file
+/// @param path File path inside ePub file
+/// @return The decryptor, or `nil` if it can't be created, in which case
+/// `epubDecodingError` describes why
+- (nullable AdobeDRMStreamDecryptor *)streamDecryptorAt:(NSString *)path;
+
+/// Cumulative time spent in each phase of decryption, to measure how long
+/// page loads wait on it.
+@property (nonatomic, readonly) NSUInteger decodedResourceCount;
+/// Time spent waiting for other decryptions to finish.
+@property (nonatomic, readonly) NSTimeInterval lockWaitTime;
+@property (nonatomic, readonly) NSTimeInterval metadataParsingTime;
+@property (nonatomic, readonly) NSTimeInterval decryptorCreationTime;
+@property (nonatomic, readonly) NSTimeInterval decryptionTime;
+/// A one-line summary of the counters above, suitable for logging.
+@property (nonatomic, readonly) NSString *timingSummary;
 NS_ASSUME_NONNULL_END
 /// Error messages from the container or underlying classes
-@property (nonatomic, strong) NSString * _Nullable epubDecodingError;
+@property (atomic, strong) NSString * _Nullable epubDecodingError;
 @end
 
 #endif /* AdobeDRMContainer_h */
@@ -16,12 +16,98 @@
 #include "dp_all.h"
 #pragma clang diagnostic pop
 
+#include <chrono>
+#include <string>
+#include <unordered_map>
+
+/// Serializes calls into the Adobe DRM library, which is not documented as
+/// thread-safe.
+/// Only the calls into the library are made while holding it.
 static id acsdrm_lock = nil;
 
+static inline double AdobeDRMSecondsSince(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+@interface AdobeDRMContainer ()
+- (void)addDecryptionTime:(NSTimeInterval)time;
+@end
+
+@interface AdobeDRMStreamDecryptor () {
+  @private dp::ref<dputils::EPubManifestItemDecryptor> decryptor;
+  @private BOOL didDecryptFirstBlock;
+}
+@property (nonatomic, weak) AdobeDRMContainer *container;
+@property (nonatomic) BOOL finished;
+@property (nonatomic, strong) NSString *error;
+@end
+
+@implementation AdobeDRMStreamDecryptor
+
+- (instancetype)initWithDecryptor:(dp::ref<dputils::EPubManifestItemDecryptor>)itemDecryptor
+                        container:(AdobeDRMContainer *)container {
+  if (self = [super init]) {
+    decryptor = itemDecryptor;
+    _container = container;
+  }
+  return self;
+}
+
+- (NSData *)decryptBlock:(NSData *)block final:(BOOL)isFinal {
+  if (self.finished) {
+    self.error = @"Decryption already finished";
+    return nil;
+  }
+
+  int blockType = 0;
+  if (!didDecryptFirstBlock) {
+    blockType |= dputils::EPubManifestItemDecryptor::FIRST_BLOCK;
+  }
+  if (isFinal) {
+    blockType |= dputils::EPubManifestItemDecryptor::FINAL_BLOCK;
+  }
+
+  NSData *decryptedData = nil;
+  @synchronized (acsdrm_lock) {
+    auto start = std::chrono::steady_clock::now();
+    dp::ref<dp::Buffer> filteredData = NULL;
+    dp::String error = decryptor->decryptBlock(blockType, (uint8_t *)block.bytes, block.length, NULL, filteredData);
+    if (!error.isNull()) {
+      self.error = [NSString stringWithUTF8String:error.utf8()];
+    } else if (filteredData) {
+      decryptedData = [NSData dataWithBytes:filteredData->data() length:NSUInteger(filteredData->length())];
+    } else {
+      decryptedData = [NSData data];
+    }
+    [self.container addDecryptionTime:AdobeDRMSecondsSince(start)];
+  }
+
+  didDecryptFirstBlock = YES;
+  if (decryptedData) {
+    self.finished = isFinal;
+  }
+  return decryptedData;
+}
+
+@end
+
 @interface AdobeDRMContainer () {
   @private dpdev::Device *device;
   @private dp::Data rightsXMLData;
   @private NSData *encryptionData;
+
+  // Parsed lazily, on first use, and then shared by all the resources.
+  @private dp::ref<dputils::EncryptionMetadata> encryptionMetadata;
+  @private BOOL didParseEncryptionMetadata;
+  // Item info for every path looked up so far. A null ref means the path
+  // is not listed in encryption.xml.
+  @private std::unordered_map<std::string, dp::ref<dputils::EncryptionItemInfo>> itemInfoCache;
+
+  @private NSUInteger _decodedResourceCount;
+  @private NSTimeInterval _lockWaitTime;
+  @private NSTimeInterval _metadataParsingTime;
+  @private NSTimeInterval _decryptorCreationTime;
+  @private NSTimeInterval _decryptionTime;
 }
 @end
 
@@ -31,7 +117,10 @@ static id acsdrm_lock = nil;
 - (instancetype)initWithURL:(NSURL *)fileURL encryptionData:(NSData *)data {
   
   if (self = [super init]) {
-    acsdrm_lock = [[NSObject alloc] init];
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+      acsdrm_lock = [[NSObject alloc] init];
+    });
     encryptionData = data;
     NSString *path = fileURL.path;
 
@@ -52,60 +141,184 @@ static id acsdrm_lock = nil;
   return self;
 }
 
+/// Returns the encryption info for the file at `path`, parsing encryption.xml
+/// the first time it's needed. Must be called while holding `acsdrm_lock`.
+- (dp::ref<dputils::EncryptionItemInfo>)itemInfoForPath:(NSString *)path {
+  std::string key (path.UTF8String);
+  auto cached = itemInfoCache.find(key);
+  if (cached != itemInfoCache.end()) {
+    return cached->second;
+  }
+
+  if (!didParseEncryptionMetadata) {
+    auto start = std::chrono::steady_clock::now();
+    size_t encryptionLen = encryptionData.length;
+    unsigned char *encryptionContent = (unsigned char *)encryptionData.bytes;
+    dp::Data encryptionXMLData (encryptionContent, encryptionLen);
+    encryptionMetadata = dputils::EncryptionMetadata::createFromXMLData(encryptionXMLData);
+    didParseEncryptionMetadata = YES;
+    _metadataParsingTime += AdobeDRMSecondsSince(start);
+  }
+
+  dp::ref<dputils::EncryptionItemInfo> itemInfo = NULL;
+  if (encryptionMetadata) {
+    uft::String itemPath (key.c_str());
+    itemInfo = encryptionMetadata->getItemForURI(itemPath);
+  }
+  itemInfoCache[key] = itemInfo;
+  return itemInfo;
+}
+
 - (NSData *)decodeData:(NSData *)data at:(NSString *)path {
+  // These checks don't involve the DRM library
+  if (rightsXMLData.isNull()) {
+    self.epubDecodingError = @"Missing Rights XML Data";
+    return data;
+  }
+
+  if (!device) {
+    self.epubDecodingError = @"Device information is empty";
+    return data;
+  }
+
+  NSString *decodingError = nil;
+  NSData *decodedData = data;
+  auto lockRequested = std::chrono::steady_clock::now();
 
   @synchronized (acsdrm_lock) {
-    // clear any error
-    self.epubDecodingError = nil;
+    _lockWaitTime += AdobeDRMSecondsSince(lockRequested);
+    _decodedResourceCount += 1;
 
     // itemInfo describes encription protocol for a file in encryption.xml
     // this way decryptor knows how to decode a block of data
-    // Encryption metadata for the file from encryption.xml
-    size_t encryptionLen = encryptionData.length;
-    unsigned char *encryptionContent = (unsigned char *)encryptionData.bytes;
-    dp::Data encryptionXMLData (encryptionContent, encryptionLen);
-    dp::ref<dputils::EncryptionMetadata> encryptionMetadata = dputils::EncryptionMetadata::createFromXMLData(encryptionXMLData);
-    uft::String itemPath (path.UTF8String);
-    dp::ref<dputils::EncryptionItemInfo> itemInfo = encryptionMetadata->getItemForURI(itemPath);
+    dp::ref<dputils::EncryptionItemInfo> itemInfo = [self itemInfoForPath:path];
 
     if (!itemInfo) {
-      self.epubDecodingError = @"Missing EncryptionItemInfo";
-      return data;
-    }
-    
-    if (rightsXMLData.isNull()) {
-      self.epubDecodingError = @"Missing Rights XML Data";
-      return data;
-    }
-    
-    if (!device) {
-      self.epubDecodingError = @"Device information is empty";
-      return data;
+      decodingError = @"Missing EncryptionItemInfo";
+    } else {
+      // A decryptor carries the state of the stream it decrypts, so it can't be
+      // reused across resources: only its inputs are cached.
+      auto start = std::chrono::steady_clock::now();
+      dp::String decryptorEerror;
+      dp::ref<dputils::EPubManifestItemDecryptor> decryptor = dpdrm::DRMProcessor::createEPubManifestItemDecryptor(itemInfo, rightsXMLData, device, decryptorEerror);
+      _decryptorCreationTime += AdobeDRMSecondsSince(start);
+
+      if (!decryptor) {
+        if (!decryptorEerror.isNull()) {
+          decodingError = [NSString stringWithUTF8String:decryptorEerror.utf8()];
+        }
+      } else {
+        start = std::chrono::steady_clock::now();
+        // Buffer for decrypted data
+        dp::ref<dp::Buffer> filteredData = NULL;
+        // data is the first and the last block (the whole block of data is decoded at once)
+        int blockType = dputils::EPubManifestItemDecryptor::FIRST_BLOCK | dputils::EPubManifestItemDecryptor::FINAL_BLOCK;
+        size_t len = data.length;
+        uint8_t *encryptedData = (uint8_t *)data.bytes;
+        dp::String error = decryptor->decryptBlock(blockType, encryptedData, len, NULL, filteredData);
+        if (!error.isNull()) {
+          decodingError = [NSString stringWithUTF8String:error.utf8()];
+        } else {
+          decodedData = [NSData dataWithBytes:filteredData->data() length: NSUInteger(filteredData->length())];
+        }
+        _decryptionTime += AdobeDRMSecondsSince(start);
+      }
     }
+  }
+
+  self.epubDecodingError = decodingError;
+  return decodedData;
+}
+
+- (BOOL)isEncryptedAt:(NSString *)path {
+  @synchronized (acsdrm_lock) {
+    return !![self itemInfoForPath:path];
+  }
+}
+
+- (AdobeDRMStreamDecryptor *)streamDecryptorAt:(NSString *)path {
+  if (rightsXMLData.isNull()) {
+    self.epubDecodingError = @"Missing Rights XML Data";
+    return nil;
+  }
 
-    // Create decryptor
-    dp::String decryptorEerror;
-    dp::ref<dputils::EPubManifestItemDecryptor> decryptor = dpdrm::DRMProcessor::createEPubManifestItemDecryptor(itemInfo, rightsXMLData, device, decryptorEerror);
+  if (!device) {
+    self.epubDecodingError = @"Device information is empty";
+    return nil;
+  }
+
+  NSString *decodingError = nil;
+  AdobeDRMStreamDecryptor *streamDecryptor = nil;
+  auto lockRequested = std::chrono::steady_clock::now();
+
+  @synchronized (acsdrm_lock) {
+    _lockWaitTime += AdobeDRMSecondsSince(lockRequested);
+    _decodedResourceCount += 1;
 
-    if (!decryptor) {
-      if (!decryptorEerror.isNull()) {
-        self.epubDecodingError = [NSString stringWithUTF8String:decryptorEerror.utf8()];
+    dp::ref<dputils::EncryptionItemInfo> itemInfo = [self itemInfoForPath:path];
+    if (!itemInfo) {
+      decodingError = @"Missing EncryptionItemInfo";
+    } else {
+      auto start = std::chrono::steady_clock::now();
+      dp::String decryptorEerror;
+      dp::ref<dputils::EPubManifestItemDecryptor> decryptor = dpdrm::DRMProcessor::createEPubManifestItemDecryptor(itemInfo, rightsXMLData, device, decryptorEerror);
+      _decryptorCreationTime += AdobeDRMSecondsSince(start);
+
+      if (decryptor) {
+        streamDecryptor = [[AdobeDRMStreamDecryptor alloc] initWithDecryptor:decryptor container:self];
+      } else if (!decryptorEerror.isNull()) {
+        decodingError = [NSString stringWithUTF8String:decryptorEerror.utf8()];
       }
-      return data;
     }
-    
-    // Buffer for decrypted data
-    dp::ref<dp::Buffer> filteredData = NULL;
-    // data is the first and the last block (the whole block of data is decoded at once)
-    int blockType = dputils::EPubManifestItemDecryptor::FIRST_BLOCK | dputils::EPubManifestItemDecryptor::FINAL_BLOCK;
-    size_t len = data.length;
-    uint8_t *encryptedData = (uint8_t *)data.bytes;
-    dp::String error = decryptor->decryptBlock(blockType, encryptedData, len, NULL, filteredData);
-    if (!error.isNull()) {
-      self.epubDecodingError = [NSString stringWithUTF8String:error.utf8()];
-      return data;
-    }
-    return [NSData dataWithBytes:filteredData->data() length: NSUInteger(filteredData->length())];
+  }
+
+  self.epubDecodingError = decodingError;
+  return streamDecryptor;
+}
+
+/// Must be called while holding `acsdrm_lock`.
+- (void)addDecryptionTime:(NSTimeInterval)time {
+  _decryptionTime += time;
+}
+
+#pragma mark - Timing
+
+- (NSUInteger)decodedResourceCount {
+  @synchronized (acsdrm_lock) {
+    return _decodedResourceCount;
+  }
+}
+
+- (NSTimeInterval)lockWaitTime {
+  @synchronized (acsdrm_lock) {
+    return _lockWaitTime;
+  }
+}
+
+- (NSTimeInterval)metadataParsingTime {
+  @synchronized (acsdrm_lock) {
+    return _metadataParsingTime;
+  }
+}
+
+- (NSTimeInterval)decryptorCreationTime {
+  @synchronized (acsdrm_lock) {
+    return _decryptorCreationTime;
+  }
+}
+
+- (NSTimeInterval)decryptionTime {
+  @synchronized (acsdrm_lock) {
+    return _decryptionTime;
+  }
+}
+
+- (NSString *)timingSummary {
+  @synchronized (acsdrm_lock) {
+    return [NSString stringWithFormat:@"%lu resources decoded; waited %.3fs for lock, "
+            "parsed encryption.xml in %.3fs, created decryptors in %.3fs, decrypted in %.3fs",
+            (unsigned long)_decodedResourceCount, _lockWaitTime, _metadataParsingTime,
+            _decryptorCreationTime, _decryptionTime];
   }
 }
 
@@ -38,23 +38,17 @@ class AdobeDRMFetcher: Fetcher {
   /// Get resource such as content file by its link.
   ///
   /// `AdobeDRMFetcher` `get` function open .epub resources using the `fetcher` passed to `init`.
-  ///  After resource is found and its data is read, AdobeDRMContainer decodes the resource data.
+  ///  The returned resource decrypts the resource data block by block, only when it is read.
   ///
   /// - Parameter link: Resource link (URL of content HREF)
-  /// - Returns: Decrypted `Resource` object; `DataResource` in case of success or `FailureResource` otherwise.
+  /// - Returns: `AdobeDRMResource` object decrypting the resource on demand.
   func get(_ link: Link) -> Resource {
-    do {
-      let resource = fetcher.get(link)
-      let encryptedData = try resource.read().get()
-      let href = link.href.starts(with: "/") ? String(link.href.dropFirst()) : link.href
-      let data = container.decode(encryptedData, at: href)
-      return DataResource(link: link, data: data)
-    } catch {
-      return FailureResource(link: link, error: .other(error))
-    }
+    let href = link.href.starts(with: "/") ? String(link.href.dropFirst()) : link.href
+    return AdobeDRMResource(resource: fetcher.get(link), container: container, path: href)
   }
   
   func close() {
+    Log.debug(#file, "Adobe DRM decryption: \(container.timingSummary)")
     fetcher.close()
   }
 }
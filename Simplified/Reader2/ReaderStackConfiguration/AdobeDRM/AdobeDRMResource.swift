@@ -0,0 +1,263 @@
+//
+//  AdobeDRMResource.swift
+//  Simplified
+//
+//  Copyright © 2026 NYPL. All rights reserved.
+//
+
+#if FEATURE_DRM_CONNECTOR
+
+import Foundation
+import R2Shared
+
+/// A resource of an Adobe DRM protected .epub, decrypted on demand.
+///
+/// Instead of decrypting the whole resource at once, `AdobeDRMResource` reads
+/// and decrypts it one block at a time, keeping only the bytes falling in the
+/// requested range. This keeps memory usage bounded for large media
+/// resources, which the webview requests by ranges. The decryptor is kept
+/// between reads, so that sequential range requests don't restart decryption
+/// from the beginning of the resource.
+///
+/// As when resources were decrypted whole, a resource that can't be decrypted
+/// is served as is.
+final class AdobeDRMResource: Resource {
+
+  /// Size of the encrypted blocks read from the underlying resource.
+  static let blockSize: UInt64 = 64 * 1024
+
+  /// Resources up to this size are kept once decrypted to compute their
+  /// length, so that reading them next doesn't decrypt them again. Larger
+  /// ones are decrypted again by ranges, to keep memory usage bounded.
+  static let maxKeptLength: UInt64 = 4 * 1024 * 1024
+
+  let link: Link
+
+  private let resource: Resource
+  private let container: AdobeDRMContainer
+  private let path: String
+
+  /// Protects the decryption state below, as Readium may read a resource
+  /// from several threads.
+  private let lock = NSLock()
+  private var decryptor: AdobeDRMStreamDecryptor?
+  /// Offset of the next encrypted byte to pass to `decryptor`.
+  private var encryptedOffset: UInt64 = 0
+  /// Offset in the decrypted resource of the first byte of `lastChunk`.
+  private var lastChunkOffset: UInt64 = 0
+  /// The last decrypted chunk, kept to serve ranges starting inside it.
+  private var lastChunk = Data()
+  private var decryptedLength: UInt64?
+  /// The whole decrypted resource, if `length` had to decrypt it and it is
+  /// small enough to be kept.
+  private var decryptedData: Data?
+  /// Set once decryption failed: the resource is then served as is.
+  private var decryptionFailed = false
+
+  //----------------------------------------------------------------------------
+  /// - Parameters:
+  ///   - resource: The encrypted resource, as read from the .epub archive.
+  ///   - container: Container with the DRM information of the publication.
+  ///   - path: Path of the resource inside the .epub, as listed in
+  ///   `encryption.xml`.
+  init(resource: Resource, container: AdobeDRMContainer, path: String) {
+    self.link = resource.link
+    self.resource = resource
+    self.container = container
+    self.path = path
+  }
+
+  var file: URL? {
+    // the file on disk is encrypted
+    return nil
+  }
+
+  var length: ResourceResult<UInt64> {
+    guard container.isEncrypted(at: path) else {
+      return resource.length
+    }
+    if let originalLength = link.properties.encryption?.originalLength {
+      return .success(UInt64(originalLength))
+    }
+
+    lock.lock()
+    defer { lock.unlock() }
+
+    if let decryptedLength = decryptedLength {
+      return .success(decryptedLength)
+    }
+    if decryptionFailed {
+      return resource.length
+    }
+
+    // the length is only known once the whole resource is decrypted: keep it
+    // if it's small, since it's likely to be read next
+    switch decrypt(range: 0..<AdobeDRMResource.maxKeptLength + 1) {
+    case .success(let data):
+      if let decryptedLength = decryptedLength {
+        decryptedData = data
+        return .success(decryptedLength)
+      }
+    case .failure(let error):
+      return decryptionFailed ? resource.length : .failure(error)
+    }
+
+    // count the remaining bytes without keeping them
+    let result = decrypt(range: UInt64.max..<UInt64.max)
+    if decryptionFailed {
+      return resource.length
+    }
+    return result.map { _ in decryptedLength ?? 0 }
+  }
+
+  func read(range: Range<UInt64>?) -> ResourceResult<Data> {
+    guard container.isEncrypted(at: path) else {
+      return resource.read(range: range)
+    }
+
+    lock.lock()
+    defer { lock.unlock() }
+
+    if let data = decryptedData {
+      return .success(slice(of: data, in: range ?? 0..<UInt64.max))
+    }
+
+    if !decryptionFailed {
+      let result = decrypt(range: range ?? 0..<UInt64.max)
+      if !decryptionFailed {
+        return result
+      }
+    }
+    return resource.read(range: range)
+  }
+
+  func close() {
+    lock.lock()
+    decryptor = nil
+    lastChunk = Data()
+    decryptedData = nil
+    lock.unlock()
+
+    resource.close()
+  }
+
+  // MARK: - Private
+
+  //----------------------------------------------------------------------------
+  /// Decrypts the resource up to the end of `range`, collecting the bytes
+  /// falling in `range`. Must be called while holding `lock`.
+  private func decrypt(range: Range<UInt64>) -> ResourceResult<Data> {
+    if decryptor == nil || range.lowerBound < lastChunkOffset {
+      if let error = restartDecryption() {
+        return .failure(error)
+      }
+    }
+
+    guard let decryptor = decryptor else {
+      return .failure(decryptionFailure(container.epubDecodingError))
+    }
+
+    let encryptedLength: UInt64
+    switch resource.length {
+    case .success(let length):
+      encryptedLength = length
+    case .failure(let error):
+      return .failure(error)
+    }
+
+    var output = Data()
+    if let expectedLength = link.properties.encryption?.originalLength {
+      let end = min(range.upperBound, UInt64(expectedLength))
+      if end > range.lowerBound {
+        output.reserveCapacity(Int(end - range.lowerBound))
+      }
+    }
+    collect(range: range, from: lastChunk, at: lastChunkOffset, into: &output)
+
+    while lastChunkOffset + UInt64(lastChunk.count) < range.upperBound
+            && !decryptor.finished {
+      let blockEnd = min(encryptedOffset + AdobeDRMResource.blockSize, encryptedLength)
+      let block: Data
+      switch resource.read(range: encryptedOffset..<blockEnd) {
+      case .success(let data):
+        block = data
+      case .failure(let error):
+        self.decryptor = nil
+        return .failure(error)
+      }
+
+      guard let chunk = decryptor.decryptBlock(block, final: blockEnd == encryptedLength) else {
+        self.decryptor = nil
+        return .failure(decryptionFailure(decryptor.error))
+      }
+
+      encryptedOffset = blockEnd
+      lastChunkOffset += UInt64(lastChunk.count)
+      lastChunk = chunk
+      collect(range: range, from: chunk, at: lastChunkOffset, into: &output)
+    }
+
+    if decryptor.finished {
+      decryptedLength = lastChunkOffset + UInt64(lastChunk.count)
+    }
+
+    return .success(output)
+  }
+
+  //----------------------------------------------------------------------------
+  /// Starts decrypting the resource from its beginning.
+  /// - Returns: An error if the decryptor couldn't be created.
+  private func restartDecryption() -> ResourceError? {
+    encryptedOffset = 0
+    lastChunkOffset = 0
+    lastChunk = Data()
+    decryptor = nil
+
+    guard let newDecryptor = container.streamDecryptor(at: path) else {
+      return decryptionFailure(container.epubDecodingError)
+    }
+
+    decryptor = newDecryptor
+    return nil
+  }
+
+  //----------------------------------------------------------------------------
+  /// Records that the resource can't be decrypted, so that it is served as
+  /// is from now on.
+  private func decryptionFailure(_ message: String?) -> ResourceError {
+    let description = message ?? "Unknown Adobe DRM decryption error"
+    Log.error(#file, "Adobe DRM decryption failed for \(path): \(description)")
+    decryptionFailed = true
+    return .other(NSError(domain: "AdobeDRMResource",
+                          code: 0,
+                          userInfo: [NSLocalizedDescriptionKey: description]))
+  }
+
+  //----------------------------------------------------------------------------
+  private func slice(of data: Data, in range: Range<UInt64>) -> Data {
+    var output = Data()
+    collect(range: range, from: data, at: 0, into: &output)
+    return output
+  }
+
+  //----------------------------------------------------------------------------
+  /// Appends to `output` the bytes of `chunk` that fall in `range`, `chunk`
+  /// starting at `offset` in the decrypted resource.
+  private func collect(range: Range<UInt64>,
+                       from chunk: Data,
+                       at offset: UInt64,
+                       into output: inout Data) {
+    let chunkEnd = offset + UInt64(chunk.count)
+    let start = max(range.lowerBound, offset)
+    let end = min(range.upperBound, chunkEnd)
+    guard start < end else {
+      return
+    }
+
+    let lower = chunk.startIndex + Int(start - offset)
+    let upper = chunk.startIndex + Int(end - offset)
+    output.append(chunk[lower..<upper])
+  }
+}
+
+#endif
@@ -0,0 +1,138 @@
+//
+//  NYPLAxisResourceCache.swift
+//  Simplified
+//
+//  Copyright © 2026 NYPL. All rights reserved.
+//
+
+import UIKit
+import R2Shared
+
+/// Keeps the decrypted and decompressed resources of an Axis publication in
+/// memory, keyed by href, so that Readium reading the same spine items and
+/// stylesheets again (e.g. while paginating or computing positions) doesn't
+/// pay for AES decryption and inflating every time.
+///
+/// The cache is emptied on memory warnings.
+final class NYPLAxisResourceCache {
+
+  /// Default memory budget for the resources of one publication.
+  static let defaultCostLimit = 32 * 1024 * 1024
+
+  /// Resources larger than this are not cached.
+  static let maximumResourceLength = 4 * 1024 * 1024
+
+  private let cache: NYPLLRUCache<String, Data>
+  private var memoryWarningObserver: NSObjectProtocol?
+
+  //----------------------------------------------------------------------------
+  /// - Parameter costLimit: The maximum number of bytes of resources the
+  /// cache can hold.
+  init(costLimit: Int = NYPLAxisResourceCache.defaultCostLimit) {
+    self.cache = NYPLLRUCache(costLimit: costLimit)
+    self.memoryWarningObserver = NotificationCenter.default.addObserver(
+      forName: UIApplication.didReceiveMemoryWarningNotification,
+      object: nil,
+      queue: nil) { [weak self] _ in
+        self?.cache.removeAll()
+    }
+  }
+
+  deinit {
+    if let observer = memoryWarningObserver {
+      NotificationCenter.default.removeObserver(observer)
+    }
+  }
+
+  var hitCount: Int {
+    return cache.hitCount
+  }
+
+  var missCount: Int {
+    return cache.missCount
+  }
+
+  func data(forHref href: String) -> Data? {
+    return cache.value(forKey: href)
+  }
+
+  func setData(_ data: Data, forHref href: String) {
+    cache.setValue(data, forKey: href, cost: data.count)
+  }
+
+  func removeAll() {
+    cache.removeAll()
+  }
+
+  //----------------------------------------------------------------------------
+  /// Wraps `resource` so that its decrypted content is served from, and
+  /// stored into, this cache.
+  func cachingResource(_ resource: Resource) -> Resource {
+    return NYPLAxisCachedResource(resource: resource, cache: self)
+  }
+}
+
+/// A resource reading its whole content once from the wrapped (decrypting)
+/// resource, then serving every read from the publication's cache.
+private final class NYPLAxisCachedResource: Resource {
+
+  private let resource: Resource
+  private let cache: NYPLAxisResourceCache
+
+  init(resource: Resource, cache: NYPLAxisResourceCache) {
+    self.resource = resource
+    self.cache = cache
+  }
+
+  var link: Link {
+    return resource.link
+  }
+
+  var file: URL? {
+    return resource.file
+  }
+
+  var length: ResourceResult<UInt64> {
+    if let data = cache.data(forHref: link.href) {
+      return .success(UInt64(data.count))
+    }
+    return resource.length
+  }
+
+  func read(range: Range<UInt64>?) -> ResourceResult<Data> {
+    // large resources such as media are better served by range, straight
+    // from the decoding resource
+    if let originalLength = link.properties.encryption?.originalLength,
+       originalLength > NYPLAxisResourceCache.maximumResourceLength {
+      return resource.read(range: range)
+    }
+
+    let data: Data
+    if let cachedData = cache.data(forHref: link.href) {
+      data = cachedData
+    } else {
+      // decrypting requires the whole resource anyway, so read all of it
+      // once and keep it for later reads
+      switch resource.read(range: nil) {
+      case .success(let readData):
+        data = readData
+        cache.setData(readData, forHref: link.href)
+      case .failure(let error):
+        return .failure(error)
+      }
+    }
+
+    guard let range = range else {
+      return .success(data)
+    }
+
+    let length = UInt64(data.count)
+    let lower = Int(min(range.lowerBound, length))
+    let upper = Int(min(range.upperBound, length))
+    return .success(data.subdata(in: (data.startIndex + lower)..<(data.startIndex + upper)))
+  }
+
+  func close() {
+    resource.close()
+  }
+}
@@ -0,0 +1,113 @@
+//
+//  NYPLAxisStreamingResource.swift
+//  Simplified
+//
+//  Copyright © 2026 NYPL. All rights reserved.
+//
+
+import Foundation
+import R2Shared
+
+/// An encrypted AxisNow resource, decrypted and inflated on demand by
+/// `NYPLAxisStreamingContentDecoder`.
+///
+/// Range reads only decode the resource up to the end of the range, and only
+/// the requested bytes are kept. The original data is returned if the
+/// resource can't be decoded.
+final class NYPLAxisStreamingResource: Resource {
+
+  private let resource: Resource
+  private let decoder: NYPLAxisStreamingContentDecoder
+
+  /// Decoded length, computed the first time it's needed when the
+  /// publication doesn't provide it.
+  private var decodedLength: UInt64?
+  private let lock = NSLock()
+
+  //----------------------------------------------------------------------------
+  init(resource: Resource, decoder: NYPLAxisStreamingContentDecoder) {
+    self.resource = resource
+    self.decoder = decoder
+  }
+
+  var link: Link {
+    return resource.link
+  }
+
+  var file: URL? {
+    // the file on disk is encrypted
+    return nil
+  }
+
+  var length: ResourceResult<UInt64> {
+    if let originalLength = link.properties.encryption?.originalLength {
+      return .success(UInt64(originalLength))
+    }
+
+    lock.lock()
+    let knownLength = decodedLength
+    lock.unlock()
+    if let knownLength = knownLength {
+      return .success(knownLength)
+    }
+
+    // decode the whole resource without keeping it, just to count the bytes
+    var count: UInt64 = 0
+    do {
+      try decode { chunk in
+        count += UInt64(chunk.count)
+        return true
+      }
+    } catch {
+      return resource.length
+    }
+
+    lock.lock()
+    decodedLength = count
+    lock.unlock()
+    return .success(count)
+  }
+
+  func read(range requestedRange: Range<UInt64>?) -> ResourceResult<Data> {
+    let range = requestedRange ?? 0..<UInt64.max
+    var output = Data()
+    if let originalLength = link.properties.encryption?.originalLength {
+      let end = min(range.upperBound, UInt64(originalLength))
+      if end > range.lowerBound {
+        output.reserveCapacity(Int(end - range.lowerBound))
+      }
+    }
+
+    var offset: UInt64 = 0
+    do {
+      try decode { chunk in
+        let chunkEnd = offset + UInt64(chunk.count)
+        let start = max(range.lowerBound, offset)
+        let end = min(range.upperBound, chunkEnd)
+        if start < end {
+          output.append(chunk[Int(start - offset)..<Int(end - offset)])
+        }
+        offset = chunkEnd
+        return offset < range.upperBound
+      }
+    } catch {
+      return resource.read(range: requestedRange)
+    }
+
+    return .success(output)
+  }
+
+  func close() {
+    resource.close()
+  }
+
+  // MARK: - Private
+
+  //----------------------------------------------------------------------------
+  private func decode(output: (Data) -> Bool) throws {
+    let encryptedLength = try resource.length.get()
+    try decoder.decode(encryptedLength: encryptedLength,
+                       read: { try resource.read(range: $0).get() },
+                       output: output)
+  }
+}
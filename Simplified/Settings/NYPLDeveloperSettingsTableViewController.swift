@@ -4,6 +4,7 @@ import Foundation
 /// can then log in and adjust settings after selecting Accounts.
 @objcMembers class NYPLDeveloperSettingsTableViewController: UIViewController, UITableViewDelegate, UITableViewDataSource {
   weak var tableView: UITableView!
+  private var downloadMetrics = [NYPLDownloadMetricsSummary]()
 
   required init() {
     super.init(nibName: nil, bundle: nil)
@@ -30,6 +31,10 @@ import Foundation
     NYPLSettings.shared.useBetaLibraries = sender.isOn
   }
 
+  func segmentedDownloadsSwitchDidChange(sender: UISwitch!) {
+    NYPLSettings.shared.useSegmentedDownloads = sender.isOn
+  }
+
   // MARK:- UIViewController
   
   override func loadView() {
@@ -41,20 +46,34 @@ import Foundation
     self.title = NSLocalizedString("Testing", comment: "Developer Settings")
     self.view.backgroundColor = NYPLConfiguration.primaryBackgroundColor
   }
+
+  override func viewWillAppear(_ animated: Bool) {
+    super.viewWillAppear(animated)
+    downloadMetrics = NYPLDownloadMetrics.shared.summaries()
+    tableView.reloadData()
+  }
   
   // MARK:- UITableViewDataSource
   
   func tableView(_ tableView: UITableView, numberOfRowsInSection section: Int) -> Int {
-    return 1
+    switch section {
+    case 1: return 1 + downloadMetrics.count
+    default: return 1
+    }
   }
   
   func numberOfSections(in tableView: UITableView) -> Int {
-    return 2
+    return 3
   }
   
   func tableView(_ tableView: UITableView, cellForRowAt indexPath: IndexPath) -> UITableViewCell {
     switch indexPath.section {
     case 0: return cellForBetaLibraries()
+    case 1:
+      if indexPath.row == 0 {
+        return cellForSegmentedDownloads()
+      }
+      return cellForDownloadMetrics(downloadMetrics[indexPath.row - 1])
     default: return cellForClearCache()
     }
   }
@@ -63,6 +82,8 @@ import Foundation
     switch section {
     case 0:
       return "Library Settings"
+    case 1:
+      return "Downloads"
     default:
       return "Data Management"
     }
@@ -79,6 +100,25 @@ import Foundation
     return cell
   }
 
+  private func cellForSegmentedDownloads() -> UITableViewCell {
+    let cell = UITableViewCell(style: UITableViewCell.CellStyle.default, reuseIdentifier: "segmentedDownloadsCell")
+    cell.selectionStyle = .none
+    cell.textLabel?.text = "Enable segmented downloads"
+    let segmentedDownloadsSwitch = UISwitch()
+    segmentedDownloadsSwitch.setOn(NYPLSettings.shared.useSegmentedDownloads, animated: false)
+    segmentedDownloadsSwitch.addTarget(self, action:#selector(segmentedDownloadsSwitchDidChange), for:.valueChanged)
+    cell.accessoryView = segmentedDownloadsSwitch
+    return cell
+  }
+
+  private func cellForDownloadMetrics(_ summary: NYPLDownloadMetricsSummary) -> UITableViewCell {
+    let cell = UITableViewCell(style: UITableViewCell.CellStyle.subtitle, reuseIdentifier: "downloadMetricsCell")
+    cell.selectionStyle = .none
+    cell.textLabel?.text = "\(summary.distributor) (\(summary.mode.name))"
+    cell.detailTextLabel?.text = summary.statistics
+    return cell
+  }
+
   private func cellForClearCache() -> UITableViewCell {
     let cell = UITableViewCell(style: UITableViewCell.CellStyle.default, reuseIdentifier: "clearCacheCell")
     cell.selectionStyle = .none
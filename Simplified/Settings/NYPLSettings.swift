@@ -28,6 +28,7 @@ import Foundation
   static let userHasAcceptedEULAKey = "NYPLSettingsUserAcceptedEULA"
   static private let userSeenFirstTimeSyncMessageKey = "userSeenFirstTimeSyncMessageKey"
   static private let useBetaLibrariesKey = "NYPLUseBetaLibrariesKey"
+  static private let useSegmentedDownloadsKey = "NYPLUseSegmentedDownloadsKey"
   static let settingsLibraryAccountsKey = "NYPLSettingsLibraryAccountsKey"
   static private let versionKey = "NYPLSettingsVersionKey"
   
@@ -113,6 +114,18 @@ import Foundation
     }
   }
 
+  /// Whether large DRM-free books are downloaded over several connections
+  /// when the server supports range requests.
+  var useSegmentedDownloads: Bool {
+    get {
+      return UserDefaults.standard.bool(forKey: NYPLSettings.useSegmentedDownloadsKey)
+    }
+    set(b) {
+      UserDefaults.standard.set(b, forKey: NYPLSettings.useSegmentedDownloadsKey)
+      UserDefaults.standard.synchronize()
+    }
+  }
+
   var appVersion: String? {
     get {
       return UserDefaults.standard.string(forKey: NYPLSettings.versionKey)
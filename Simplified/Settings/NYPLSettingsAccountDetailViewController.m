@@ -1252,8 +1252,11 @@ didSelectRowAtIndexPath:(NSIndexPath *const)indexPath
     UILabel *titleLabel = [[UILabel alloc] init];
     UILabel *subtitleLabel = [[UILabel alloc] init];
     subtitleLabel.numberOfLines = 0;
-    UIImageView *logoView = [[UIImageView alloc] initWithImage:self.selectedAccount.logo];
+    UIImageView *logoView = [[UIImageView alloc] initWithImage:[UIImage imageNamed:@"LibraryLogoMagic"]];
     logoView.contentMode = UIViewContentModeScaleAspectFit;
+    [self.selectedAccount loadLogoWithCompletion:^(UIImage *logo) {
+      logoView.image = logo;
+    }];
 
     titleLabel.text = self.selectedAccount.name;
     titleLabel.font = [UIFont systemFontOfSize:14];
@@ -249,8 +249,9 @@ import UIKit
     let textContainer = UIView()
     
     cell.accessoryType = .disclosureIndicator
-    let imageView = UIImageView(image: account.logo)
+    let imageView = UIImageView(image: NYPLLibraryLogoCache.placeholder)
     imageView.contentMode = .scaleAspectFit
+    account.loadLogo { imageView.image = $0 }
     
     let textLabel = UILabel()
     textLabel.font = UIFont.systemFont(ofSize: 14)
@@ -0,0 +1,154 @@
+//
+//  NYPLMainThreadStallMonitor.swift
+//  Simplified
+//
+//  Copyright © 2026 NYPL. All rights reserved.
+//
+
+import Foundation
+import Dispatch
+
+/// Measures how responsive the main thread is while some activity is
+/// ongoing, e.g. while books are being downloaded.
+///
+/// While running, the monitor regularly schedules an empty block on the main
+/// queue from a background queue and measures how long it takes to run. Any
+/// delay longer than `threshold` is counted as a stall. A summary is logged
+/// when the monitor is stopped, so that runs of the same activity can be
+/// compared before and after a change.
+@objcMembers final class NYPLMainThreadStallMonitor: NSObject {
+
+  /// A name for the monitored activity, used in the logs.
+  let name: String
+
+  /// The minimum delay, in seconds, to be considered a stall.
+  let threshold: TimeInterval
+
+  /// How often, in seconds, the main thread is checked.
+  let interval: TimeInterval
+
+  private let queue = DispatchQueue(label: "org.nypl.labs.SimplyE.NYPLMainThreadStallMonitor.queue",
+                                    qos: .utility)
+  private var timer: DispatchSourceTimer?
+  private var isCheckPending = false
+  private var startTime: DispatchTime?
+  private var stalls = 0
+  private var longest: TimeInterval = 0
+  private var total: TimeInterval = 0
+
+  //----------------------------------------------------------------------------
+  init(name: String, threshold: TimeInterval = 0.05, interval: TimeInterval = 0.02) {
+    self.name = name
+    self.threshold = threshold
+    self.interval = interval
+    super.init()
+  }
+
+  /// The number of stalls recorded since the monitor was last started.
+  var stallCount: Int {
+    return queue.sync { stalls }
+  }
+
+  /// The longest stall, in seconds, since the monitor was last started.
+  var longestStall: TimeInterval {
+    return queue.sync { longest }
+  }
+
+  /// The sum of all stalls, in seconds, since the monitor was last started.
+  var totalStallDuration: TimeInterval {
+    return queue.sync { total }
+  }
+
+  var isRunning: Bool {
+    return queue.sync { timer != nil }
+  }
+
+  //----------------------------------------------------------------------------
+  /// Resets the recorded stalls and starts monitoring. Does nothing if the
+  /// monitor is already running.
+  func start() {
+    queue.sync {
+      guard timer == nil else {
+        return
+      }
+
+      stalls = 0
+      longest = 0
+      total = 0
+      isCheckPending = false
+      startTime = .now()
+
+      let timer = DispatchSource.makeTimerSource(queue: queue)
+      timer.schedule(deadline: .now() + interval, repeating: interval)
+      timer.setEventHandler { [weak self] in
+        self?.checkMainThread()
+      }
+      self.timer = timer
+      timer.resume()
+    }
+  }
+
+  //----------------------------------------------------------------------------
+  /// Stops monitoring and logs a summary of the stalls recorded since the
+  /// monitor was started.
+  func stop() {
+    let summary: String? = queue.sync {
+      guard let timer = timer else {
+        return nil
+      }
+      timer.cancel()
+      self.timer = nil
+
+      let elapsed = startTime.map { seconds(from: $0, to: .now()) } ?? 0
+      return String(format: "%@: main thread stalled %d times over %.1f s, %.0f ms in total, longest %.0f ms",
+                    name, stalls, elapsed, total * 1000, longest * 1000)
+    }
+
+    if let summary = summary {
+      Log.info(#file, summary)
+    }
+  }
+
+  // MARK: - Private
+
+  //----------------------------------------------------------------------------
+  /// Must be called on `queue`. Only one check is in flight at a time, so
+  /// that a long stall is recorded once rather than once per interval.
+  private func checkMainThread() {
+    guard !isCheckPending else {
+      return
+    }
+    isCheckPending = true
+
+    let scheduled = DispatchTime.now()
+    DispatchQueue.main.async { [weak self] in
+      let ran = DispatchTime.now()
+      self?.queue.async {
+        self?.recordCheck(scheduled: scheduled, ran: ran)
+      }
+    }
+  }
+
+  //----------------------------------------------------------------------------
+  private func recordCheck(scheduled: DispatchTime, ran: DispatchTime) {
+    isCheckPending = false
+    guard timer != nil else {
+      return
+    }
+
+    let delay = seconds(from: scheduled, to: ran)
+    if delay >= threshold {
+      stalls += 1
+      total += delay
+      longest = max(longest, delay)
+    }
+  }
+
+  //----------------------------------------------------------------------------
+  private func seconds(from start: DispatchTime, to end: DispatchTime) -> TimeInterval {
+    guard end.uptimeNanoseconds > start.uptimeNanoseconds else {
+      return 0
+    }
+    return TimeInterval(end.uptimeNanoseconds - start.uptimeNanoseconds) / 1_000_000_000
+  }
+}
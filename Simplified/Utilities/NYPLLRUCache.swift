@@ -0,0 +1,212 @@
+//
+//  NYPLLRUCache.swift
+//  Simplified
+//
+//  Copyright © 2026 NYPL. All rights reserved.
+//
+
+import Foundation
+
+/// A thread-safe, in-memory, least-recently-used cache bounded by the total
+/// cost of its values, where the cost of each value is provided by the
+/// caller (typically its size in bytes).
+///
+/// Unlike `NSCache`, eviction strictly follows recency of use, and the cache
+/// keeps hit and miss counts so that its size can be tuned.
+final class NYPLLRUCache<Key: Hashable, Value> {
+
+  private final class Entry {
+    let key: Key
+    let value: Value
+    let cost: Int
+    // weak so that the list doesn't form reference cycles
+    weak var previous: Entry?
+    var next: Entry?
+
+    init(key: Key, value: Value, cost: Int) {
+      self.key = key
+      self.value = value
+      self.cost = cost
+    }
+  }
+
+  /// The maximum total cost of the values kept in the cache.
+  let costLimit: Int
+
+  private var entries = [Key: Entry]()
+  // most recently used
+  private var head: Entry?
+  // least recently used, i.e. the next to be evicted
+  private var tail: Entry?
+  private var _totalCost = 0
+  private var _hitCount = 0
+  private var _missCount = 0
+  private let lock = NSLock()
+
+  //----------------------------------------------------------------------------
+  /// - Parameter costLimit: The maximum total cost of the values the cache
+  /// can hold.
+  init(costLimit: Int) {
+    self.costLimit = costLimit
+  }
+
+  deinit {
+    // releases the entries one by one rather than recursively along the list
+    removeAll()
+  }
+
+  /// The current total cost of the values kept in the cache.
+  var totalCost: Int {
+    lock.lock()
+    defer { lock.unlock() }
+    return _totalCost
+  }
+
+  /// The number of values kept in the cache.
+  var count: Int {
+    lock.lock()
+    defer { lock.unlock() }
+    return entries.count
+  }
+
+  /// The number of lookups that found a value.
+  var hitCount: Int {
+    lock.lock()
+    defer { lock.unlock() }
+    return _hitCount
+  }
+
+  /// The number of lookups that didn't find a value.
+  var missCount: Int {
+    lock.lock()
+    defer { lock.unlock() }
+    return _missCount
+  }
+
+  //----------------------------------------------------------------------------
+  /// Looks up the value for `key`, marking it as the most recently used.
+  func value(forKey key: Key) -> Value? {
+    lock.lock()
+    defer { lock.unlock() }
+
+    guard let entry = entries[key] else {
+      _missCount += 1
+      return nil
+    }
+
+    _hitCount += 1
+    moveToHead(entry)
+    return entry.value
+  }
+
+  //----------------------------------------------------------------------------
+  /// Adds `value` to the cache, evicting the least recently used values if
+  /// needed to stay within `costLimit`. Values costing more than the limit
+  /// are not cached.
+  func setValue(_ value: Value, forKey key: Key, cost: Int) {
+    lock.lock()
+    defer { lock.unlock() }
+
+    if let existing = entries.removeValue(forKey: key) {
+      unlink(existing)
+    }
+
+    guard cost <= costLimit else {
+      return
+    }
+
+    let entry = Entry(key: key, value: value, cost: cost)
+    entries[key] = entry
+    _totalCost += cost
+    moveToHead(entry)
+
+    while _totalCost > costLimit, let lru = tail {
+      entries.removeValue(forKey: lru.key)
+      unlink(lru)
+    }
+  }
+
+  //----------------------------------------------------------------------------
+  func removeValue(forKey key: Key) {
+    lock.lock()
+    defer { lock.unlock() }
+
+    if let entry = entries.removeValue(forKey: key) {
+      unlink(entry)
+    }
+  }
+
+  //----------------------------------------------------------------------------
+  /// Removes the values whose key satisfies `shouldRemove`.
+  func removeValues(forKeysWhere shouldRemove: (Key) -> Bool) {
+    lock.lock()
+    defer { lock.unlock() }
+
+    for key in entries.keys where shouldRemove(key) {
+      if let entry = entries.removeValue(forKey: key) {
+        unlink(entry)
+      }
+    }
+  }
+
+  //----------------------------------------------------------------------------
+  func removeAll() {
+    lock.lock()
+    defer { lock.unlock() }
+
+    // break the links so that entries are released right away
+    var entry = head
+    while let current = entry {
+      entry = current.next
+      current.previous = nil
+      current.next = nil
+    }
+    entries.removeAll()
+    head = nil
+    tail = nil
+    _totalCost = 0
+  }
+
+  // MARK: - Private
+
+  //----------------------------------------------------------------------------
+  /// Must be called while holding `lock`.
+  private func moveToHead(_ entry: Entry) {
+    guard head !== entry else {
+      return
+    }
+
+    if entry.previous != nil || tail === entry {
+      // already in the list: detach it without affecting the total cost
+      entry.previous?.next = entry.next
+      entry.next?.previous = entry.previous
+      if tail === entry {
+        tail = entry.previous
+      }
+    }
+
+    entry.previous = nil
+    entry.next = head
+    head?.previous = entry
+    head = entry
+    if tail == nil {
+      tail = entry
+    }
+  }
+
+  //----------------------------------------------------------------------------
+  /// Must be called while holding `lock`.
+  private func unlink(_ entry: Entry) {
+    entry.previous?.next = entry.next
+    entry.next?.previous = entry.previous
+    if head === entry {
+      head = entry.next
+    }
+    if tail === entry {
+      tail = entry.previous
+    }
+    entry.previous = nil
+    entry.next = nil
+    _totalCost -= entry.cost
+  }
+}
@@ -23,6 +23,23 @@ suitable for handling markup (e.g. XHTML).
 
 + (instancetype)XMLWithData:(NSData *)data;
 
+/**
+ Parses @c data without keeping the whole document tree in memory.
+
+ Every child of the root element whose name is in @c names is passed to @c handler as soon as its
+ end tag is reached, and is not added to the children of the root. As a result, at most one such
+ subtree is alive at any given time while parsing.
+
+ @param data The document to parse.
+ @param names The names of the children of the root element that should be streamed.
+ @param handler Called synchronously on the parsing thread for each streamed child, in document
+ order. The child's @c parent is nil.
+ @return The root element, without the streamed children, or nil if @c data is not well-formed.
+ */
++ (instancetype)XMLWithData:(NSData *)data
+     streamingChildrenNamed:(NSSet<NSString *> *)names
+                    handler:(void (^)(NYPLXML *child))handler;
+
 - (NSArray *)childrenWithName:(NSString *)name;
 
 - (NYPLXML *)firstChildWithName:(NSString *)name;
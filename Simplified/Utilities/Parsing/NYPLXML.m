@@ -10,15 +10,37 @@
 @property (nonatomic, weak) NYPLXML *parent;
 @property (nonatomic) NSString *qualifiedName;
 
+// Shared by all the elements of a document so that repeated element names and
+// namespaces are stored only once.
+@property (nonatomic) NSMutableDictionary<NSString *, NSString *> *internedStrings;
+
+// Only set on the document node while streaming.
+@property (nonatomic, copy) NSSet<NSString *> *streamedNames;
+@property (nonatomic, copy) void (^streamingHandler)(NYPLXML *child);
+
 @end
 
+static NSString *NYPLXMLIntern(NSMutableDictionary<NSString *, NSString *> *const table,
+                               NSString *const string)
+{
+  if(!string) return nil;
+  
+  NSString *interned = table[string];
+  if(!interned) {
+    interned = [string copy];
+    table[interned] = interned;
+  }
+  return interned;
+}
+
 @implementation NYPLXML
 
 + (instancetype)XMLWithData:(NSData *const)data
 {
   if(!data) return nil;
-
+  
   NYPLXML *const document = [[self alloc] init];
+  document.internedStrings = [NSMutableDictionary dictionary];
   
   // TODO: This seemingly pointless copy appears to work around a bug with NSXMLParser that causes a
   // crash in 64-bit simulators. Calling |copy| does *not* solve the problem: It must be a mutable
@@ -27,11 +49,37 @@
   NSMutableData *const mutableData = [data mutableCopy];
   
   NSXMLParser *const parser = [[NSXMLParser alloc] initWithData:mutableData];
+  return [self rootOfDocument:document parsedWithParser:parser];
+}
+
++ (instancetype)XMLWithData:(NSData *const)data
+     streamingChildrenNamed:(NSSet<NSString *> *const)names
+                    handler:(void (^const)(NYPLXML *child))handler
+{
+  if(!data) return nil;
+  
+  NYPLXML *const document = [[self alloc] init];
+  document.internedStrings = [NSMutableDictionary dictionary];
+  document.streamedNames = names;
+  document.streamingHandler = handler;
+  
+  // Reading from a stream lets the parser consume |data| in place, which also avoids the copy
+  // needed by the workaround in |XMLWithData:|.
+  NSXMLParser *const parser = [[NSXMLParser alloc]
+                               initWithStream:[NSInputStream inputStreamWithData:data]];
+  NYPLXML *const root = [self rootOfDocument:document parsedWithParser:parser];
+  
+  document.streamingHandler = nil;
+  return root;
+}
+
++ (instancetype)rootOfDocument:(NYPLXML *const)document parsedWithParser:(NSXMLParser *const)parser
+{
   parser.delegate = document;
   parser.shouldProcessNamespaces = YES;
   [parser parse];
   
-  if(parser.parserError) {
+  if(parser.parserError || document.children.count == 0) {
     return nil;
   } else {
     NYPLXML *const root = document.children[0];
@@ -67,7 +115,15 @@
 
 - (NYPLXML *)firstChildWithName:(NSString *const)name
 {
-  return [[self childrenWithName:name] firstObject];
+  if(!name) return nil;
+  
+  for(NYPLXML *const XML in self.mutableChildren) {
+    if([name isEqualToString:XML.name]) {
+      return XML;
+    }
+  }
+  
+  return nil;
 }
 
 #pragma mark NSXMLParserDelegate
@@ -79,11 +135,12 @@ didStartElement:(NSString *const)name
     attributes:(NSDictionary *const)attributes
 {
   NYPLXML *const child = [[[self class] alloc] init];
+  child.internedStrings = self.internedStrings;
   child.attributes = attributes;
-  child.name = name;
-  child.namespaceURI = namespaceURI;
+  child.name = NYPLXMLIntern(self.internedStrings, name);
+  child.namespaceURI = NYPLXMLIntern(self.internedStrings, namespaceURI);
   child.parent = self;
-  child.qualifiedName = qualifiedName;
+  child.qualifiedName = NYPLXMLIntern(self.internedStrings, qualifiedName);
   
   if(self.mutableChildren) {
     [self.mutableChildren addObject:child];
@@ -99,7 +156,23 @@ didStartElement:(NSString *const)name
   namespaceURI:(__attribute__((unused)) NSString *)namespaceURI
  qualifiedName:(__attribute__((unused)) NSString *)qName
 {
-	parser.delegate = self.parent;
+  NYPLXML *const parent = self.parent;
+  parser.delegate = parent;
+  
+  // Only the children of the root element can be streamed, i.e. elements whose
+  // grandparent is the document node.
+  NYPLXML *const document = parent.parent;
+  if(document.streamingHandler
+     && !document.parent
+     && [document.streamedNames containsObject:self.name]) {
+    // The parent holds the only strong reference to this element: keep one
+    // until the handler is done with it.
+    NYPLXML *const child = self;
+    child.parent = nil;
+    document.streamingHandler(child);
+    // Since this element just ended, it is necessarily the last child added.
+    [parent.mutableChildren removeLastObject];
+  }
 }
 
 - (void)parser:(__attribute__((unused)) NSXMLParser *)parser
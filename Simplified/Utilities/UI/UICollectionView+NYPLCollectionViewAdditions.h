@@ -0,0 +1,7 @@
+@interface UICollectionView (NYPLCollectionViewAdditions)
+
+// Reloads the items in section 0 at |indexes|, skipping any index the collection view does not
+// currently display. Used by ungrouped feed view controllers when the feed reports updated books.
+- (void)reloadItemsInFirstSectionAtIndexes:(NSIndexSet *)indexes;
+
+@end
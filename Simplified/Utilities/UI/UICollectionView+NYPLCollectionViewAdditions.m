@@ -0,0 +1,17 @@
+#import "UICollectionView+NYPLCollectionViewAdditions.h"
+
+@implementation UICollectionView (NYPLCollectionViewAdditions)
+
+- (void)reloadItemsInFirstSectionAtIndexes:(NSIndexSet *const)indexes
+{
+  NSMutableArray *const indexPaths = [NSMutableArray arrayWithCapacity:indexes.count];
+  NSInteger const itemCount = [self numberOfItemsInSection:0];
+  [indexes enumerateIndexesUsingBlock:^(NSUInteger const i, __attribute__((unused)) BOOL *stop) {
+    if((NSInteger)i < itemCount) {
+      [indexPaths addObject:[NSIndexPath indexPathForItem:i inSection:0]];
+    }
+  }];
+  [self reloadItemsAtIndexPaths:indexPaths];
+}
+
+@end
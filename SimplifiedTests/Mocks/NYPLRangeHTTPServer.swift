@@ -0,0 +1,221 @@
+//
+//  NYPLRangeHTTPServer.swift
+//  SimplyETests
+//
+//  Copyright © 2026 NYPL. All rights reserved.
+//
+
+import Foundation
+import Network
+
+/// A request received by `NYPLRangeHTTPServer`.
+struct NYPLRangeHTTPRequest {
+  let path: String
+
+  /// Keyed by lowercased header name.
+  let headers: [String: String]
+
+  subscript(header: String) -> String? {
+    return headers[header]
+  }
+}
+
+/// A minimal HTTP server on the loopback interface serving a single resource.
+///
+/// `Range: bytes=<start>-[<end>]` requests are honored if they carry no
+/// `If-Range` header or one matching the current `ETag`, and requests whose
+/// `If-None-Match` header matches it get `304 Not Modified`. Requests for
+/// `/moved` are redirected to the resource on `localhost`, i.e. on another
+/// host than the `127.0.0.1` one of `resourceURL`, and requests for
+/// `/not-modified` always get `304 Not Modified`.
+final class NYPLRangeHTTPServer {
+  let body: Data
+  let contentType: String
+
+  /// The URL of the resource, once the server is listening.
+  private(set) var resourceURL: URL?
+
+  /// A URL redirecting to the resource on another host.
+  private(set) var movedURL: URL?
+
+  /// A URL always answered with `304 Not Modified`.
+  private(set) var notModifiedURL: URL?
+
+  var eTag: String {
+    get { return queue.sync { currentETag } }
+    set { queue.sync { currentETag = newValue } }
+  }
+
+  /// When false, range requests get the whole resource.
+  var honorsRanges: Bool {
+    get { return queue.sync { rangesHonored } }
+    set { queue.sync { rangesHonored = newValue } }
+  }
+
+  /// The `ETag` sent after the first request, if any.
+  var eTagAfterFirstRequest: String? {
+    get { return queue.sync { nextETag } }
+    set { queue.sync { nextETag = newValue } }
+  }
+
+  /// The first response whose content starts at this offset is cut short
+  /// halfway, by closing the connection.
+  var dropsFirstResponseAtOffset: Int? {
+    get { return queue.sync { droppedOffset } }
+    set { queue.sync { droppedOffset = newValue } }
+  }
+
+  var receivedRequests: [NYPLRangeHTTPRequest] {
+    return queue.sync { requests }
+  }
+
+  private let fileName: String
+  private let listener: NWListener
+  private let queue = DispatchQueue(label: "org.nypl.labs.SimplyE.NYPLRangeHTTPServer.queue")
+  private var currentETag: String
+  private var rangesHonored = true
+  private var nextETag: String?
+  private var droppedOffset: Int?
+  private var requests = [NYPLRangeHTTPRequest]()
+
+  init(body: Data, eTag: String, fileName: String, contentType: String) throws {
+    self.body = body
+    self.currentETag = eTag
+    self.fileName = fileName
+    self.contentType = contentType
+    self.listener = try NWListener(using: .tcp)
+  }
+
+  //----------------------------------------------------------------------------
+  /// - Returns: The URL of the resource, once the server is listening.
+  func start() -> URL? {
+    let ready = DispatchSemaphore(value: 0)
+    listener.stateUpdateHandler = { state in
+      if case .ready = state {
+        ready.signal()
+      }
+    }
+    listener.newConnectionHandler = { [weak self] connection in
+      guard let self = self else {
+        connection.cancel()
+        return
+      }
+      connection.start(queue: self.queue)
+      self.receiveRequest(on: connection, buffer: Data())
+    }
+    listener.start(queue: queue)
+
+    guard ready.wait(timeout: .now() + 5) == .success,
+      let port = listener.port else {
+        return nil
+    }
+    resourceURL = URL(string: "http://127.0.0.1:\(port.rawValue)/\(fileName)")
+    movedURL = URL(string: "http://127.0.0.1:\(port.rawValue)/moved")
+    notModifiedURL = URL(string: "http://127.0.0.1:\(port.rawValue)/not-modified")
+    return resourceURL
+  }
+
+  //----------------------------------------------------------------------------
+  func stop() {
+    listener.cancel()
+  }
+
+  //----------------------------------------------------------------------------
+  private func receiveRequest(on connection: NWConnection, buffer: Data) {
+    connection.receive(minimumIncompleteLength: 1, maximumLength: 64 * 1024) { data, _, isComplete, error in
+      var buffer = buffer
+      if let data = data {
+        buffer.append(data)
+      }
+      if let end = buffer.range(of: Data("\r\n\r\n".utf8)) {
+        let head = String(decoding: buffer[..<end.lowerBound], as: UTF8.self)
+        self.respond(toRequestHead: head, on: connection)
+      } else if error == nil && !isComplete {
+        self.receiveRequest(on: connection, buffer: buffer)
+      } else {
+        connection.cancel()
+      }
+    }
+  }
+
+  //----------------------------------------------------------------------------
+  private func respond(toRequestHead head: String, on connection: NWConnection) {
+    let lines = head.components(separatedBy: "\r\n")
+    let requestLine = lines.first?.split(separator: " ") ?? []
+    let path = (requestLine.count > 1) ? String(requestLine[1]) : "/"
+    var headers = [String: String]()
+    for line in lines.dropFirst() {
+      guard let colon = line.firstIndex(of: ":") else {
+        continue
+      }
+      let name = line[..<colon].lowercased()
+      headers[name] = line[line.index(after: colon)...].trimmingCharacters(in: .whitespaces)
+    }
+    requests.append(NYPLRangeHTTPRequest(path: path, headers: headers))
+
+    if path == "/moved", let port = listener.port {
+      var responseHead = "HTTP/1.1 302 Found\r\n"
+      responseHead += "Location: http://localhost:\(port.rawValue)/\(fileName)\r\n"
+      responseHead += "Content-Length: 0\r\n"
+      responseHead += "Connection: close\r\n\r\n"
+      send(Data(responseHead.utf8), on: connection)
+      return
+    }
+
+    if path == "/not-modified" || headers["if-none-match"] == currentETag {
+      var responseHead = "HTTP/1.1 304 Not Modified\r\n"
+      responseHead += "ETag: \(currentETag)\r\n"
+      responseHead += "Connection: close\r\n\r\n"
+      send(Data(responseHead.utf8), on: connection)
+      return
+    }
+
+    var range: ClosedRange<Int>?
+    if rangesHonored,
+      let value = headers["range"], value.hasPrefix("bytes="),
+      headers["if-range"] == nil || headers["if-range"] == currentETag {
+      let bounds = value.dropFirst("bytes=".count)
+        .split(separator: "-", omittingEmptySubsequences: false)
+        .map { Int($0) }
+      if bounds.count == 2, let start = bounds[0], start < body.count {
+        let end = min(bounds[1] ?? body.count - 1, body.count - 1)
+        if start <= end {
+          range = start...end
+        }
+      }
+    }
+    let content = range.map { body[$0] } ?? body
+
+    var responseHead = (range != nil) ? "HTTP/1.1 206 Partial Content\r\n" : "HTTP/1.1 200 OK\r\n"
+    responseHead += "Content-Type: \(contentType)\r\n"
+    responseHead += "Content-Length: \(content.count)\r\n"
+    if let range = range {
+      responseHead += "Content-Range: bytes \(range.lowerBound)-\(range.upperBound)/\(body.count)\r\n"
+    }
+    responseHead += "ETag: \(currentETag)\r\n"
+    responseHead += "Accept-Ranges: bytes\r\n"
+    responseHead += "Connection: close\r\n\r\n"
+
+    var payload = Data(responseHead.utf8)
+    if (range?.lowerBound ?? 0) == droppedOffset {
+      droppedOffset = nil
+      payload.append(content.prefix(content.count / 2))
+    } else {
+      payload.append(content)
+    }
+
+    if let newETag = nextETag {
+      currentETag = newETag
+      nextETag = nil
+    }
+
+    send(payload, on: connection)
+  }
+
+  //----------------------------------------------------------------------------
+  private func send(_ payload: Data, on connection: NWConnection) {
+    connection.send(content: payload, completion: .contentProcessed { _ in
+      connection.cancel()
+    })
+  }
+}
@@ -0,0 +1,299 @@
+//
+//  NYPLAudiobookDownloadSchedulerTests.swift
+//  SimplyETests
+//
+//  Copyright © 2026 NYPL. All rights reserved.
+//
+
+import XCTest
+@testable import SimplyE
+
+/// Stands in for the network service of an audiobook: it downloads
+/// `byteCount` bytes, in files of `chapterBytes` bytes, over a
+/// `NYPLSimulatedLink` while fetching. Like the real one, it throws away the
+/// file being downloaded when the fetch is cancelled.
+private final class NYPLFakeAudiobookNetworkService: NYPLAudiobookFetching {
+  let byteCount: Double
+  let chapterBytes: Double
+  var downloadedBytes: Double = 0
+  private(set) var isFetching = false
+  private(set) var fetchCount = 0
+  private(set) var cancelCount = 0
+
+  init(byteCount: Double, chapterBytes: Double) {
+    self.byteCount = byteCount
+    self.chapterBytes = chapterBytes
+  }
+
+  var isComplete: Bool {
+    return downloadedBytes >= byteCount
+  }
+
+  var completedChapterCount: Int {
+    return Int(min(downloadedBytes, byteCount) / chapterBytes)
+  }
+
+  var downloadedAmount: Double {
+    return downloadedBytes
+  }
+
+  func fetch() {
+    isFetching = true
+    fetchCount += 1
+  }
+
+  func cancelFetch() {
+    isFetching = false
+    cancelCount += 1
+    downloadedBytes = (downloadedBytes / chapterBytes).rounded(.down) * chapterBytes
+  }
+}
+
+/// A network link whose bandwidth is shared equally by the downloads running
+/// on it, each connection being limited to `connectionBandwidth`.
+private struct NYPLSimulatedLink {
+  var bandwidth: Double
+  var connectionBandwidth: Double
+}
+
+class NYPLAudiobookDownloadSchedulerTests: XCTestCase {
+  private let megabyte = 1024.0 * 1024.0
+  private var time: TimeInterval = 0
+  private var networkType = NYPLDownloadNetworkType.wifi
+  private var services = [String: NYPLFakeAudiobookNetworkService]()
+
+  override func setUp() {
+    super.setUp()
+    time = 0
+    networkType = .wifi
+    services = [:]
+  }
+
+  //----------------------------------------------------------------------------
+  private func makeScheduler(configure: (inout NYPLAudiobookDownloadScheduler.Configuration) -> Void = { _ in })
+    -> NYPLAudiobookDownloadScheduler {
+      var configuration = NYPLAudiobookDownloadScheduler.Configuration()
+      configure(&configuration)
+      return NYPLAudiobookDownloadScheduler(configuration: configuration,
+                                            networkType: { [unowned self] in self.networkType },
+                                            now: { [unowned self] in self.time })
+  }
+
+  //----------------------------------------------------------------------------
+  private func addBook(_ bookID: String,
+                       megabytes: Double,
+                       chapterMegabytes: Double = 1,
+                       priority: NYPLAudiobookDownloadPriority = .normal,
+                       to scheduler: NYPLAudiobookDownloadScheduler) {
+    let service = NYPLFakeAudiobookNetworkService(byteCount: megabytes * megabyte,
+                                                  chapterBytes: chapterMegabytes * megabyte)
+    services[bookID] = service
+    scheduler.add(bookID: bookID, fetcher: service, priority: priority)
+  }
+
+  //----------------------------------------------------------------------------
+  /// Advances the simulated time one second at a time, moving bytes over the
+  /// link, finishing completed downloads, reporting completed files and
+  /// ticking the scheduler.
+  ///
+  /// - Returns: The largest number of downloads that ran at the same time.
+  @discardableResult
+  private func simulate(_ scheduler: NYPLAudiobookDownloadScheduler,
+                        link: NYPLSimulatedLink,
+                        for duration: TimeInterval) -> Int {
+    var maxConcurrent = 0
+    let end = time + duration
+    while time < end && !scheduler.isEmpty {
+      let fetching = services.filter { $0.value.isFetching && !$0.value.isComplete }
+      maxConcurrent = max(maxConcurrent, fetching.count)
+      var completedFileBookIDs = [String]()
+      if !fetching.isEmpty {
+        let rate = min(link.connectionBandwidth, link.bandwidth / Double(fetching.count))
+        for (bookID, service) in fetching {
+          let chapterCount = service.completedChapterCount
+          service.downloadedBytes += rate
+          if service.completedChapterCount > chapterCount {
+            completedFileBookIDs.append(bookID)
+          }
+        }
+      }
+      time += 1
+
+      for (bookID, service) in services where service.isComplete && scheduler.contains(bookID) {
+        scheduler.finish(bookID)
+      }
+      for bookID in completedFileBookIDs.sorted() {
+        scheduler.fileDidComplete(for: bookID)
+      }
+      if Int(time) % Int(scheduler.configuration.tickInterval) == 0 {
+        scheduler.tick()
+      }
+    }
+    return maxConcurrent
+  }
+
+  //----------------------------------------------------------------------------
+  func testConcurrencyGrowsWithThroughputOnWiFi() {
+    let scheduler = makeScheduler()
+    for index in 0..<6 {
+      addBook("book\(index)", megabytes: 200, to: scheduler)
+    }
+    let link = NYPLSimulatedLink(bandwidth: 10 * megabyte, connectionBandwidth: 1 * megabyte)
+
+    let maxConcurrent = simulate(scheduler, link: link, for: 3600)
+
+    XCTAssertTrue(scheduler.isEmpty)
+    XCTAssertEqual(maxConcurrent, scheduler.configuration.maxConcurrentDownloadsOnWiFi)
+    // one at a time, 6 books of 200 MB at 1 MB/s would take 1200 s
+    XCTAssertLessThan(time, 600)
+  }
+
+  //----------------------------------------------------------------------------
+  func testConcurrencyStopsGrowingWhenLinkIsSaturated() {
+    let scheduler = makeScheduler { $0.initialConcurrentDownloads = 1 }
+    for index in 0..<6 {
+      addBook("book\(index)", megabytes: 500, to: scheduler)
+    }
+    let link = NYPLSimulatedLink(bandwidth: 2 * megabyte, connectionBandwidth: 1 * megabyte)
+
+    let maxConcurrent = simulate(scheduler, link: link, for: 600)
+
+    // 2 downloads saturate the link: a 3rd one is tried, then given up
+    XCTAssertEqual(maxConcurrent, 3)
+    XCTAssertEqual(scheduler.concurrencyLimit, 2)
+    XCTAssertEqual(scheduler.runningBookIDs.count, 2)
+  }
+
+  //----------------------------------------------------------------------------
+  func testCellularLimitsConcurrency() {
+    networkType = .cellular
+    let scheduler = makeScheduler()
+    for index in 0..<6 {
+      addBook("book\(index)", megabytes: 500, to: scheduler)
+    }
+    let link = NYPLSimulatedLink(bandwidth: 10 * megabyte, connectionBandwidth: 1 * megabyte)
+
+    XCTAssertEqual(simulate(scheduler, link: link, for: 300),
+                   scheduler.configuration.maxConcurrentDownloadsOnCellular)
+
+    // going back to cellular brings the downloads down
+    networkType = .wifi
+    simulate(scheduler, link: link, for: 60)
+    XCTAssertGreaterThan(scheduler.runningBookIDs.count, 2)
+    networkType = .cellular
+    scheduler.tick()
+    XCTAssertEqual(scheduler.runningBookIDs.count, 2)
+  }
+
+  //----------------------------------------------------------------------------
+  func testHighPriorityBookTakesTheSlotOfLowerPriorityOne() throws {
+    let scheduler = makeScheduler { $0.maxConcurrentDownloadsOnWiFi = 1 }
+    addBook("first", megabytes: 100, to: scheduler)
+    addBook("second", megabytes: 100, to: scheduler)
+    XCTAssertEqual(scheduler.runningBookIDs, ["first"])
+
+    addBook("urgent", megabytes: 100, priority: .high, to: scheduler)
+
+    XCTAssertEqual(scheduler.runningBookIDs, ["urgent"])
+    XCTAssertEqual(services["first"]?.cancelCount, 1)
+    XCTAssertEqual(scheduler.waitingBookIDs, ["second", "first"])
+
+    scheduler.setPriority(.low, for: "urgent")
+    XCTAssertEqual(scheduler.runningBookIDs, ["second"])
+    XCTAssertEqual(scheduler.waitingBookIDs, ["first", "urgent"])
+
+    // adding a queued book again with a higher priority raises its priority
+    let first = try XCTUnwrap(services["first"])
+    XCTAssertFalse(scheduler.add(bookID: "first", fetcher: first, priority: .high))
+    XCTAssertEqual(scheduler.runningBookIDs, ["first"])
+    XCTAssertEqual(first.fetchCount, 2)
+  }
+
+  //----------------------------------------------------------------------------
+  func testBooksOfSamePriorityTakeTurns() {
+    let scheduler = makeScheduler {
+      $0.maxConcurrentDownloadsOnWiFi = 1
+      $0.timeSlice = 30
+    }
+    addBook("first", megabytes: 1000, chapterMegabytes: 10, to: scheduler)
+    addBook("second", megabytes: 1000, chapterMegabytes: 10, to: scheduler)
+    addBook("later", megabytes: 1000, chapterMegabytes: 10, priority: .low, to: scheduler)
+    let link = NYPLSimulatedLink(bandwidth: 1 * megabyte, connectionBandwidth: 1 * megabyte)
+
+    simulate(scheduler, link: link, for: 30)
+    XCTAssertEqual(scheduler.runningBookIDs, ["second"])
+    simulate(scheduler, link: link, for: 30)
+    XCTAssertEqual(scheduler.runningBookIDs, ["first"])
+
+    XCTAssertEqual(services["first"]?.downloadedBytes, 30 * megabyte)
+    XCTAssertEqual(services["second"]?.downloadedBytes, 30 * megabyte)
+    // a lower priority book only gets a turn once the others are done
+    XCTAssertEqual(services["later"]?.fetchCount, 0)
+  }
+
+  //----------------------------------------------------------------------------
+  func testTurnsAreOnlyTakenBetweenFiles() {
+    let scheduler = makeScheduler {
+      $0.maxConcurrentDownloadsOnWiFi = 1
+      $0.timeSlice = 30
+    }
+    // each file takes longer than a time slice to download
+    addBook("first", megabytes: 200, chapterMegabytes: 100, to: scheduler)
+    addBook("second", megabytes: 200, chapterMegabytes: 100, to: scheduler)
+    let link = NYPLSimulatedLink(bandwidth: 1 * megabyte, connectionBandwidth: 1 * megabyte)
+
+    simulate(scheduler, link: link, for: 99)
+    XCTAssertEqual(scheduler.runningBookIDs, ["first"])
+    simulate(scheduler, link: link, for: 1)
+    XCTAssertEqual(scheduler.runningBookIDs, ["second"])
+    XCTAssertEqual(services["first"]?.downloadedBytes, 100 * megabyte)
+
+    simulate(scheduler, link: link, for: 1000)
+    XCTAssertTrue(scheduler.isEmpty)
+    // no partly downloaded file was thrown away
+    XCTAssertEqual(time, 400)
+    XCTAssertEqual(services["first"]?.cancelCount, 1)
+    XCTAssertEqual(services["second"]?.cancelCount, 1)
+  }
+
+  //----------------------------------------------------------------------------
+  func testPausedBookKeepsItsPlaceWithoutTakingASlot() {
+    let scheduler = makeScheduler { $0.maxConcurrentDownloadsOnWiFi = 1 }
+    addBook("first", megabytes: 20, to: scheduler)
+    addBook("second", megabytes: 20, to: scheduler)
+    addBook("third", megabytes: 20, to: scheduler)
+    let link = NYPLSimulatedLink(bandwidth: 1 * megabyte, connectionBandwidth: 1 * megabyte)
+
+    simulate(scheduler, link: link, for: 5)
+    scheduler.pause("first")
+    XCTAssertEqual(services["first"]?.isFetching, false)
+    XCTAssertEqual(scheduler.runningBookIDs, ["second"])
+    XCTAssertEqual(scheduler.pausedBookIDs, ["first"])
+    XCTAssertEqual(scheduler.waitingBookIDs, ["third"])
+
+    XCTAssertEqual(simulate(scheduler, link: link, for: 5), 1)
+    scheduler.resume("first")
+    XCTAssertFalse(scheduler.isPaused("first"))
+    XCTAssertEqual(scheduler.runningBookIDs, ["second"])
+    XCTAssertEqual(scheduler.waitingBookIDs, ["first", "third"])
+
+    simulate(scheduler, link: link, for: 100)
+    XCTAssertTrue(scheduler.isEmpty)
+    // what was downloaded before the pause is kept
+    XCTAssertEqual(time, 60)
+    XCTAssertEqual(services["first"]?.cancelCount, 1)
+  }
+
+  //----------------------------------------------------------------------------
+  func testRemoveCancelsRunningDownload() {
+    let scheduler = makeScheduler { $0.maxConcurrentDownloadsOnWiFi = 1 }
+    addBook("first", megabytes: 20, to: scheduler)
+    addBook("second", megabytes: 20, to: scheduler)
+
+    scheduler.remove("first")
+
+    XCTAssertEqual(services["first"]?.cancelCount, 1)
+    XCTAssertFalse(scheduler.contains("first"))
+    XCTAssertEqual(scheduler.runningBookIDs, ["second"])
+  }
+}
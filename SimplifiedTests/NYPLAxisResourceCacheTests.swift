@@ -0,0 +1,75 @@
+//
+//  NYPLAxisResourceCacheTests.swift
+//  SimplyETests
+//
+//  Copyright © 2026 NYPL. All rights reserved.
+//
+
+import XCTest
+import R2Shared
+@testable import SimplyE
+
+/// Stands in for the decrypting resource, counting how many times it had to
+/// transform its content.
+private class CountingResource: TransformingResource {
+  var transformCount = 0
+
+  override func transform(_ data: ResourceResult<Data>) -> ResourceResult<Data> {
+    transformCount += 1
+    return data
+  }
+}
+
+class NYPLAxisResourceCacheTests: XCTestCase {
+  let content = Data("<html><body>chapter</body></html>".utf8)
+
+  private func makeResource(href: String) -> CountingResource {
+    return CountingResource(DataResource(link: Link(href: href), data: content))
+  }
+
+  func testRepeatedReadsAreServedFromCache() throws {
+    let cache = NYPLAxisResourceCache()
+    let counting = makeResource(href: "/chapter1.xhtml")
+    let resource = cache.cachingResource(counting)
+
+    XCTAssertEqual(try resource.read().get(), content)
+    XCTAssertEqual(try resource.read(range: 6..<12).get(), content.subdata(in: 6..<12))
+
+    // a new resource for the same href, as Readium creates on every fetch
+    let reopened = cache.cachingResource(makeResource(href: "/chapter1.xhtml"))
+    XCTAssertEqual(try reopened.read().get(), content)
+    XCTAssertEqual(try reopened.length.get(), UInt64(content.count))
+
+    XCTAssertEqual(counting.transformCount, 1)
+    XCTAssertEqual(cache.missCount, 1)
+  }
+
+  func testRangesAreClampedToContent() throws {
+    let cache = NYPLAxisResourceCache()
+    let resource = cache.cachingResource(makeResource(href: "/style.css"))
+
+    let tail = try resource.read(range: 20..<UInt64(content.count + 100)).get()
+    XCTAssertEqual(tail, content.subdata(in: 20..<content.count))
+    XCTAssertEqual(try resource.read(range: 1000..<2000).get(), Data())
+  }
+
+  func testEvictsLeastRecentlyUsedResources() throws {
+    let cache = NYPLAxisResourceCache(costLimit: content.count * 2)
+    for href in ["/a.xhtml", "/b.xhtml", "/c.xhtml"] {
+      _ = try cache.cachingResource(makeResource(href: href)).read().get()
+    }
+
+    XCTAssertNil(cache.data(forHref: "/a.xhtml"))
+    XCTAssertNotNil(cache.data(forHref: "/b.xhtml"))
+    XCTAssertNotNil(cache.data(forHref: "/c.xhtml"))
+  }
+
+  func testMemoryWarningEmptiesCache() throws {
+    let cache = NYPLAxisResourceCache()
+    _ = try cache.cachingResource(makeResource(href: "/a.xhtml")).read().get()
+
+    NotificationCenter.default.post(name: UIApplication.didReceiveMemoryWarningNotification,
+                                    object: nil)
+    XCTAssertNil(cache.data(forHref: "/a.xhtml"))
+  }
+}
@@ -0,0 +1,196 @@
+//
+//  NYPLAxisStreamingContentDecoderTests.swift
+//  SimplyETests
+//
+//  Copyright © 2026 NYPL. All rights reserved.
+//
+
+import XCTest
+import CommonCrypto
+import Compression
+import R2Shared
+@testable import SimplyE
+
+class NYPLAxisStreamingContentDecoderTests: XCTestCase {
+
+  /// A synthetic Axis resource: `plaintext` compressed with raw DEFLATE,
+  /// then encrypted with AES-256-CBC with the IV prepended.
+  struct Fixture {
+    let key: Data
+    let plaintext: Data
+    let encrypted: Data
+  }
+
+  static func makeFixture(size: Int) -> Fixture {
+    var plaintext = Data(capacity: size)
+    var paragraph = 0
+    while plaintext.count < size {
+      plaintext.append(contentsOf: "<p id=\"p\(paragraph)\">Lorem ipsum dolor sit amet, consectetur adipiscing elit, sed do eiusmod tempor \(paragraph * 7919 % 10007).</p>\n".utf8)
+      paragraph += 1
+    }
+    return makeFixture(plaintext: plaintext.prefix(size))
+  }
+
+  static func makeFixture(plaintext: Data) -> Fixture {
+    var compressed = Data(count: plaintext.count + 1024)
+    let compressedCount = compressed.withUnsafeMutableBytes { dst in
+      plaintext.withUnsafeBytes { src in
+        compression_encode_buffer(dst.bindMemory(to: UInt8.self).baseAddress!, dst.count,
+                                  src.bindMemory(to: UInt8.self).baseAddress!, src.count,
+                                  nil, COMPRESSION_ZLIB)
+      }
+    }
+    compressed.count = compressedCount
+
+    let key = Data((0..<kCCKeySizeAES256).map { UInt8($0 * 13 & 0xff) })
+    let iv = Data((0..<kCCBlockSizeAES128).map { UInt8($0 * 29 & 0xff) })
+    var ciphertext = Data(count: compressed.count + kCCBlockSizeAES128)
+    var ciphertextCount = 0
+    let status = ciphertext.withUnsafeMutableBytes { out in
+      compressed.withUnsafeBytes { input in
+        key.withUnsafeBytes { keyBytes in
+          iv.withUnsafeBytes { ivBytes in
+            CCCrypt(CCOperation(kCCEncrypt), CCAlgorithm(kCCAlgorithmAES),
+                    CCOptions(kCCOptionPKCS7Padding),
+                    keyBytes.baseAddress, keyBytes.count, ivBytes.baseAddress,
+                    input.baseAddress, input.count,
+                    out.baseAddress, out.count, &ciphertextCount)
+          }
+        }
+      }
+    }
+    precondition(status == kCCSuccess)
+    ciphertext.count = ciphertextCount
+
+    return Fixture(key: key, plaintext: plaintext, encrypted: iv + ciphertext)
+  }
+
+  private func makeResource(_ fixture: Fixture, originalLength: Int? = nil) -> Resource {
+    let encryption = Encryption(algorithm: "http://www.w3.org/2001/04/xmlenc#aes256-cbc",
+                                originalLength: originalLength)
+    let link = Link(href: "/chapter.xhtml",
+                    properties: Properties(["encrypted": encryption.json]))
+    return NYPLAxisStreamingResource(
+      resource: DataResource(link: link, data: fixture.encrypted),
+      decoder: NYPLAxisStreamingContentDecoder(key: fixture.key))
+  }
+
+  // MARK: - Correctness
+
+  func testDecodesWholeResource() throws {
+    let fixture = NYPLAxisStreamingContentDecoderTests.makeFixture(size: 300_000)
+    let resource = makeResource(fixture)
+
+    XCTAssertEqual(try resource.read().get(), fixture.plaintext)
+    XCTAssertEqual(try resource.length.get(), UInt64(fixture.plaintext.count))
+  }
+
+  func testDecodesRanges() throws {
+    let fixture = NYPLAxisStreamingContentDecoderTests.makeFixture(size: 300_000)
+    let resource = makeResource(fixture, originalLength: fixture.plaintext.count)
+
+    XCTAssertEqual(try resource.read(range: 0..<10).get(),
+                   fixture.plaintext.subdata(in: 0..<10))
+    XCTAssertEqual(try resource.read(range: 150_000..<200_123).get(),
+                   fixture.plaintext.subdata(in: 150_000..<200_123))
+    XCTAssertEqual(try resource.read(range: 299_990..<400_000).get(),
+                   fixture.plaintext.subdata(in: 299_990..<300_000))
+  }
+
+  func testStopsDecodingAfterRequestedRange() throws {
+    let fixture = NYPLAxisStreamingContentDecoderTests.makeFixture(size: 1_000_000)
+    let decoder = NYPLAxisStreamingContentDecoder(key: fixture.key)
+    var bytesRead = 0
+
+    try decoder.decode(
+      encryptedLength: UInt64(fixture.encrypted.count),
+      read: { range in
+        bytesRead += Int(range.count)
+        return fixture.encrypted.subdata(in: Int(range.lowerBound)..<Int(range.upperBound))
+      },
+      output: { _ in false })
+
+    XCTAssertLessThanOrEqual(bytesRead, NYPLAxisStreamingContentDecoder.chunkSize + 16)
+  }
+
+  func testFallsBackToOriginalDataWhenNotDecodable() throws {
+    var fixture = NYPLAxisStreamingContentDecoderTests.makeFixture(size: 1000)
+    fixture = Fixture(key: Data(count: kCCKeySizeAES256),
+                      plaintext: fixture.plaintext,
+                      encrypted: fixture.encrypted)
+    let resource = makeResource(fixture)
+
+    XCTAssertEqual(try resource.read().get(), fixture.encrypted)
+  }
+
+  /// The previous pipeline, which decrypts, then inflates, the whole resource.
+  private func decodeWithAdapterChain(_ fixture: Fixture) throws -> Data? {
+    let cypher = try XCTUnwrap(NYPLAxisBookContentDecryptionAdapter()?.cypher)
+    return cypher.decryptWithAES(fixture.encrypted, key: fixture.key).flatMap {
+      NYPLAxisDecompressor().decompress(sourceData: $0)
+    }
+  }
+
+  func testMatchesAdapterChainOutput() throws {
+    // Axis content can't be shipped with the tests, so documents of the test
+    // bundle are encrypted the way Axis does.
+    let bundle = Bundle(for: NYPLAxisStreamingContentDecoderTests.self)
+    let documentURLs = [
+      bundle.url(forResource: "main", withExtension: "xml"),
+      bundle.url(forResource: "valid", withExtension: "xml"),
+      bundle.url(forResource: "nypl_authentication_document", withExtension: "json"),
+      bundle.url(forResource: "OPDS2CatalogsFeed", withExtension: "json"),
+    ]
+    var fixtures = try documentURLs.map {
+      NYPLAxisStreamingContentDecoderTests.makeFixture(plaintext: try Data(contentsOf: try XCTUnwrap($0)))
+    }
+    // sizes around the chunk size of the streaming decoder
+    let chunkSize = NYPLAxisStreamingContentDecoder.chunkSize
+    for size in [1, chunkSize - 1, chunkSize, chunkSize + 1, 3 * chunkSize + 17] {
+      fixtures.append(NYPLAxisStreamingContentDecoderTests.makeFixture(size: size))
+    }
+
+    for fixture in fixtures {
+      let expected = try XCTUnwrap(try decodeWithAdapterChain(fixture))
+      XCTAssertEqual(expected, fixture.plaintext)
+      XCTAssertEqual(try makeResource(fixture).read().get(), expected)
+    }
+  }
+
+  // MARK: - Benchmarks
+
+  // Run both benchmarks to compare the streaming pipeline with the previous
+  // adapter chain. The memory metric reports the peak physical memory (RSS)
+  // of each run.
+
+  private let benchmarkSize = 8 * 1024 * 1024
+
+  private func benchmark(fixture: Fixture, decode: @escaping () -> Data?) {
+    let block = {
+      XCTAssertEqual(decode(), fixture.plaintext)
+    }
+
+    if #available(iOS 13.0, *) {
+      measure(metrics: [XCTClockMetric(), XCTMemoryMetric()], block: block)
+    } else {
+      measure(block)
+    }
+  }
+
+  func testAdapterChainPerformance() throws {
+    let fixture = NYPLAxisStreamingContentDecoderTests.makeFixture(size: benchmarkSize)
+
+    benchmark(fixture: fixture) {
+      try? self.decodeWithAdapterChain(fixture)
+    }
+  }
+
+  func testStreamingPipelinePerformance() throws {
+    let fixture = NYPLAxisStreamingContentDecoderTests.makeFixture(size: benchmarkSize)
+    let resource = makeResource(fixture, originalLength: fixture.plaintext.count)
+
+    benchmark(fixture: fixture) {
+      try? resource.read().get()
+    }
+  }
+}
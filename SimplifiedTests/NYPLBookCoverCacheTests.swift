@@ -0,0 +1,135 @@
+//
+//  NYPLBookCoverCacheTests.swift
+//  SimplyETests
+//
+//  Copyright © 2026 NYPL. All rights reserved.
+//
+
+import XCTest
+@testable import SimplyE
+
+class NYPLBookCoverCacheTests: XCTestCase {
+
+  /// A 10x10 opaque bitmap, i.e. a cost of 400 bytes.
+  private func makeImage() -> UIImage {
+    let format = UIGraphicsImageRendererFormat()
+    format.scale = 1
+    let renderer = UIGraphicsImageRenderer(size: CGSize(width: 10, height: 10),
+                                           format: format)
+    return renderer.image { context in
+      UIColor.red.setFill()
+      context.fill(CGRect(x: 0, y: 0, width: 10, height: 10))
+    }
+  }
+
+  private func cost(of image: UIImage) -> Int {
+    let cgImage = image.cgImage!
+    return cgImage.bytesPerRow * cgImage.height
+  }
+
+  func testHitsAndMisses() {
+    let image = makeImage()
+    let cache = NYPLBookCoverCache(costLimit: cost(of: image) * 4)
+
+    XCTAssertNil(cache.image(forKey: "a"))
+    cache.setImage(image, forKey: "a")
+    XCTAssertTrue(cache.image(forKey: "a") === image)
+
+    XCTAssertEqual(cache.hitCount, 1)
+    XCTAssertEqual(cache.missCount, 1)
+    XCTAssertEqual(cache.totalCost, cost(of: image))
+  }
+
+  func testEvictsLeastRecentlyUsedWhenOverCost() {
+    let image = makeImage()
+    let cache = NYPLBookCoverCache(costLimit: cost(of: image) * 2)
+
+    cache.setImage(image, forKey: "a")
+    cache.setImage(image, forKey: "b")
+    // touch "a" so that "b" becomes the least recently used
+    XCTAssertNotNil(cache.image(forKey: "a"))
+    cache.setImage(image, forKey: "c")
+
+    XCTAssertNotNil(cache.image(forKey: "a"))
+    XCTAssertNil(cache.image(forKey: "b"))
+    XCTAssertNotNil(cache.image(forKey: "c"))
+    XCTAssertEqual(cache.totalCost, cost(of: image) * 2)
+  }
+
+  func testReplacingAndRemovingKeepsCostAccurate() {
+    let image = makeImage()
+    let cache = NYPLBookCoverCache(costLimit: cost(of: image) * 2)
+
+    cache.setImage(image, forKey: "a")
+    cache.setImage(image, forKey: "a")
+    XCTAssertEqual(cache.totalCost, cost(of: image))
+
+    cache.removeImage(forKey: "a")
+    XCTAssertEqual(cache.totalCost, 0)
+    XCTAssertNil(cache.image(forKey: "a"))
+
+    cache.setImage(image, forKey: "b")
+    cache.removeAllImages()
+    XCTAssertEqual(cache.totalCost, 0)
+    XCTAssertNil(cache.image(forKey: "b"))
+  }
+
+  func testImagesOverCostLimitAreNotCached() {
+    let image = makeImage()
+    let cache = NYPLBookCoverCache(costLimit: cost(of: image) - 1)
+
+    cache.setImage(image, forKey: "a")
+    XCTAssertNil(cache.image(forKey: "a"))
+    XCTAssertEqual(cache.totalCost, 0)
+  }
+
+  func testBookImagesAreKeyedByURL() throws {
+    let image = makeImage()
+    let cache = NYPLBookCoverCache(costLimit: cost(of: image) * 4)
+    let oldURL = try XCTUnwrap(URL(string: "https://example.com/old.jpg"))
+    let newURL = try XCTUnwrap(URL(string: "https://example.com/new.jpg"))
+
+    cache.setImage(image, forKey: NYPLBookCoverCache.key(forBookIdentifier: "book",
+                                                         imageURL: oldURL))
+    XCTAssertNil(cache.image(forKey: NYPLBookCoverCache.key(forBookIdentifier: "book",
+                                                            imageURL: newURL)))
+    XCTAssertNotNil(cache.image(forKey: NYPLBookCoverCache.key(forBookIdentifier: "book",
+                                                               imageURL: oldURL)))
+  }
+
+  func testRemovingBookImages() throws {
+    let image = makeImage()
+    let cache = NYPLBookCoverCache(costLimit: cost(of: image) * 4)
+    let url = try XCTUnwrap(URL(string: "https://example.com/cover.jpg"))
+    let bookKey = NYPLBookCoverCache.key(forBookIdentifier: "book", imageURL: url)
+    let otherBookKey = NYPLBookCoverCache.key(forBookIdentifier: "book2", imageURL: url)
+    cache.setImage(image, forKey: bookKey)
+    cache.setImage(image, forKey: otherBookKey)
+
+    cache.removeImages(forBookIdentifier: "book")
+
+    XCTAssertNil(cache.image(forKey: bookKey))
+    XCTAssertNotNil(cache.image(forKey: otherBookKey))
+    XCTAssertEqual(cache.totalCost, cost(of: image))
+  }
+
+  func testDecodingDownsamplesLargeImages() throws {
+    let format = UIGraphicsImageRendererFormat()
+    format.scale = 1
+    let renderer = UIGraphicsImageRenderer(size: CGSize(width: 200, height: 300),
+                                           format: format)
+    let data = renderer.pngData { context in
+      UIColor.blue.setFill()
+      context.fill(CGRect(x: 0, y: 0, width: 200, height: 300))
+    }
+
+    let decoded = try XCTUnwrap(NYPLBookCoverCache.decodedImage(from: data,
+                                                                 maxPixelSize: 150))
+    XCTAssertEqual(decoded.cgImage?.height, 150)
+    XCTAssertEqual(decoded.cgImage?.width, 100)
+
+    XCTAssertNil(NYPLBookCoverCache.decodedImage(from: Data([1, 2, 3]),
+                                                 maxPixelSize: 150))
+    XCTAssertNil(NYPLBookCoverCache.decodedImage(from: nil, maxPixelSize: 150))
+  }
+}
@@ -0,0 +1,148 @@
+//
+//  NYPLBookDownloadResumeTests.swift
+//  SimplyETests
+//
+//  Copyright © 2026 NYPL. All rights reserved.
+//
+
+import XCTest
+@testable import SimplyE
+
+class NYPLBookDownloadResumeTests: XCTestCase {
+  let bookIdentifier = "urn:isbn:9781234567897"
+  let body = Data((0..<(512 * 1024)).map { UInt8(truncatingIfNeeded: $0 &* 31) })
+  var directoryURL: URL!
+  var session: URLSession!
+  var server: NYPLRangeHTTPServer!
+  var bookURL: URL!
+
+  override func setUpWithError() throws {
+    try super.setUpWithError()
+    directoryURL = FileManager.default.temporaryDirectory
+      .appendingPathComponent("NYPLBookDownloadResumeTests-\(UUID().uuidString)")
+    session = URLSession(configuration: .ephemeral)
+    server = try NYPLRangeHTTPServer(body: body,
+                                     eTag: "\"v1\"",
+                                     fileName: "book.epub",
+                                     contentType: "application/epub+zip")
+    // the first full response is cut short by closing the connection
+    server.dropsFirstResponseAtOffset = 0
+    bookURL = try XCTUnwrap(server.start())
+  }
+
+  override func tearDown() {
+    session.invalidateAndCancel()
+    server.stop()
+    try? FileManager.default.removeItem(at: directoryURL)
+    super.tearDown()
+  }
+
+  //----------------------------------------------------------------------------
+  /// Starts downloading the book and saves the resume data produced when the
+  /// server drops the connection.
+  private func saveInterruptedDownload() throws -> URLSessionDownloadTask {
+    let interrupted = expectation(description: "download interrupted")
+    var resumeData: Data?
+    var downloadError: Error?
+    let task = session.downloadTask(with: bookURL) { location, _, error in
+      XCTAssertNil(location)
+      downloadError = error
+      resumeData = (error as NSError?)?.userInfo[NSURLSessionDownloadTaskResumeData] as? Data
+      interrupted.fulfill()
+    }
+    task.resume()
+    wait(for: [interrupted], timeout: 10)
+
+    XCTAssertNotNil(downloadError)
+    NYPLBookDownloadResumeStore(directoryURL: directoryURL)
+      .setResumeData(try XCTUnwrap(resumeData),
+                     forBookIdentifier: bookIdentifier,
+                     url: bookURL,
+                     response: task.response,
+                     offset: task.countOfBytesReceived,
+                     expectedLength: task.countOfBytesExpectedToReceive)
+    return task
+  }
+
+  //----------------------------------------------------------------------------
+  private func download(withResumeData resumeData: Data) -> Data? {
+    let finished = expectation(description: "download finished")
+    var downloaded: Data?
+    session.downloadTask(withResumeData: resumeData) { location, _, error in
+      XCTAssertNil(error)
+      downloaded = location.flatMap { try? Data(contentsOf: $0) }
+      finished.fulfill()
+    }.resume()
+    wait(for: [finished], timeout: 10)
+    return downloaded
+  }
+
+  //----------------------------------------------------------------------------
+  func testDownloadResumesAfterConnectionDrop() throws {
+    let interruptedTask = try saveInterruptedDownload()
+    let offset = interruptedTask.countOfBytesReceived
+    XCTAssertGreaterThan(offset, 0)
+
+    // a new store finds what was saved, as it would after a relaunch
+    let store = NYPLBookDownloadResumeStore(directoryURL: directoryURL)
+    XCTAssertEqual(store.progress(forBookIdentifier: bookIdentifier, url: bookURL),
+                   Double(offset) / Double(body.count),
+                   accuracy: 0.001)
+    let resumeData = try XCTUnwrap(store.resumeData(forBookIdentifier: bookIdentifier,
+                                                    url: bookURL))
+
+    XCTAssertEqual(download(withResumeData: resumeData), body)
+
+    let requests = server.receivedRequests
+    XCTAssertEqual(requests.count, 2)
+    XCTAssertNil(requests.first?["range"])
+    XCTAssertEqual(requests.last?["range"], "bytes=\(offset)-")
+    XCTAssertEqual(requests.last?["if-range"], "\"v1\"")
+  }
+
+  //----------------------------------------------------------------------------
+  func testDownloadStartsOverWhenResourceChanged() throws {
+    _ = try saveInterruptedDownload()
+    server.eTag = "\"v2\""
+
+    let store = NYPLBookDownloadResumeStore(directoryURL: directoryURL)
+    let resumeData = try XCTUnwrap(store.resumeData(forBookIdentifier: bookIdentifier,
+                                                    url: bookURL))
+
+    // the server ignores the range and the stale partial file is discarded
+    XCTAssertEqual(download(withResumeData: resumeData), body)
+    XCTAssertEqual(server.receivedRequests.last?["if-range"], "\"v1\"")
+  }
+
+  //----------------------------------------------------------------------------
+  func testResumeDataIsOnlyKeptForTheSameURL() throws {
+    _ = try saveInterruptedDownload()
+    let store = NYPLBookDownloadResumeStore(directoryURL: directoryURL)
+    let otherURL = try XCTUnwrap(URL(string: "https://example.com/other.epub"))
+
+    XCTAssertNil(store.resumeData(forBookIdentifier: bookIdentifier, url: otherURL))
+    XCTAssertEqual(store.progress(forBookIdentifier: bookIdentifier, url: otherURL), 0)
+    XCTAssertNil(store.resumeData(forBookIdentifier: "other", url: bookURL))
+
+    store.removeResumeData(forBookIdentifier: bookIdentifier)
+    XCTAssertNil(store.resumeData(forBookIdentifier: bookIdentifier, url: bookURL))
+  }
+
+  //----------------------------------------------------------------------------
+  func testResumeDataWithoutValidatorsIsNotKept() throws {
+    let store = NYPLBookDownloadResumeStore(directoryURL: directoryURL)
+    let response = try XCTUnwrap(HTTPURLResponse(url: bookURL,
+                                                 statusCode: 200,
+                                                 httpVersion: nil,
+                                                 headerFields: ["Content-Length": "100"]))
+
+    store.setResumeData(Data([1, 2, 3]),
+                        forBookIdentifier: bookIdentifier,
+                        url: bookURL,
+                        response: response,
+                        offset: 50,
+                        expectedLength: 100)
+
+    XCTAssertNil(store.resumeData(forBookIdentifier: bookIdentifier, url: bookURL))
+  }
+}
@@ -0,0 +1,137 @@
+//
+//  NYPLBookRegistryChangeTests.swift
+//  SimplyETests
+//
+//  Copyright © 2026 NYPL. All rights reserved.
+//
+
+import XCTest
+@testable import SimplyE
+
+class NYPLBookRegistryChangeTests: XCTestCase {
+  let registry = NYPLBookRegistry.shared()
+  let identifiers = (0..<300).map { "urn:simplye:test:registry-change:\($0)" }
+  var notifications = [Notification]()
+  var observer: NSObjectProtocol?
+
+  override func setUp() {
+    super.setUp()
+    drainMainQueue()
+    observer = NotificationCenter.default.addObserver(
+      forName: .NYPLBookRegistryDidChange,
+      object: registry,
+      queue: nil) { [weak self] in
+        self?.notifications.append($0)
+    }
+  }
+
+  override func tearDown() {
+    if let observer = observer {
+      NotificationCenter.default.removeObserver(observer)
+    }
+    for identifier in identifiers {
+      registry.removeBook(forIdentifier: identifier)
+    }
+    drainMainQueue()
+    super.tearDown()
+  }
+
+  private func drainMainQueue() {
+    let drained = expectation(description: "main queue drained")
+    OperationQueue.main.addOperation {
+      drained.fulfill()
+    }
+    wait(for: [drained], timeout: 5)
+  }
+
+  private func makeBook(identifier: String) -> NYPLBook {
+    let emptyUrl = URL(fileURLWithPath: "")
+    let acquisition = NYPLOPDSAcquisition(
+      relation: .generic,
+      type: "application/epub+zip",
+      hrefURL: emptyUrl,
+      indirectAcquisitions: [NYPLOPDSIndirectAcquisition](),
+      availability: NYPLOPDSAcquisitionAvailabilityUnlimited())
+    return NYPLBook(
+      acquisitions: [acquisition],
+      bookAuthors: [NYPLBookAuthor](),
+      categoryStrings: [String](),
+      distributor: "",
+      identifier: identifier,
+      imageURL: emptyUrl,
+      imageThumbnailURL: emptyUrl,
+      published: Date(),
+      publisher: "",
+      subtitle: "",
+      summary: "",
+      title: identifier,
+      updated: Date(),
+      annotationsURL: emptyUrl,
+      analyticsURL: emptyUrl,
+      alternateURL: emptyUrl,
+      relatedWorksURL: emptyUrl,
+      seriesURL: emptyUrl,
+      revokeURL: emptyUrl,
+      report: emptyUrl)
+  }
+
+  private func addBooks() {
+    for identifier in identifiers {
+      registry.add(makeBook(identifier: identifier),
+                   location: nil,
+                   state: NYPLBookState.DownloadNeeded.rawValue,
+                   fulfillmentId: nil,
+                   readiumBookmarks: nil,
+                   audiobookBookmarks: nil,
+                   genericBookmarks: nil)
+    }
+  }
+
+  private func changes(in notification: Notification?) -> [String: NYPLBookRegistryChange]? {
+    guard let changes = notification?.userInfo?[NYPLNotificationKeys.bookRegistryChangesKey]
+      as? [String: NSNumber] else {
+        return nil
+    }
+    return changes.mapValues { NYPLBookRegistryChange(rawValue: $0.uintValue) }
+  }
+
+  func testChangesAreCoalescedIntoOneNotification() {
+    addBooks()
+    registry.setStateWithCode(NYPLBookState.Downloading.rawValue, forIdentifier: identifiers[0])
+    registry.update(makeBook(identifier: identifiers[1]))
+    registry.removeBook(forIdentifier: identifiers[2])
+    drainMainQueue()
+
+    XCTAssertEqual(notifications.count, 1)
+    let changes = self.changes(in: notifications.first)
+    XCTAssertEqual(changes?.count, identifiers.count)
+    XCTAssertEqual(changes?[identifiers[0]], .state)
+    XCTAssertEqual(changes?[identifiers[1]], [.state, .metadata])
+    XCTAssertEqual(changes?[identifiers[2]], [.state, .removed])
+  }
+
+  func testLaterChangesAreReportedSeparately() {
+    addBooks()
+    drainMainQueue()
+    notifications.removeAll()
+
+    registry.setLocation(NYPLBookLocation(locationString: "{}", renderer: "test"),
+                         forIdentifier: identifiers[3])
+    drainMainQueue()
+
+    XCTAssertEqual(notifications.count, 1)
+    XCTAssertEqual(changes(in: notifications.first) ?? [:], [identifiers[3]: .location])
+  }
+
+  func testUnchangedRecordsAreNotBroadcast() {
+    addBooks()
+    drainMainQueue()
+    notifications.removeAll()
+
+    registry.setFulfillmentId("fulfillment", forIdentifier: identifiers[4])
+    registry.setStateWithCode(NYPLBookState.DownloadNeeded.rawValue, forIdentifier: identifiers[4])
+    drainMainQueue()
+
+    XCTAssertEqual(notifications.count, 0)
+  }
+}
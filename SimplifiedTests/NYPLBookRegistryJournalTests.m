@@ -0,0 +1,180 @@
+@import XCTest;
+
+#import "NYPLBook.h"
+#import "NYPLBookLocation.h"
+#import "NYPLBookRegistryJournal.h"
+#import "NYPLBookRegistryRecord.h"
+
+@interface NYPLBookRegistryJournalTests : XCTestCase
+
+@property (nonatomic) NSURL *directoryURL;
+@property (nonatomic) NYPLBookRegistryRecord *record;
+
+@end
+
+@implementation NYPLBookRegistryJournalTests
+
+- (void)setUp
+{
+  [super setUp];
+
+  self.directoryURL = [[NSURL fileURLWithPath:NSTemporaryDirectory()]
+                       URLByAppendingPathComponent:[NSUUID UUID].UUIDString];
+  [[NSFileManager defaultManager] createDirectoryAtURL:self.directoryURL
+                           withIntermediateDirectories:YES
+                                            attributes:nil
+                                                 error:NULL];
+
+  NYPLBook *const book = [[NYPLBook alloc] initWithDictionary:@{
+    @"categories" : @[@"Fantasy"],
+    @"id": @"666",
+    @"title": @"The Lord of the Rings",
+    @"updated": @"2020-09-08T09:22:45Z"
+  }];
+  self.record = [[NYPLBookRegistryRecord alloc] initWithDictionary:@{
+    @"metadata": [book dictionaryRepresentation],
+    @"state": @"download-needed"
+  }];
+}
+
+- (void)tearDown
+{
+  [[NSFileManager defaultManager] removeItemAtURL:self.directoryURL error:NULL];
+  self.directoryURL = nil;
+  self.record = nil;
+
+  [super tearDown];
+}
+
+- (NSMutableDictionary *)snapshot
+{
+  return [NSMutableDictionary dictionaryWithObject:self.record forKey:@"666"];
+}
+
+- (NSURL *)journalURL
+{
+  return [self.directoryURL URLByAppendingPathComponent:@"registry.journal"];
+}
+
+- (void)testReplayAppliesFlushedEntries
+{
+  NYPLBookRegistryJournal *const journal = [[NYPLBookRegistryJournal alloc]
+                                            initWithDirectoryURL:self.directoryURL];
+  [journal replayOntoRecords:[self snapshot] snapshotSequence:0];
+
+  NYPLBookLocation *const location = [[NYPLBookLocation alloc] initWithLocationString:@"loc"
+                                                                             renderer:@"test"];
+  [journal appendOperation:NYPLBookRegistryJournalOperationLocation
+                identifier:@"666"
+                     value:[location dictionaryRepresentation]];
+  [journal appendOperation:NYPLBookRegistryJournalOperationFulfillmentId
+                identifier:@"666"
+                     value:@"fulfillment"];
+  [journal appendOperation:NYPLBookRegistryJournalOperationAddGenericBookmark
+                identifier:@"666"
+                     value:[location dictionaryRepresentation]];
+  XCTAssertEqual(journal.entriesSinceSnapshot, 3U);
+  XCTAssertTrue([journal flush]);
+
+  NSMutableDictionary *const records = [self snapshot];
+  NYPLBookRegistryJournal *const reloaded = [[NYPLBookRegistryJournal alloc]
+                                             initWithDirectoryURL:self.directoryURL];
+  [reloaded replayOntoRecords:records snapshotSequence:0];
+
+  NYPLBookRegistryRecord *const record = records[@"666"];
+  XCTAssertEqualObjects(record.location.locationString, @"loc");
+  XCTAssertEqualObjects(record.fulfillmentId, @"fulfillment");
+  XCTAssertEqual(record.genericBookmarks.count, 1U);
+  XCTAssertEqual(reloaded.lastSequence, 3U);
+  XCTAssertEqual(reloaded.entriesSinceSnapshot, 3U);
+}
+
+- (void)testUnflushedEntriesAreNotPersisted
+{
+  NYPLBookRegistryJournal *const journal = [[NYPLBookRegistryJournal alloc]
+                                            initWithDirectoryURL:self.directoryURL];
+  [journal appendOperation:NYPLBookRegistryJournalOperationRemove
+                identifier:@"666"
+                     value:nil];
+
+  NSMutableDictionary *const records = [self snapshot];
+  [[[NYPLBookRegistryJournal alloc] initWithDirectoryURL:self.directoryURL]
+   replayOntoRecords:records snapshotSequence:0];
+  XCTAssertNotNil(records[@"666"]);
+}
+
+- (void)testReplaySkipsEntriesFoldedIntoSnapshot
+{
+  NYPLBookRegistryJournal *const journal = [[NYPLBookRegistryJournal alloc]
+                                            initWithDirectoryURL:self.directoryURL];
+  [journal appendOperation:NYPLBookRegistryJournalOperationFulfillmentId
+                identifier:@"666"
+                     value:@"old"];
+  [journal appendOperation:NYPLBookRegistryJournalOperationRemove
+                identifier:@"666"
+                     value:nil];
+  [journal appendOperation:NYPLBookRegistryJournalOperationPut
+                identifier:@"666"
+                     value:[self.record dictionaryRepresentation]];
+  XCTAssertTrue([journal flush]);
+
+  NSMutableDictionary *const records = [self snapshot];
+  NYPLBookRegistryJournal *const reloaded = [[NYPLBookRegistryJournal alloc]
+                                             initWithDirectoryURL:self.directoryURL];
+  [reloaded replayOntoRecords:records snapshotSequence:1];
+
+  XCTAssertNotNil(records[@"666"]);
+  XCTAssertNil(((NYPLBookRegistryRecord *)records[@"666"]).fulfillmentId);
+  XCTAssertEqual(reloaded.entriesSinceSnapshot, 2U);
+}
+
+- (void)testTornTrailingEntryIsDiscarded
+{
+  NYPLBookRegistryJournal *const journal = [[NYPLBookRegistryJournal alloc]
+                                            initWithDirectoryURL:self.directoryURL];
+  [journal appendOperation:NYPLBookRegistryJournalOperationFulfillmentId
+                identifier:@"666"
+                     value:@"kept"];
+  XCTAssertTrue([journal flush]);
+  NSData *const validData = [NSData dataWithContentsOfURL:[self journalURL]];
+
+  NSMutableData *const tornData = [validData mutableCopy];
+  [tornData appendData:[@"{\"seq\":2,\"op\":\"remo" dataUsingEncoding:NSUTF8StringEncoding]];
+  XCTAssertTrue([tornData writeToURL:[self journalURL] atomically:YES]);
+
+  NSMutableDictionary *const records = [self snapshot];
+  NYPLBookRegistryJournal *const reloaded = [[NYPLBookRegistryJournal alloc]
+                                             initWithDirectoryURL:self.directoryURL];
+  [reloaded replayOntoRecords:records snapshotSequence:0];
+
+  XCTAssertEqualObjects(((NYPLBookRegistryRecord *)records[@"666"]).fulfillmentId, @"kept");
+  XCTAssertEqual(reloaded.lastSequence, 1U);
+  XCTAssertEqualObjects([NSData dataWithContentsOfURL:[self journalURL]], validData);
+}
+
+- (void)testCompactionDropsFoldedEntries
+{
+  NYPLBookRegistryJournal *const journal = [[NYPLBookRegistryJournal alloc]
+                                            initWithDirectoryURL:self.directoryURL];
+  [journal appendOperation:NYPLBookRegistryJournalOperationFulfillmentId
+                identifier:@"666"
+                     value:@"first"];
+  [journal appendOperation:NYPLBookRegistryJournalOperationFulfillmentId
+                identifier:@"666"
+                     value:@"second"];
+  XCTAssertTrue([journal flush]);
+
+  XCTAssertTrue([journal compactUpToSequence:1]);
+  XCTAssertEqual(journal.entriesSinceSnapshot, 1U);
+
+  NSMutableDictionary *const records = [self snapshot];
+  [[[NYPLBookRegistryJournal alloc] initWithDirectoryURL:self.directoryURL]
+   replayOntoRecords:records snapshotSequence:1];
+  XCTAssertEqualObjects(((NYPLBookRegistryRecord *)records[@"666"]).fulfillmentId, @"second");
+
+  XCTAssertTrue([journal compactUpToSequence:2]);
+  XCTAssertEqual(journal.entriesSinceSnapshot, 0U);
+  XCTAssertFalse([[NSFileManager defaultManager] fileExistsAtPath:[self journalURL].path]);
+}
+
+@end
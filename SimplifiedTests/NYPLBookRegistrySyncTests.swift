@@ -0,0 +1,164 @@
+//
+//  NYPLBookRegistrySyncTests.swift
+//  SimplyETests
+//
+//  Copyright © 2026 NYPL. All rights reserved.
+//
+
+import XCTest
+@testable import SimplyE
+
+class NYPLBookRegistrySyncTests: XCTestCase {
+  let registry = NYPLBookRegistry.shared()
+  var entries: [NYPLOPDSEntry]!
+  var notifications = [Notification]()
+  var observer: NSObjectProtocol?
+
+  override func setUpWithError() throws {
+    try super.setUpWithError()
+    entries = try makeLoansEntries(count: 1000)
+    drainMainQueue()
+    observer = NotificationCenter.default.addObserver(
+      forName: .NYPLBookRegistryDidChange,
+      object: registry,
+      queue: nil) { [weak self] in
+        self?.notifications.append($0)
+    }
+  }
+
+  override func tearDown() {
+    if let observer = observer {
+      NotificationCenter.default.removeObserver(observer)
+    }
+    _ = registry.applyLoansFeedEntries([])
+    drainMainQueue()
+    super.tearDown()
+  }
+
+  private func drainMainQueue() {
+    let drained = expectation(description: "main queue drained")
+    OperationQueue.main.addOperation {
+      drained.fulfill()
+    }
+    wait(for: [drained], timeout: 5)
+  }
+
+  /// A loans-sized feed, made by repeating the entries of `main.xml` with
+  /// distinct identifiers.
+  private func makeLoansEntries(count: Int) throws -> [NYPLOPDSEntry] {
+    let url = try XCTUnwrap(Bundle(for: NYPLBookRegistrySyncTests.self)
+      .url(forResource: "main", withExtension: "xml"))
+    let xml = try String(contentsOf: url, encoding: .utf8)
+    let entriesStart = try XCTUnwrap(xml.range(of: "<entry"))
+    let feedEnd = try XCTUnwrap(xml.range(of: "</feed>"))
+    let header = xml[..<entriesStart.lowerBound]
+    let entriesXML = String(xml[entriesStart.lowerBound..<feedEnd.lowerBound])
+
+    var body = ""
+    for copy in 0..<(count / 146 + 1) {
+      body += entriesXML.replacingOccurrences(of: "<id>", with: "<id>loans-\(copy)-")
+    }
+    let parser = NYPLOPDSFeedParser(data: Data((header + body + "</feed>").utf8))
+    XCTAssertTrue(parser.parse())
+    let entries = try XCTUnwrap(parser.feed?.entries as? [NYPLOPDSEntry])
+    return Array(entries.prefix(count))
+  }
+
+  private func entry(_ entry: NYPLOPDSEntry, updatedAt date: Date) throws -> NYPLOPDSEntry {
+    var dictionary = entry.dictionaryRepresentation()
+    dictionary["updated"] = date
+    return try XCTUnwrap(NYPLOPDSEntry(dictionary: dictionary))
+  }
+
+  func testUnchangedFeedLeavesRecordsUntouched() {
+    XCTAssertGreaterThanOrEqual(registry.applyLoansFeedEntries(entries), entries.count)
+    let book = registry.book(forIdentifier: entries[0].identifier)
+    XCTAssertNotNil(book)
+    drainMainQueue()
+    notifications.removeAll()
+
+    XCTAssertEqual(registry.applyLoansFeedEntries(entries), 0)
+    drainMainQueue()
+
+    XCTAssertEqual(notifications.count, 0)
+    XCTAssert(registry.book(forIdentifier: entries[0].identifier) === book)
+  }
+
+  func testOnlyChangedEntriesAreApplied() throws {
+    _ = registry.applyLoansFeedEntries(entries)
+    drainMainQueue()
+    notifications.removeAll()
+
+    var changedEntries = entries!
+    changedEntries[1] = try entry(entries[1], updatedAt: Date())
+    changedEntries.removeLast()
+
+    XCTAssertEqual(registry.applyLoansFeedEntries(changedEntries), 2)
+    drainMainQueue()
+
+    XCTAssertEqual(notifications.count, 1)
+    let changes = notifications.first?.userInfo?[NYPLNotificationKeys.bookRegistryChangesKey]
+      as? [String: NSNumber]
+    XCTAssertEqual(Set((changes ?? [:]).keys),
+                   [entries[1].identifier, entries[entries.count - 1].identifier])
+    XCTAssertNil(registry.book(forIdentifier: entries[entries.count - 1].identifier))
+  }
+
+  // MARK: - Benchmarks
+
+  func testLoansFeedValidatorsAreSavedAndLoaded() throws {
+    let directoryURL = FileManager.default.temporaryDirectory
+      .appendingPathComponent("NYPLBookRegistrySyncTests-\(UUID().uuidString)")
+    try FileManager.default.createDirectory(at: directoryURL, withIntermediateDirectories: true)
+    defer {
+      try? FileManager.default.removeItem(at: directoryURL)
+    }
+    let validators = ["ETag": "\"v1\"", "Last-Modified": "Wed, 21 Oct 2026 07:28:00 GMT"]
+
+    XCTAssertTrue(NYPLBookRegistry.saveLoansFeedValidators(validators, inDirectory: directoryURL))
+    XCTAssertEqual(NYPLBookRegistry.loansFeedValidators(inDirectory: directoryURL), validators)
+
+    XCTAssertTrue(NYPLBookRegistry.saveLoansFeedValidators(nil, inDirectory: directoryURL))
+    XCTAssertNil(NYPLBookRegistry.loansFeedValidators(inDirectory: directoryURL))
+  }
+
+  func testLoansFeedValidatorsSurviveUsingAnotherAccount() throws {
+    let otherAccount = "urn:simplye:test:registry-sync:other-account"
+    let otherDirectoryURL = try XCTUnwrap(NYPLBookContentMetadataFilesHelper
+      .directory(for: otherAccount)?.appendingPathComponent("registry"))
+    try FileManager.default.createDirectory(at: otherDirectoryURL, withIntermediateDirectories: true)
+    defer {
+      try? FileManager.default.removeItem(at: otherDirectoryURL.deletingLastPathComponent())
+    }
+    let otherValidators = ["ETag": "\"other\""]
+    XCTAssertTrue(NYPLBookRegistry.saveLoansFeedValidators(otherValidators,
+                                                           inDirectory: otherDirectoryURL))
+    let validators = ["ETag": "\"current\""]
+    _ = registry.applyLoansFeedEntries(entries, validators: validators)
+
+    var validatorsOfOtherAccount: [String: String]?
+    registry.perform(usingAccount: otherAccount) {
+      validatorsOfOtherAccount = self.registry.loansFeedValidators
+    }
+
+    XCTAssertEqual(validatorsOfOtherAccount, otherValidators)
+    XCTAssertEqual(registry.loansFeedValidators, validators)
+  }
+
+  func testFullSyncPerformance() {
+    measureMetrics([.wallClockTime], automaticallyStartMeasuring: false) {
+      _ = registry.applyLoansFeedEntries([])
+      startMeasuring()
+      _ = registry.applyLoansFeedEntries(entries)
+      stopMeasuring()
+    }
+  }
+
+  func testUnchangedSyncPerformance() {
+    _ = registry.applyLoansFeedEntries(entries)
+
+    measure {
+      XCTAssertEqual(registry.applyLoansFeedEntries(entries), 0)
+    }
+  }
+}
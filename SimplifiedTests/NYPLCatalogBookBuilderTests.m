@@ -0,0 +1,89 @@
+@import XCTest;
+
+#import "NYPLBook.h"
+#import "NYPLBookRegistry.h"
+#import "NYPLCatalogBookBuilder.h"
+#import "NYPLNull.h"
+#import "NYPLOPDSEntry.h"
+#import "NYPLOPDSFeed.h"
+#import "NYPLXML.h"
+
+@interface NYPLCatalogBookBuilderTests : XCTestCase
+
+@property (nonatomic) NSArray<NYPLOPDSEntry *> *entries;
+
+@end
+
+@implementation NYPLCatalogBookBuilderTests
+
+- (void)setUp
+{
+  [super setUp];
+  
+  NSData *const data =
+    [NSData dataWithContentsOfFile:
+     [[NSBundle bundleForClass:[self class]] pathForResource:@"main" ofType:@"xml"]];
+  assert(data);
+  
+  NYPLOPDSFeed *const feed = [[NYPLOPDSFeed alloc] initWithXML:[NYPLXML XMLWithData:data]];
+  assert(feed);
+  
+  // Several copies of the feed, so that it is split into several ranges.
+  NSMutableArray *const entries = [NSMutableArray array];
+  for(NSUInteger i = 0; i < 8; ++i) {
+    [entries addObjectsFromArray:feed.entries];
+  }
+  self.entries = entries;
+}
+
+- (void)tearDown
+{
+  [super tearDown];
+  
+  self.entries = nil;
+}
+
+- (void)testBooksAreInEntryOrder
+{
+  NSArray *const booksOrNulls = [NYPLCatalogBookBuilder booksOrNullsWithEntries:self.entries];
+  
+  XCTAssertEqual(booksOrNulls.count, self.entries.count);
+  for(NSUInteger i = 0; i < self.entries.count; ++i) {
+    NYPLBook *const expectedBook = [NYPLBook bookWithEntry:self.entries[i]];
+    NYPLBook *const book = NYPLNullToNil(booksOrNulls[i]);
+    if(expectedBook.defaultAcquisition) {
+      XCTAssertEqualObjects(book.identifier, expectedBook.identifier);
+    } else {
+      XCTAssertNil(book);
+    }
+  }
+}
+
+- (void)testBuildsWhileHoldingRegistryLock
+{
+  XCTestExpectation *const built = [self expectationWithDescription:@"books built"];
+  
+  dispatch_async(dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0), ^{
+    @synchronized([NYPLBookRegistry sharedRegistry]) {
+      NSArray *const booksOrNulls = [NYPLCatalogBookBuilder booksOrNullsWithEntries:self.entries];
+      XCTAssertEqual(booksOrNulls.count, self.entries.count);
+    }
+    [built fulfill];
+  });
+  
+  [self waitForExpectationsWithTimeout:10 handler:nil];
+}
+
+- (void)testHandlesEmptyEntries
+{
+  XCTAssertEqualObjects([NYPLCatalogBookBuilder booksOrNullsWithEntries:@[]], @[]);
+}
+
+- (void)testBuildPerformance
+{
+  [self measureBlock:^{
+    [NYPLCatalogBookBuilder booksOrNullsWithEntries:self.entries];
+  }];
+}
+
+@end
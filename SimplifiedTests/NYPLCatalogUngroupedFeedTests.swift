@@ -9,6 +9,22 @@
 import XCTest
 @testable import SimplyE
 
+private class NYPLCatalogUngroupedFeedDelegateMock: NSObject, NYPLCatalogUngroupedFeedDelegate {
+  var updatedIndexes = [IndexSet]()
+  var onUpdate: (() -> Void)?
+
+  func catalogUngroupedFeed(_ catalogUngroupedFeed: NYPLCatalogUngroupedFeed,
+                            didUpdateBooksAt indexes: IndexSet) {
+    updatedIndexes.append(indexes)
+    onUpdate?()
+  }
+
+  func catalogUngroupedFeed(_ catalogUngroupedFeed: NYPLCatalogUngroupedFeed,
+                            didAddBooks books: [Any],
+                            range: NSRange) {
+  }
+}
+
 class NYPLCatalogUngroupedFeedTests: XCTestCase {
   
   var feedFetcher: NYPLOPDSFeedFetcherMock.Type!
@@ -160,4 +176,105 @@ class NYPLCatalogUngroupedFeedTests: XCTestCase {
 
     XCTAssertNil(result)
   }
+
+  func testRegistryChangesUpdateOnlyChangedBooks() throws {
+    let expectation = self.expectation(description: "fetching")
+    var result: NYPLCatalogUngroupedFeed?
+
+    feedFetcher.fetchCatalogUngroupedFeed(url: NYPLCatalogUngroupedFeedBookType.supported.url(),
+                                          networkExecutor: networkExecutor,
+                                          retryCount: 0) { feed in
+      result = feed
+      expectation.fulfill()
+    }
+
+    waitForExpectations(timeout: 3, handler: nil)
+
+    let feed = try XCTUnwrap(result)
+    try XCTSkipIf(feed.books.count < 2)
+    let delegate = NYPLCatalogUngroupedFeedDelegateMock()
+    feed.delegate = delegate
+    let updated = self.expectation(description: "books updated")
+    delegate.onUpdate = { updated.fulfill() }
+
+    let changedBook = try XCTUnwrap(feed.books[1] as? NYPLBook)
+    let changes = [changedBook.identifier: NSNumber(value: NYPLBookRegistryChange.state.rawValue),
+                   "urn:simplye:test:not-in-feed": NSNumber(value: NYPLBookRegistryChange.state.rawValue)]
+    NotificationCenter.default.post(name: .NYPLBookRegistryDidChange,
+                                    object: nil,
+                                    userInfo: [NYPLNotificationKeys.bookRegistryChangesKey: changes])
+
+    wait(for: [updated], timeout: 3)
+    XCTAssertEqual(delegate.updatedIndexes, [IndexSet(integer: 1)])
+  }
+
+  private func fetchSupportedFeed() throws -> NYPLCatalogUngroupedFeed {
+    let expectation = self.expectation(description: "fetching")
+    var result: NYPLCatalogUngroupedFeed?
+
+    feedFetcher.fetchCatalogUngroupedFeed(url: NYPLCatalogUngroupedFeedBookType.supported.url(),
+                                          networkExecutor: networkExecutor,
+                                          retryCount: 0) { feed in
+      result = feed
+      expectation.fulfill()
+    }
+
+    waitForExpectations(timeout: 3, handler: nil)
+    return try XCTUnwrap(result)
+  }
+
+  func testPreloadThresholdFollowsPreparationRate() throws {
+    let feed = try fetchSupportedFeed()
+    feed.averagePageLoadTime = 2
+
+    feed.preparationRate = 0
+    XCTAssertEqual(feed.preloadThreshold(), 100)
+
+    // 100 books per second during twice the average page load time
+    feed.preparationRate = 100
+    XCTAssertEqual(feed.preloadThreshold(), 400)
+
+    feed.preparationRate = 10_000
+    XCTAssertEqual(feed.preloadThreshold(), 1000)
+  }
+
+  func testPreparationRateIsMovingAverage() throws {
+    let feed = try fetchSupportedFeed()
+
+    // the first preparation only records its time
+    feed.updatePreparationRate(forBookIndex: 10)
+    XCTAssertEqual(feed.preparationRate, 0)
+    XCTAssertGreaterThan(feed.lastPreparationTime, 0)
+
+    feed.greatestPreparationIndex = 10
+    feed.lastPreparationTime = ProcessInfo.processInfo.systemUptime - 1
+    feed.updatePreparationRate(forBookIndex: 30)
+
+    // 20 books in about a second, weighted against a previous rate of 0
+    XCTAssertEqual(feed.preparationRate, 6, accuracy: 0.5)
+    XCTAssertEqual(feed.lastPreparationTime,
+                   ProcessInfo.processInfo.systemUptime,
+                   accuracy: 0.5)
+  }
+
+  func testEndOfListWaitIsNotedForLastBookWhileFetching() throws {
+    let feed = try fetchSupportedFeed()
+    try XCTSkipIf(feed.books.count < 2)
+    let lastIndex = UInt(feed.books.count - 1)
+
+    feed.noteEndOfListWaitIfNeeded(forBookIndex: lastIndex)
+    XCTAssertEqual(feed.endOfListWaitStartTime, 0)
+
+    feed.currentlyFetchingNextURL = true
+    feed.noteEndOfListWaitIfNeeded(forBookIndex: lastIndex - 1)
+    XCTAssertEqual(feed.endOfListWaitStartTime, 0)
+
+    feed.noteEndOfListWaitIfNeeded(forBookIndex: lastIndex)
+    let startTime = feed.endOfListWaitStartTime
+    XCTAssertGreaterThan(startTime, 0)
+
+    // a wait already in progress is not restarted
+    feed.noteEndOfListWaitIfNeeded(forBookIndex: lastIndex)
+    XCTAssertEqual(feed.endOfListWaitStartTime, startTime)
+  }
 }
@@ -0,0 +1,62 @@
+//
+//  NYPLDownloadMetricsTests.swift
+//  SimplyETests
+//
+//  Copyright © 2026 NYPL. All rights reserved.
+//
+
+import XCTest
+@testable import SimplyE
+
+class NYPLDownloadMetricsTests: XCTestCase {
+  let megabyte: Int64 = 1024 * 1024
+
+  //----------------------------------------------------------------------------
+  func testSummariesPerDistributorAndMode() throws {
+    let metrics = NYPLDownloadMetrics()
+    metrics.recordDownload(distributor: "Bibliotheca", mode: .singleStream,
+                           byteCount: 10 * megabyte, duration: 10)
+    metrics.recordDownload(distributor: "Bibliotheca", mode: .singleStream,
+                           byteCount: 20 * megabyte, duration: 30)
+    metrics.recordDownload(distributor: "Bibliotheca", mode: .segmented,
+                           byteCount: 30 * megabyte, duration: 10)
+    metrics.recordDownload(distributor: nil, mode: .segmented,
+                           byteCount: 1 * megabyte, duration: 1)
+
+    let summaries = metrics.summaries()
+
+    XCTAssertEqual(summaries.map { $0.distributor },
+                   ["Bibliotheca", "Bibliotheca", NYPLDownloadMetrics.unknownDistributor])
+    XCTAssertEqual(summaries.map { $0.mode }, [.singleStream, .segmented, .segmented])
+
+    let singleStream = try XCTUnwrap(summaries.first)
+    XCTAssertEqual(singleStream.downloadCount, 2)
+    XCTAssertEqual(singleStream.medianDuration, 20)
+    XCTAssertEqual(singleStream.throughput, Double(30 * megabyte) / 40)
+    XCTAssertEqual(summaries[1].throughput, Double(3 * megabyte))
+  }
+
+  //----------------------------------------------------------------------------
+  func testOnlyRecentDownloadsAreKept() throws {
+    let metrics = NYPLDownloadMetrics(maxSamplesPerKey: 3)
+    for duration in [100.0, 1, 2, 3] {
+      metrics.recordDownload(distributor: "Overdrive", mode: .singleStream,
+                             byteCount: megabyte, duration: duration)
+    }
+
+    let summary = try XCTUnwrap(metrics.summaries().first)
+    XCTAssertEqual(summary.downloadCount, 3)
+    XCTAssertEqual(summary.medianDuration, 2)
+  }
+
+  //----------------------------------------------------------------------------
+  func testEmptyDownloadsAreIgnored() {
+    let metrics = NYPLDownloadMetrics()
+    metrics.recordDownload(distributor: "Overdrive", mode: .segmented,
+                           byteCount: 0, duration: 5)
+    metrics.recordDownload(distributor: "Overdrive", mode: .segmented,
+                           byteCount: megabyte, duration: 0)
+
+    XCTAssertTrue(metrics.summaries().isEmpty)
+  }
+}
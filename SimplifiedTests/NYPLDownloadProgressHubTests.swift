@@ -0,0 +1,111 @@
+//
+//  NYPLDownloadProgressHubTests.swift
+//  SimplyETests
+//
+//  Copyright © 2026 NYPL. All rights reserved.
+//
+
+import XCTest
+@testable import SimplyE
+
+class NYPLDownloadProgressHubTests: XCTestCase {
+  var notificationCenter: NotificationCenter!
+  var progress: [String: Double]!
+  var hub: NYPLDownloadProgressHub!
+  var notifications: [Notification]!
+  var observer: NSObjectProtocol?
+
+  override func setUp() {
+    super.setUp()
+    notificationCenter = NotificationCenter()
+    progress = [:]
+    notifications = []
+    hub = NYPLDownloadProgressHub(sender: nil,
+                                  interval: 0.05,
+                                  notificationCenter: notificationCenter) { [unowned self] identifier in
+                                    self.progress[identifier] ?? 0
+    }
+    observer = notificationCenter.addObserver(forName: .NYPLMyBooksDownloadCenterDidChange,
+                                              object: nil,
+                                              queue: nil) { [unowned self] notification in
+                                                self.notifications.append(notification)
+    }
+  }
+
+  override func tearDown() {
+    if let observer = observer {
+      notificationCenter.removeObserver(observer)
+    }
+    super.tearDown()
+  }
+
+  private func waitForTicks(_ count: Double = 3) {
+    let waited = expectation(description: "ticks")
+    DispatchQueue.main.asyncAfter(deadline: .now() + hub.interval * count) {
+      waited.fulfill()
+    }
+    wait(for: [waited], timeout: 5)
+  }
+
+  private func progressChanges(of notification: Notification?) -> [String: NSNumber]? {
+    return notification?.userInfo?[NYPLNotificationKeys.downloadProgressChangesKey] as? [String: NSNumber]
+  }
+
+  func testConcurrentDownloadsArePostedInOneNotificationPerTick() {
+    let identifiers = (0..<10).map { "book-\($0)" }
+    for (index, identifier) in identifiers.enumerated() {
+      progress[identifier] = Double(index) / 10
+    }
+
+    DispatchQueue.concurrentPerform(iterations: 1000) { iteration in
+      hub.recordChange(forBookIdentifier: identifiers[iteration % identifiers.count])
+    }
+    waitForTicks()
+
+    XCTAssertEqual(notifications.count, 1)
+    let changes = progressChanges(of: notifications.first)
+    XCTAssertEqual(changes?.count, identifiers.count)
+    for (index, identifier) in identifiers.enumerated() {
+      XCTAssertEqual(changes?[identifier]?.doubleValue, Double(index) / 10)
+    }
+    XCTAssertNotNil(notifications.first?.userInfo?[NYPLNotificationKeys.bookIDKey] as? String)
+  }
+
+  func testChangesAfterATickArePostedInTheNextOne() {
+    progress = ["a": 0.1, "b": 0.2]
+    hub.recordChange(forBookIdentifier: "a")
+    waitForTicks()
+    progress["a"] = 0.5
+    hub.recordChange(forBookIdentifier: "a")
+    hub.recordChange(forBookIdentifier: "b")
+    waitForTicks()
+
+    XCTAssertEqual(notifications.count, 2)
+    XCTAssertEqual(progressChanges(of: notifications.first), ["a": 0.1])
+    XCTAssertEqual(progressChanges(of: notifications.last), ["a": 0.5, "b": 0.2])
+  }
+
+  func testEmptyIdentifierMeansAnyBookChanged() {
+    hub.recordChange(forBookIdentifier: "a")
+    hub.recordChange(forBookIdentifier: "")
+    waitForTicks()
+
+    XCTAssertEqual(notifications.count, 1)
+    XCTAssertNil(progressChanges(of: notifications.first))
+    XCTAssertEqual(notifications.first?.userInfo?[NYPLNotificationKeys.bookIDKey] as? String, "")
+  }
+
+  func testPublishNowIncludesPendingChangesWithoutDuplicates() {
+    progress = ["a": 0.3, "b": 0]
+    hub.recordChange(forBookIdentifier: "a")
+    hub.publishNow(forBookIdentifier: "b")
+
+    // the tests run on the main thread, so this was posted synchronously
+    XCTAssertEqual(notifications.count, 1)
+    XCTAssertEqual(progressChanges(of: notifications.first), ["a": 0.3, "b": 0])
+
+    // nothing is left for the end of the tick
+    waitForTicks()
+    XCTAssertEqual(notifications.count, 1)
+  }
+}
@@ -0,0 +1,46 @@
+//
+//  NYPLLRUCacheTests.swift
+//  SimplyETests
+//
+//  Copyright © 2026 NYPL. All rights reserved.
+//
+
+import XCTest
+@testable import SimplyE
+
+private class NYPLCachedValue {}
+
+class NYPLLRUCacheTests: XCTestCase {
+
+  func testValuesAreReleasedWithTheCache() {
+    var cache: NYPLLRUCache<Int, NYPLCachedValue>? = NYPLLRUCache(costLimit: 10)
+    var weakValues = [() -> NYPLCachedValue?]()
+    for key in 0..<5 {
+      let value = NYPLCachedValue()
+      weakValues.append({ [weak value] in value })
+      cache?.setValue(value, forKey: key, cost: 1)
+    }
+    // reorder the list so that entries are linked both ways
+    XCTAssertNotNil(cache?.value(forKey: 2))
+
+    cache = nil
+
+    for weakValue in weakValues {
+      XCTAssertNil(weakValue())
+    }
+  }
+
+  func testEvictedValuesAreReleased() {
+    let cache = NYPLLRUCache<Int, NYPLCachedValue>(costLimit: 2)
+    var value: NYPLCachedValue? = NYPLCachedValue()
+    weak var weakValue = value
+    cache.setValue(value!, forKey: 0, cost: 1)
+    value = nil
+
+    cache.setValue(NYPLCachedValue(), forKey: 1, cost: 1)
+    cache.setValue(NYPLCachedValue(), forKey: 2, cost: 1)
+
+    XCTAssertNil(weakValue)
+    XCTAssertEqual(cache.count, 2)
+  }
+}
@@ -0,0 +1,100 @@
+//
+//  NYPLLibraryCatalogSnapshotTests.swift
+//  SimplyETests
+//
+//  Copyright © 2026 NYPL. All rights reserved.
+//
+
+import XCTest
+@testable import SimplyE
+
+class NYPLLibraryCatalogSnapshotTests: XCTestCase {
+  let snapshotKey = "NYPLLibraryCatalogSnapshotTests"
+  var feedData: Data!
+
+  override func setUpWithError() throws {
+    try super.setUpWithError()
+    let feedURL = try XCTUnwrap(Bundle(for: NYPLLibraryCatalogSnapshotTests.self)
+      .url(forResource: "OPDS2CatalogsFeed", withExtension: "json"))
+    feedData = try Data(contentsOf: feedURL)
+  }
+
+  override func tearDown() {
+    if let url = NYPLLibraryCatalogSnapshot.fileURL(forKey: snapshotKey) {
+      try? FileManager.default.removeItem(at: url)
+    }
+    super.tearDown()
+  }
+
+  private func makeAccounts() throws -> [Account] {
+    return try OPDS2CatalogsFeed.fromData(feedData).catalogs.map { Account(publication: $0) }
+  }
+
+  func testSnapshotRestoresAccounts() throws {
+    let accounts = try makeAccounts()
+    let digest = NYPLLibraryCatalogSnapshot.digest(ofFeedData: feedData)
+    NYPLLibraryCatalogSnapshot(feedDigest: digest, accounts: accounts).save(forKey: snapshotKey)
+
+    let snapshot = try XCTUnwrap(NYPLLibraryCatalogSnapshot.load(forKey: snapshotKey))
+    XCTAssertEqual(snapshot.feedDigest, digest)
+    let restored = snapshot.entries.map { Account(snapshotEntry: $0) }
+
+    XCTAssertEqual(restored.count, accounts.count)
+    for (account, restoredAccount) in zip(accounts, restored) {
+      XCTAssertEqual(restoredAccount.uuid, account.uuid)
+      XCTAssertEqual(restoredAccount.name, account.name)
+      XCTAssertEqual(restoredAccount.subtitle, account.subtitle)
+      XCTAssertEqual(restoredAccount.catalogUrl, account.catalogUrl)
+      XCTAssertEqual(restoredAccount.supportEmail, account.supportEmail)
+      XCTAssertEqual(restoredAccount.authenticationDocumentUrl,
+                     account.authenticationDocumentUrl)
+    }
+  }
+
+  func testDigestChangesWithFeedData() {
+    var changedData = feedData!
+    changedData.append(0x20)
+
+    XCTAssertEqual(NYPLLibraryCatalogSnapshot.digest(ofFeedData: feedData),
+                   NYPLLibraryCatalogSnapshot.digest(ofFeedData: feedData))
+    XCTAssertNotEqual(NYPLLibraryCatalogSnapshot.digest(ofFeedData: feedData),
+                      NYPLLibraryCatalogSnapshot.digest(ofFeedData: changedData))
+  }
+
+  func testLogosAreDecodedOnDemand() throws {
+    let account = try XCTUnwrap(makeAccounts().first)
+    let cache = NYPLLibraryLogoCache()
+    XCTAssertNil(cache.cachedLogo(forKey: account.uuid))
+
+    let logo = cache.logo(forKey: account.uuid, dataURL: account.snapshotEntry.logoDataURL)
+    XCTAssertLessThanOrEqual(max(logo.size.width, logo.size.height),
+                             CGFloat(NYPLLibraryLogoCache.maxPixelSize))
+    XCTAssert(cache.cachedLogo(forKey: account.uuid) === logo)
+
+    let loaded = expectation(description: "logo loaded")
+    cache.loadLogo(forKey: account.uuid, dataURL: nil) {
+      XCTAssert($0 === logo)
+      loaded.fulfill()
+    }
+    wait(for: [loaded], timeout: 5)
+  }
+
+  func testInvalidLogoFallsBackToPlaceholder() {
+    let cache = NYPLLibraryLogoCache()
+
+    XCTAssert(cache.logo(forKey: "invalid", dataURL: "data:image/png;base64,!!!")
+      === NYPLLibraryLogoCache.placeholder)
+    XCTAssert(cache.cachedLogo(forKey: "invalid") === NYPLLibraryLogoCache.placeholder)
+  }
+
+  func testSnapshotLoadingPerformance() throws {
+    let accounts = try makeAccounts()
+    let digest = NYPLLibraryCatalogSnapshot.digest(ofFeedData: feedData)
+    NYPLLibraryCatalogSnapshot(feedDigest: digest, accounts: accounts).save(forKey: snapshotKey)
+
+    measure {
+      let snapshot = NYPLLibraryCatalogSnapshot.load(forKey: snapshotKey)
+      XCTAssertEqual(snapshot?.entries.count, accounts.count)
+    }
+  }
+}
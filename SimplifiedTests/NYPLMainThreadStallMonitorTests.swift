@@ -0,0 +1,66 @@
+//
+//  NYPLMainThreadStallMonitorTests.swift
+//  SimplyETests
+//
+//  Copyright © 2026 NYPL. All rights reserved.
+//
+
+import XCTest
+@testable import SimplyE
+
+class NYPLMainThreadStallMonitorTests: XCTestCase {
+  var monitor: NYPLMainThreadStallMonitor!
+
+  override func tearDown() {
+    monitor?.stop()
+    monitor = nil
+    super.tearDown()
+  }
+
+  /// Lets the main run loop process the checks scheduled by the monitor.
+  private func runMainLoop(for duration: TimeInterval) {
+    let waited = expectation(description: "waited")
+    DispatchQueue.main.asyncAfter(deadline: .now() + duration) {
+      waited.fulfill()
+    }
+    wait(for: [waited], timeout: duration + 5)
+  }
+
+  func testRecordsBlockedMainThread() {
+    monitor = NYPLMainThreadStallMonitor(name: "test", threshold: 0.1, interval: 0.01)
+    monitor.start()
+    runMainLoop(for: 0.05)
+
+    // the tests run on the main thread
+    Thread.sleep(forTimeInterval: 0.3)
+    runMainLoop(for: 0.1)
+
+    XCTAssertGreaterThanOrEqual(monitor.stallCount, 1)
+    XCTAssertGreaterThanOrEqual(monitor.longestStall, 0.2)
+    XCTAssertGreaterThanOrEqual(monitor.totalStallDuration, monitor.longestStall)
+  }
+
+  func testIdleMainThreadIsNotStalled() {
+    monitor = NYPLMainThreadStallMonitor(name: "test", threshold: 0.25, interval: 0.01)
+    monitor.start()
+    runMainLoop(for: 0.3)
+
+    XCTAssertEqual(monitor.stallCount, 0)
+    XCTAssertEqual(monitor.longestStall, 0)
+  }
+
+  func testStartResetsRecordedStalls() {
+    monitor = NYPLMainThreadStallMonitor(name: "test", threshold: 0.1, interval: 0.01)
+    monitor.start()
+    runMainLoop(for: 0.05)
+    Thread.sleep(forTimeInterval: 0.2)
+    runMainLoop(for: 0.1)
+    XCTAssertGreaterThanOrEqual(monitor.stallCount, 1)
+
+    monitor.stop()
+    XCTAssertFalse(monitor.isRunning)
+    monitor.start()
+    XCTAssertTrue(monitor.isRunning)
+    XCTAssertEqual(monitor.stallCount, 0)
+  }
+}
@@ -98,4 +98,64 @@ class NYPLMyBooksDownloadCenterTests: XCTestCase {
 
     XCTAssert(book.canCompleteDownload(withContentType: ContentTypeEpubZip))
   }
+
+  func testActiveTaskCountIsConsistentAcrossThreads() throws {
+    let center = try XCTUnwrap(NYPLMyBooksDownloadCenter.shared())
+    let initialCount = center.activeTaskCount
+
+    DispatchQueue.concurrentPerform(iterations: 1000) { _ in
+      center.taskWillStart()
+    }
+    XCTAssertEqual(center.activeTaskCount, initialCount + 1000)
+
+    DispatchQueue.concurrentPerform(iterations: 1000) { _ in
+      center.taskDidComplete()
+    }
+    XCTAssertEqual(center.activeTaskCount, initialCount)
+  }
+
+  func testFinishedDownloadIsProcessedOffTheDelegateQueue() throws {
+    let center = try XCTUnwrap(NYPLMyBooksDownloadCenter.shared())
+    let acquisitionsDictionaries = NYPLFake.opdsEntry.acquisitions.map {
+      $0.dictionaryRepresentation()
+    }
+    let book = try XCTUnwrap(NYPLBook(dictionary: [
+      "acquisitions": acquisitionsDictionaries,
+      "title": "Tractatus",
+      "categories": "some cat",
+      "id": "handOff",
+      "updated": "2020-10-06T17:13:51Z"]))
+    let session = URLSession(configuration: .ephemeral)
+    defer {
+      session.invalidateAndCancel()
+    }
+    let task = session.downloadTask(with: try XCTUnwrap(URL(string: "https://example.com/book.epub")))
+    center.setBook(book, forTaskIdentifier: UInt(task.taskIdentifier))
+    center.taskWillStart()
+    let initialCount = center.activeTaskCount
+
+    let downloadedFileURL = FileManager.default.temporaryDirectory
+      .appendingPathComponent(UUID().uuidString)
+    XCTAssertTrue(FileManager.default.createFile(atPath: downloadedFileURL.path,
+                                                 contents: Data([1, 2, 3])))
+
+    // Processing is held back: the delegate queue must still get to the
+    // completion of the task.
+    center.processingQueue.suspend()
+    center.delegateQueue.addOperation {
+      center.urlSession(session, downloadTask: task, didFinishDownloadingTo: downloadedFileURL)
+    }
+    center.delegateQueue.addOperation {
+      center.urlSession(session, task: task, didCompleteWithError: nil)
+    }
+    center.delegateQueue.waitUntilAllOperationsAreFinished()
+
+    XCTAssertFalse(FileManager.default.fileExists(atPath: downloadedFileURL.path))
+    XCTAssertEqual(center.activeTaskCount, initialCount - 1)
+
+    // Mimic a reset so that the staged file is discarded rather than fulfilled.
+    center.taskIdentifierToBook.removeObject(forKey: task.taskIdentifier)
+    center.processingQueue.resume()
+    center.processingQueue.sync {}
+  }
 }
@@ -0,0 +1,161 @@
+//
+//  NYPLNetworkQueueTests.swift
+//  SimplyETests
+//
+//  Copyright © 2026 NYPL. All rights reserved.
+//
+
+import XCTest
+import NYPLUtilities
+@testable import SimplyE
+
+/// Completes every request asynchronously, keeping track of how many
+/// requests are in flight at the same time.
+private class NYPLQueueRetryExecutorMock: NYPLRequestExecuting {
+  var requestTimeout: TimeInterval = 60
+  var failureCode: Int?
+
+  private let lock = NSLock()
+  private(set) var executedRequests = [URLRequest]()
+  private(set) var maxRequestsInFlight = 0
+  private var requestsInFlight = 0
+
+  func executeRequest(_ req: URLRequest,
+                      completion: @escaping (NYPLResult<Data>) -> Void) -> URLSessionDataTask {
+    lock.lock()
+    executedRequests.append(req)
+    requestsInFlight += 1
+    maxRequestsInFlight = max(maxRequestsInFlight, requestsInFlight)
+    lock.unlock()
+
+    DispatchQueue.global().asyncAfter(deadline: .now() + 0.01) {
+      self.lock.lock()
+      self.requestsInFlight -= 1
+      self.lock.unlock()
+
+      if let failureCode = self.failureCode {
+        completion(.failure(NSError(domain: NSURLErrorDomain, code: failureCode), nil))
+      } else {
+        completion(.success(Data(), nil))
+      }
+    }
+
+    return URLSessionDataTask()
+  }
+
+  func request(for url: URL, httpMethod: String, httpBody: Data?) -> URLRequest {
+    var request = URLRequest(url: url)
+    request.httpMethod = httpMethod
+    request.httpBody = httpBody
+    request.setValue("Bearer test", forHTTPHeaderField: "Authorization")
+    return request
+  }
+}
+
+class NYPLNetworkQueueTests: XCTestCase {
+  let libraryID = "library"
+  var databasePath: String!
+  fileprivate var executor: NYPLQueueRetryExecutorMock!
+  var queue: NetworkQueue!
+
+  override func setUp() {
+    super.setUp()
+    databasePath = NSTemporaryDirectory() + "NYPLNetworkQueueTests-\(UUID().uuidString).db"
+    executor = NYPLQueueRetryExecutorMock()
+    queue = NetworkQueue(databasePath: databasePath, executor: executor)
+    queue.migrateOrSetUpIfNeeded()
+  }
+
+  override func tearDown() {
+    queue = nil
+    for suffix in ["", "-wal", "-shm"] {
+      try? FileManager.default.removeItem(atPath: databasePath + suffix)
+    }
+    super.tearDown()
+  }
+
+  /// Queues 30 analytics events, 5 reading positions for the same book and
+  /// 3 sync setting updates.
+  private func queueOfflineSession() {
+    for event in 0..<30 {
+      queue.addRequest(libraryID, nil,
+                       URL(string: "https://example.com/analytics/book\(event)/open_book")!,
+                       .GET, nil)
+    }
+    for position in 0..<5 {
+      queue.addRequest(libraryID, "book",
+                       URL(string: "https://example.com/annotations/")!,
+                       .POST, "{\"position\":\(position)}".data(using: .utf8))
+    }
+    for setting in [true, false, true] {
+      queue.addRequest(libraryID, nil,
+                       URL(string: "https://example.com/patrons/me/")!,
+                       .PUT, "{\"sync\":\(setting)}".data(using: .utf8))
+    }
+  }
+
+  private func retryQueue() {
+    let retried = expectation(description: "retry pass over")
+    queue.retryQueue {
+      retried.fulfill()
+    }
+    wait(for: [retried], timeout: 10)
+  }
+
+  func testSupersededRequestsAreCoalesced() {
+    queueOfflineSession()
+
+    XCTAssertEqual(queue.test_queuedRequestCount(), 32)
+  }
+
+  func testRetryDispatchesWithBoundedConcurrency() {
+    queueOfflineSession()
+
+    retryQueue()
+
+    XCTAssertEqual(executor.executedRequests.count, 32)
+    XCTAssertLessThanOrEqual(executor.maxRequestsInFlight, queue.MaxConcurrentRetries)
+    XCTAssertEqual(queue.test_queuedRequestCount(), 0)
+
+    let positionRequest = executor.executedRequests.first { $0.httpMethod == "POST" }
+    XCTAssertEqual(positionRequest?.httpBody, "{\"position\":4}".data(using: .utf8))
+    let settingRequest = executor.executedRequests.first { $0.httpMethod == "PUT" }
+    XCTAssertEqual(settingRequest?.httpBody, "{\"sync\":true}".data(using: .utf8))
+    XCTAssertEqual(settingRequest?.value(forHTTPHeaderField: "Authorization"), "Bearer test")
+  }
+
+  func testLosingConnectivityStopsRetryPass() {
+    queueOfflineSession()
+    executor.failureCode = NSURLErrorNotConnectedToInternet
+
+    retryQueue()
+
+    XCTAssertLessThanOrEqual(executor.executedRequests.count, queue.MaxConcurrentRetries)
+    XCTAssertEqual(queue.test_queuedRequestCount(), 32)
+  }
+
+  func testFailedRequestsExpire() {
+    queue.addRequest(libraryID, nil, URL(string: "https://example.com/analytics")!, .GET, nil)
+    executor.failureCode = 400
+
+    for _ in 0...queue.MaxRetriesInQueue {
+      retryQueue()
+    }
+    XCTAssertEqual(queue.test_queuedRequestCount(), 1)
+
+    retryQueue()
+    XCTAssertEqual(queue.test_queuedRequestCount(), 0)
+  }
+
+  func testLosingConnectivityDoesNotExpireRequests() {
+    queue.addRequest(libraryID, nil, URL(string: "https://example.com/analytics")!, .GET, nil)
+    executor.failureCode = NSURLErrorNotConnectedToInternet
+
+    for _ in 0...queue.MaxRetriesInQueue + 1 {
+      retryQueue()
+    }
+
+    XCTAssertEqual(executor.executedRequests.count, queue.MaxRetriesInQueue + 2)
+    XCTAssertEqual(queue.test_queuedRequestCount(), 1)
+  }
+}
@@ -0,0 +1,124 @@
+//
+//  NYPLNetworkResponderTests.swift
+//  SimplyETests
+//
+//  Copyright © 2026 NYPL. All rights reserved.
+//
+
+import XCTest
+@testable import SimplyE
+
+class NYPLNetworkResponderTests: XCTestCase {
+  let bodySize = 4 * 1024 * 1024
+  let chunkSize = 1024
+
+  private func makeBody() -> Data {
+    return Data((0..<bodySize).map { UInt8(truncatingIfNeeded: $0) })
+  }
+
+  func testBufferCopiesEachByteAtMostOnce() {
+    let body = makeBody()
+    var buffer = NYPLResponseBodyBuffer()
+
+    for offset in stride(from: 0, to: body.count, by: chunkSize) {
+      buffer.append(body.subdata(in: offset..<min(offset + chunkSize, body.count)))
+      XCTAssertEqual(buffer.copiedByteCount, 0)
+    }
+
+    XCTAssertEqual(buffer.count, bodySize)
+    XCTAssertEqual(buffer.data(), body)
+    XCTAssertEqual(buffer.copiedByteCount, bodySize)
+
+    // reading the body again must not copy it again
+    XCTAssertEqual(buffer.data(), body)
+    XCTAssertEqual(buffer.copiedByteCount, bodySize)
+  }
+
+  func testBufferWithSingleChunkDoesNotCopy() {
+    var buffer = NYPLResponseBodyBuffer()
+    buffer.append(Data([1, 2, 3]))
+    buffer.append(Data())
+
+    XCTAssertEqual(buffer.data(), Data([1, 2, 3]))
+    XCTAssertEqual(buffer.copiedByteCount, 0)
+  }
+
+  func testResponderDeliversChunkedBody() throws {
+    let responder = NYPLNetworkResponder(credentialsSource: NYPLUserAccountMock())
+    let session = URLSession(configuration: .ephemeral)
+    defer {
+      session.invalidateAndCancel()
+    }
+    let url = try XCTUnwrap(URL(string: "https://example.com/feed"))
+    let task = session.dataTask(with: url)
+    let body = makeBody()
+
+    var receivedData: Data?
+    responder.addCompletion({ result in
+      if case let .success(data, _) = result {
+        receivedData = data
+      }
+    }, taskID: task.taskIdentifier)
+
+    for offset in stride(from: 0, to: body.count, by: chunkSize) {
+      responder.urlSession(session,
+                           dataTask: task,
+                           didReceive: body.subdata(in: offset..<offset + chunkSize))
+    }
+    responder.urlSession(session, task: task, didCompleteWithError: nil)
+
+    XCTAssertEqual(receivedData, body)
+  }
+
+  private func execute(_ request: URLRequest) -> NYPLResult<Data>? {
+    let executor = NYPLNetworkExecutor(credentialsSource: NYPLUserAccountMock(),
+                                       cachingStrategy: .ephemeral)
+    let completed = expectation(description: "request completed")
+    var result: NYPLResult<Data>?
+    executor.executeRequest(request) {
+      result = $0
+      completed.fulfill()
+    }
+    wait(for: [completed], timeout: 10)
+    return result
+  }
+
+  func testNotModifiedIsSuccessForConditionalRequest() throws {
+    let server = try NYPLRangeHTTPServer(body: Data([1, 2, 3]),
+                                         eTag: "\"v1\"",
+                                         fileName: "feed.xml",
+                                         contentType: "application/atom+xml")
+    defer {
+      server.stop()
+    }
+    var request = URLRequest(url: try XCTUnwrap(server.start()),
+                             cachePolicy: .reloadIgnoringLocalCacheData)
+    request.setValue("\"v1\"", forHTTPHeaderField: "If-None-Match")
+
+    guard case let .success(data, response)? = execute(request) else {
+      XCTFail("A 304 response to a conditional request should succeed")
+      return
+    }
+    XCTAssertEqual((response as? HTTPURLResponse)?.statusCode, 304)
+    XCTAssertTrue(data.isEmpty)
+  }
+
+  func testNotModifiedIsFailureForUnconditionalRequest() throws {
+    let server = try NYPLRangeHTTPServer(body: Data([1, 2, 3]),
+                                         eTag: "\"v1\"",
+                                         fileName: "feed.xml",
+                                         contentType: "application/atom+xml")
+    defer {
+      server.stop()
+    }
+    _ = server.start()
+    let request = URLRequest(url: try XCTUnwrap(server.notModifiedURL),
+                             cachePolicy: .reloadIgnoringLocalCacheData)
+
+    guard case let .failure(_, response)? = execute(request) else {
+      XCTFail("A 304 response the request did not ask for should fail")
+      return
+    }
+    XCTAssertEqual((response as? HTTPURLResponse)?.statusCode, 304)
+  }
+}
@@ -0,0 +1,133 @@
+//
+//  NYPLOPDSFeedCacheTests.swift
+//  SimplyETests
+//
+//  Copyright © 2026 NYPL. All rights reserved.
+//
+
+import XCTest
+@testable import SimplyE
+
+class NYPLOPDSFeedCacheTests: XCTestCase {
+  let feedURL = URL(string: "https://example.com/feed")!
+  var directoryURL: URL!
+  var feedData: Data!
+  var feed: NYPLOPDSFeed!
+
+  override func setUpWithError() throws {
+    try super.setUpWithError()
+    directoryURL = FileManager.default.temporaryDirectory
+      .appendingPathComponent("NYPLOPDSFeedCacheTests-\(UUID().uuidString)")
+    let url = try XCTUnwrap(Bundle(for: NYPLOPDSFeedCacheTests.self)
+      .url(forResource: "main", withExtension: "xml"))
+    feedData = try Data(contentsOf: url)
+    let parser = NYPLOPDSFeedParser(data: feedData)
+    XCTAssertTrue(parser.parse())
+    feed = try XCTUnwrap(parser.feed)
+  }
+
+  override func tearDown() {
+    try? FileManager.default.removeItem(at: directoryURL)
+    super.tearDown()
+  }
+
+  func testKeyDependsOnURLAndBody() throws {
+    var changedData = feedData!
+    changedData.append(0x20)
+    let otherURL = try XCTUnwrap(URL(string: "https://example.com/other"))
+
+    XCTAssertEqual(NYPLOPDSFeedCache.key(for: feedURL, data: feedData),
+                   NYPLOPDSFeedCache.key(for: feedURL, data: feedData))
+    XCTAssertNotEqual(NYPLOPDSFeedCache.key(for: feedURL, data: feedData),
+                      NYPLOPDSFeedCache.key(for: feedURL, data: changedData))
+    XCTAssertNotEqual(NYPLOPDSFeedCache.key(for: feedURL, data: feedData),
+                      NYPLOPDSFeedCache.key(for: otherURL, data: feedData))
+  }
+
+  func testResettingLibrarySpecificInfoEmptiesCache() {
+    let executor = NYPLNetworkExecutor(credentialsSource: NYPLUserAccountMock(),
+                                       cachingStrategy: .ephemeral)
+    let key = NYPLOPDSFeedCache.key(for: feedURL, data: feedData)
+    executor.parsedFeedCache.setFeed(feed, forKey: key, cost: feedData.count)
+
+    executor.resetLibrarySpecificInfo()
+
+    XCTAssertNil(executor.parsedFeedCache.feed(forKey: key))
+  }
+
+  func testFeedIsRestoredFromDisk() throws {
+    let key = NYPLOPDSFeedCache.key(for: feedURL, data: feedData)
+    let cache = NYPLOPDSFeedCache(cachingStrategy: .default, directoryURL: directoryURL)
+    cache.setFeed(feed, forKey: key, cost: feedData.count)
+    cache.test_waitForDiskQueue()
+    cache.test_removeAllFromMemory()
+
+    let restored = try XCTUnwrap(cache.feed(forKey: key))
+    XCTAssertEqual(restored.identifier, feed.identifier)
+    XCTAssertEqual(restored.title, feed.title)
+    XCTAssertEqual(restored.updated, feed.updated)
+    XCTAssertEqual(restored.links.count, feed.links.count)
+    XCTAssertEqual(restored.type, feed.type)
+    XCTAssertEqual(restored.entries.count, feed.entries.count)
+
+    for (restoredEntry, entry) in zip(restored.entries, feed.entries) {
+      let lhs = try XCTUnwrap(restoredEntry as? NYPLOPDSEntry)
+      let rhs = try XCTUnwrap(entry as? NYPLOPDSEntry)
+      XCTAssertEqual(lhs.identifier, rhs.identifier)
+      XCTAssertEqual(lhs.title, rhs.title)
+      XCTAssertEqual(lhs.updated, rhs.updated)
+      XCTAssertEqual(lhs.authorStrings as? [String], rhs.authorStrings as? [String])
+      XCTAssertEqual(lhs.categories.map { $0.term }, rhs.categories.map { $0.term })
+      XCTAssertEqual(lhs.acquisitions.map { $0.hrefURL }, rhs.acquisitions.map { $0.hrefURL })
+      XCTAssertEqual(lhs.links.count, rhs.links.count)
+      XCTAssertEqual(lhs.alternate?.href, rhs.alternate?.href)
+    }
+  }
+
+  func testEphemeralCacheDoesNotPersist() {
+    let key = NYPLOPDSFeedCache.key(for: feedURL, data: feedData)
+    let cache = NYPLOPDSFeedCache(cachingStrategy: .ephemeral, directoryURL: directoryURL)
+    cache.setFeed(feed, forKey: key, cost: feedData.count)
+    XCTAssert(cache.feed(forKey: key) === feed)
+
+    cache.test_waitForDiskQueue()
+    cache.test_removeAllFromMemory()
+    XCTAssertNil(cache.feed(forKey: key))
+    XCTAssertFalse(FileManager.default.fileExists(atPath: directoryURL.path))
+  }
+
+  func testPersistentExecutorsShareOneCache() {
+    let credentials = NYPLUserAccountMock()
+    let executor = NYPLNetworkExecutor(credentialsSource: credentials, cachingStrategy: .default)
+    let otherExecutor = NYPLNetworkExecutor(credentialsSource: credentials, cachingStrategy: .fallback)
+    let ephemeralExecutor = NYPLNetworkExecutor(credentialsSource: credentials, cachingStrategy: .ephemeral)
+
+    XCTAssert(executor.parsedFeedCache === NYPLOPDSFeedCache.shared)
+    XCTAssert(otherExecutor.parsedFeedCache === NYPLOPDSFeedCache.shared)
+    XCTAssert(ephemeralExecutor.parsedFeedCache !== NYPLOPDSFeedCache.shared)
+  }
+
+  func testDiskCacheIsBounded() throws {
+    let cache = NYPLOPDSFeedCache(cachingStrategy: .default,
+                                  directoryURL: directoryURL,
+                                  diskByteLimit: 1)
+    cache.setFeed(feed, forKey: "first", cost: feedData.count)
+    cache.setFeed(feed, forKey: "second", cost: feedData.count)
+    cache.test_waitForDiskQueue()
+
+    let files = try FileManager.default.contentsOfDirectory(atPath: directoryURL.path)
+    XCTAssertEqual(files.count, 0)
+  }
+
+  func testCachedFeedLoadingPerformance() {
+    let key = NYPLOPDSFeedCache.key(for: feedURL, data: feedData)
+    let cache = NYPLOPDSFeedCache(cachingStrategy: .default, directoryURL: directoryURL)
+    cache.setFeed(feed, forKey: key, cost: feedData.count)
+    cache.test_waitForDiskQueue()
+
+    measure {
+      cache.test_removeAllFromMemory()
+      XCTAssertEqual(cache.feed(forKey: key)?.entries.count, feed.entries.count)
+    }
+  }
+}
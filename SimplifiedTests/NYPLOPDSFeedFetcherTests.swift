@@ -0,0 +1,83 @@
+//
+//  NYPLOPDSFeedFetcherTests.swift
+//  SimplyETests
+//
+//  Copyright © 2026 NYPL. All rights reserved.
+//
+
+import XCTest
+@testable import SimplyE
+
+class NYPLOPDSFeedFetcherTests: XCTestCase {
+  var server: NYPLRangeHTTPServer!
+  var feedURL: URL!
+  var executor: NYPLNetworkExecutor!
+
+  override func setUpWithError() throws {
+    try super.setUpWithError()
+    let feedFileURL = try XCTUnwrap(Bundle(for: NYPLOPDSFeedFetcherTests.self)
+      .url(forResource: "main", withExtension: "xml"))
+    server = try NYPLRangeHTTPServer(body: try Data(contentsOf: feedFileURL),
+                                     eTag: "\"v1\"",
+                                     fileName: "loans.xml",
+                                     contentType: "application/atom+xml")
+    feedURL = try XCTUnwrap(server.start())
+    executor = NYPLNetworkExecutor(credentialsSource: NYPLUserAccountMock(),
+                                   cachingStrategy: .ephemeral)
+  }
+
+  override func tearDown() {
+    server.stop()
+    super.tearDown()
+  }
+
+  //----------------------------------------------------------------------------
+  private func fetchIfModified(validators: [String: String]?)
+    -> (feed: NYPLOPDSFeed?, validators: [String: String]?, notModified: Bool, error: [String: Any]?) {
+      let fetched = expectation(description: "feed fetched")
+      var result: (NYPLOPDSFeed?, [String: String]?, Bool, [String: Any]?) = (nil, nil, false, nil)
+      NYPLOPDSFeedFetcher.fetchOPDSFeedIfModified(url: feedURL,
+                                                  networkExecutor: executor,
+                                                  validators: validators) {
+        result = ($0, $1, $2, $3)
+        fetched.fulfill()
+      }
+      wait(for: [fetched], timeout: 10)
+      return result
+  }
+
+  //----------------------------------------------------------------------------
+  func testUnconditionalFetchReturnsFeedAndValidators() {
+    let result = fetchIfModified(validators: nil)
+
+    XCTAssertFalse(result.notModified)
+    XCTAssertNil(result.error)
+    XCTAssertGreaterThan(result.feed?.entries.count ?? 0, 0)
+    XCTAssertEqual(result.validators?["ETag"], "\"v1\"")
+    XCTAssertNil(server.receivedRequests.first?["if-none-match"])
+  }
+
+  //----------------------------------------------------------------------------
+  func testUnchangedFeedIsNotModified() {
+    let validators = ["ETag": "\"v1\""]
+
+    let result = fetchIfModified(validators: validators)
+
+    XCTAssertTrue(result.notModified)
+    XCTAssertNil(result.feed)
+    XCTAssertNil(result.error)
+    XCTAssertEqual(result.validators, validators)
+    XCTAssertEqual(server.receivedRequests.first?["if-none-match"], "\"v1\"")
+  }
+
+  //----------------------------------------------------------------------------
+  func testChangedFeedReturnsNewValidators() {
+    server.eTag = "\"v2\""
+
+    let result = fetchIfModified(validators: ["ETag": "\"v1\""])
+
+    XCTAssertFalse(result.notModified)
+    XCTAssertNotNil(result.feed)
+    XCTAssertEqual(result.validators?["ETag"], "\"v2\"")
+  }
+}
@@ -0,0 +1,126 @@
+//
+//  NYPLOPDSFeedParserTests.swift
+//  SimplyETests
+//
+//  Copyright © 2026 NYPL. All rights reserved.
+//
+
+import XCTest
+@testable import SimplyE
+
+class NYPLOPDSFeedParserTests: XCTestCase {
+
+  private func data(forResource name: String) throws -> Data {
+    let bundle = Bundle(for: NYPLOPDSFeedParserTests.self)
+    let url = try XCTUnwrap(bundle.url(forResource: name, withExtension: "xml"))
+    return try Data(contentsOf: url)
+  }
+
+  /// A loans-sized feed, made by repeating the entries of `main.xml`.
+  private func largeFeedData(repeatingEntries times: Int) throws -> Data {
+    let xml = try XCTUnwrap(String(data: data(forResource: "main"), encoding: .utf8))
+    let entriesStart = try XCTUnwrap(xml.range(of: "<entry"))
+    let feedEnd = try XCTUnwrap(xml.range(of: "</feed>"))
+    let header = xml[..<entriesStart.lowerBound]
+    let entries = xml[entriesStart.lowerBound..<feedEnd.lowerBound]
+    let body = String(repeating: String(entries), count: times)
+    return Data((header + body + "</feed>").utf8)
+  }
+
+  private func domFeed(from data: Data) -> NYPLOPDSFeed? {
+    guard let xml = NYPLXML(data: data) else {
+      return nil
+    }
+    return NYPLOPDSFeed(xml: xml)
+  }
+
+  func testStreamingMatchesDOMParsing() throws {
+    let data = try self.data(forResource: "main")
+    let parser = NYPLOPDSFeedParser(data: data)
+    XCTAssertTrue(parser.parse())
+
+    let streamed = try XCTUnwrap(parser.feed)
+    let dom = try XCTUnwrap(domFeed(from: data))
+
+    XCTAssertEqual(streamed.identifier, dom.identifier)
+    XCTAssertEqual(streamed.title, dom.title)
+    XCTAssertEqual(streamed.updated, dom.updated)
+    XCTAssertEqual(streamed.links.count, dom.links.count)
+    XCTAssertEqual(streamed.type, dom.type)
+    XCTAssertEqual(streamed.entries.count, dom.entries.count)
+    XCTAssertGreaterThan(streamed.entries.count, 0)
+
+    for (streamedEntry, domEntry) in zip(streamed.entries, dom.entries) {
+      let lhs = try XCTUnwrap(streamedEntry as? NYPLOPDSEntry)
+      let rhs = try XCTUnwrap(domEntry as? NYPLOPDSEntry)
+      XCTAssertEqual(lhs.identifier, rhs.identifier)
+      XCTAssertEqual(lhs.title, rhs.title)
+      XCTAssertEqual(lhs.acquisitions.count, rhs.acquisitions.count)
+      XCTAssertEqual(lhs.links.count, rhs.links.count)
+    }
+  }
+
+  func testStreamedEntriesAreNotKeptInFeedXML() throws {
+    let parser = NYPLOPDSFeedParser(data: try data(forResource: "main"))
+    XCTAssertTrue(parser.parse())
+
+    let feedXML = try XCTUnwrap(parser.feedXML)
+    XCTAssertEqual(feedXML.childrenWithName("entry").count, 0)
+    XCTAssertNotNil(feedXML.firstChild(withName: "id"))
+  }
+
+  func testSingleEntryDocument() throws {
+    let parser = NYPLOPDSFeedParser(data: try data(forResource: "NYPLOPDSAcquisitionPathEntry"))
+    XCTAssertTrue(parser.parse())
+    XCTAssertEqual(parser.feed?.entries.count, 1)
+  }
+
+  func testMalformedXMLFailsToParse() {
+    let parser = NYPLOPDSFeedParser(data: Data("<feed><entry></feed>".utf8))
+    XCTAssertFalse(parser.parse())
+    XCTAssertNil(parser.feed)
+    XCTAssertNil(parser.feedXML)
+  }
+
+  func testNonOPDSXMLParsesWithoutFeed() throws {
+    let parser = NYPLOPDSFeedParser(data: try data(forResource: "valid"))
+    XCTAssertTrue(parser.parse())
+    XCTAssertNil(parser.feed)
+  }
+
+  // MARK: - Benchmarks
+
+  // Compare these two to see the gain over building the whole XML tree first.
+  // On iOS 13+ the memory metric reports the peak physical memory as well.
+
+  private var benchmarkMetrics: [XCTMetric] {
+    if #available(iOS 13.0, *) {
+      return [XCTClockMetric(), XCTMemoryMetric()]
+    }
+    return []
+  }
+
+  func testDOMParsingPerformance() throws {
+    let data = try largeFeedData(repeatingEntries: 4)
+    guard #available(iOS 13.0, *) else {
+      measure { _ = domFeed(from: data) }
+      return
+    }
+    measure(metrics: benchmarkMetrics) {
+      XCTAssertNotNil(domFeed(from: data))
+    }
+  }
+
+  func testStreamingParsingPerformance() throws {
+    let data = try largeFeedData(repeatingEntries: 4)
+    guard #available(iOS 13.0, *) else {
+      measure { _ = NYPLOPDSFeedParser(data: data).parse() }
+      return
+    }
+    measure(metrics: benchmarkMetrics) {
+      let parser = NYPLOPDSFeedParser(data: data)
+      XCTAssertTrue(parser.parse())
+      XCTAssertNotNil(parser.feed)
+    }
+  }
+}
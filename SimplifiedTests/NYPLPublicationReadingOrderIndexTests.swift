@@ -0,0 +1,73 @@
+//
+//  NYPLPublicationReadingOrderIndexTests.swift
+//  SimplyETests
+//
+//  Copyright © 2026 NYPL. All rights reserved.
+//
+
+import XCTest
+import R2Shared
+@testable import SimplyE
+
+class NYPLPublicationReadingOrderIndexTests: XCTestCase {
+  let spineCount = 1500
+
+  /// A textbook-sized publication, where the last spine item repeats the
+  /// first idref and href.
+  private func makePublication() -> Publication {
+    var readingOrder = (0..<spineCount).map {
+      Link(href: "/OEBPS/item\($0).xhtml",
+           type: "application/xhtml+xml",
+           properties: Properties([Publication.idrefKey: "item\($0)"]))
+    }
+    readingOrder.append(Link(href: "/OEBPS/item0.xhtml",
+                             type: "application/xhtml+xml",
+                             properties: Properties([Publication.idrefKey: "item0"])))
+    return Publication(manifest: Manifest(metadata: Metadata(title: "Textbook"),
+                                          readingOrder: readingOrder))
+  }
+
+  func testLookupsMatchReadingOrder() {
+    let publication = makePublication()
+
+    for position in [0, 1, spineCount / 2, spineCount - 1] {
+      let href = "/OEBPS/item\(position).xhtml"
+      let idref = "item\(position)"
+      XCTAssertEqual(publication.link(withIDref: idref)?.href, href)
+      XCTAssertEqual(publication.href(forIdref: idref), href)
+      XCTAssertEqual(publication.idref(forHref: href), idref)
+      let locator = Locator(href: href, type: "application/xhtml+xml")
+      XCTAssertEqual(publication.resourceIndex(forLocator: locator), position)
+    }
+  }
+
+  func testUnknownReferences() {
+    let publication = makePublication()
+
+    XCTAssertNil(publication.link(withIDref: "missing"))
+    XCTAssertNil(publication.href(forIdref: nil))
+    XCTAssertNil(publication.idref(forHref: "/OEBPS/missing.xhtml"))
+    let locator = Locator(href: "/OEBPS/missing.xhtml", type: "application/xhtml+xml")
+    XCTAssertNil(publication.resourceIndex(forLocator: locator))
+  }
+
+  func testIndexIsBuiltOncePerPublication() {
+    let publication = makePublication()
+
+    XCTAssert(NYPLPublicationReadingOrderIndex.index(for: publication)
+      === NYPLPublicationReadingOrderIndex.index(for: publication))
+    XCTAssert(NYPLPublicationReadingOrderIndex.index(for: publication)
+      !== NYPLPublicationReadingOrderIndex.index(for: makePublication()))
+  }
+
+  func testLookupPerformance() {
+    let publication = makePublication()
+
+    measure {
+      for position in 0..<spineCount {
+        _ = publication.href(forIdref: "item\(position)")
+        _ = publication.idref(forHref: "/OEBPS/item\(position).xhtml")
+      }
+    }
+  }
+}
@@ -0,0 +1,143 @@
+//
+//  NYPLReadiumBookmarkIndexTests.swift
+//  SimplyETests
+//
+//  Copyright © 2026 NYPL. All rights reserved.
+//
+
+import XCTest
+import R2Shared
+@testable import SimplyE
+
+class NYPLReadiumBookmarkIndexTests: XCTestCase {
+  let chapterCount = 40
+  let bookmarksPerChapter = 50
+  let publication = Publication(manifest: Manifest(metadata: Metadata(title: "fakeMetadata")))
+
+  private func href(chapter: Int) -> String {
+    return "/chapter\(chapter).xhtml"
+  }
+
+  private func progressWithinChapter(_ index: Int) -> Float {
+    return Float(index) / Float(bookmarksPerChapter) + 0.005
+  }
+
+  private func makeBookmark(chapter: Int, index: Int) -> NYPLReadiumBookmark? {
+    let progress = progressWithinChapter(index)
+    return NYPLReadiumBookmark(
+      annotationId: "fakeAnnotationID\(chapter)-\(index)",
+      contentCFI: "",
+      href: href(chapter: chapter),
+      idref: nil,
+      chapter: "\(chapter)",
+      location: nil,
+      progressWithinChapter: progress,
+      progressWithinBook: NSNumber(value: (Float(chapter) + progress) / Float(chapterCount)),
+      creationTime: Date(),
+      device: nil)
+  }
+
+  /// 2,000 bookmarks, 50 in each of 40 chapters, in no particular order.
+  private func makeBookmarks() -> [NYPLReadiumBookmark] {
+    var bookmarks = [NYPLReadiumBookmark]()
+    for index in 0..<bookmarksPerChapter {
+      for chapter in (0..<chapterCount).reversed() {
+        if let bookmark = makeBookmark(chapter: chapter, index: index) {
+          bookmarks.append(bookmark)
+        }
+      }
+    }
+    return bookmarks
+  }
+
+  /// 1,000 page turns through the book, 7 per chapter landing on a
+  /// bookmarked location.
+  private func makePageTurnLocators() -> [Locator] {
+    let turnsPerChapter = 1000 / chapterCount
+    return (0..<1000).map { turn in
+      let chapter = turn / turnsPerChapter
+      let page = turn % turnsPerChapter
+      let progression = (page % 4 == 0) ?
+        Double(progressWithinChapter(page * 2)) :
+        Double(page) / Double(turnsPerChapter)
+      return Locator(href: href(chapter: chapter),
+                     type: "application/xhtml+xml",
+                     locations: Locator.Locations(progression: progression))
+    }
+  }
+
+  // MARK: - Correctness
+
+  func testBookmarksAreInDisplayOrder() {
+    let bookmarks = makeBookmarks()
+    let expected = bookmarks.sorted { $0.lessThan($1) }
+
+    XCTAssertEqual(NYPLReadiumBookmarkIndex(bookmarks: bookmarks).bookmarks, expected)
+
+    var index = NYPLReadiumBookmarkIndex()
+    bookmarks.forEach { index.insert($0) }
+    XCTAssertEqual(index.bookmarks, expected)
+  }
+
+  func testLookupMatchesLinearScan() {
+    let bookmarks = makeBookmarks()
+    let index = NYPLReadiumBookmarkIndex(bookmarks: bookmarks)
+    var matchCount = 0
+
+    for locator in makePageTurnLocators() {
+      let linear = bookmarks.first { $0.locationMatches(locator, inPublication: publication) }
+      let indexed = index.bookmark(at: locator, inPublication: publication)
+      XCTAssertEqual(indexed != nil, linear != nil)
+      if let indexed = indexed {
+        XCTAssertTrue(indexed.locationMatches(locator, inPublication: publication))
+        matchCount += 1
+      }
+    }
+
+    XCTAssertEqual(matchCount, 7 * chapterCount)
+  }
+
+  func testRemovedBookmarksAreNotFound() throws {
+    var index = NYPLReadiumBookmarkIndex(bookmarks: makeBookmarks())
+    let bookmark = try XCTUnwrap(makeBookmark(chapter: 3, index: 10))
+    let locator = Locator(href: href(chapter: 3),
+                          type: "application/xhtml+xml",
+                          locations: Locator.Locations(progression: Double(progressWithinChapter(10))))
+    XCTAssertNotNil(index.bookmark(at: locator, inPublication: publication))
+
+    XCTAssertTrue(index.remove(bookmark))
+    XCTAssertNil(index.bookmark(at: locator, inPublication: publication))
+    XCTAssertEqual(index.count, chapterCount * bookmarksPerChapter - 1)
+    XCTAssertFalse(index.remove(bookmark))
+
+    let first = index.remove(at: 0)
+    XCTAssertFalse(index.bookmarks.contains(first))
+  }
+
+  // MARK: - Benchmarks
+
+  // Compare the per-location bookmark lookups done while reading, before
+  // (linear scan) and after indexing.
+
+  func testLinearLookupPerformance() {
+    let bookmarks = makeBookmarks().sorted { $0.lessThan($1) }
+    let locators = makePageTurnLocators()
+
+    measure {
+      for locator in locators {
+        _ = bookmarks.first { $0.locationMatches(locator, inPublication: publication) }
+      }
+    }
+  }
+
+  func testIndexedLookupPerformance() {
+    let index = NYPLReadiumBookmarkIndex(bookmarks: makeBookmarks())
+    let locators = makePageTurnLocators()
+
+    measure {
+      for locator in locators {
+        _ = index.bookmark(at: locator, inPublication: publication)
+      }
+    }
+  }
+}
@@ -0,0 +1,164 @@
+//
+//  NYPLSegmentedDownloadTests.swift
+//  SimplyETests
+//
+//  Copyright © 2026 NYPL. All rights reserved.
+//
+
+import XCTest
+@testable import SimplyE
+
+class NYPLSegmentedDownloadTests: XCTestCase {
+  let body = Data((0..<(4 * 1024 * 1024)).map { UInt8(truncatingIfNeeded: $0 &* 31 &+ $0 >> 16) })
+  var destinationURL: URL!
+  var server: NYPLRangeHTTPServer!
+  var bookURL: URL!
+
+  override func setUpWithError() throws {
+    try super.setUpWithError()
+    destinationURL = FileManager.default.temporaryDirectory
+      .appendingPathComponent("NYPLSegmentedDownloadTests-\(UUID().uuidString)")
+    server = try NYPLRangeHTTPServer(body: body,
+                                     eTag: "\"v1\"",
+                                     fileName: "book.pdf",
+                                     contentType: "application/pdf")
+    bookURL = try XCTUnwrap(server.start())
+  }
+
+  override func tearDown() {
+    server.stop()
+    try? FileManager.default.removeItem(at: destinationURL)
+    super.tearDown()
+  }
+
+  //----------------------------------------------------------------------------
+  private func download(request: URLRequest? = nil, minimumContentLength: Int64 = 0)
+    -> (outcome: NYPLSegmentedDownloadOutcome, fileURL: URL?) {
+      let segmentedDownload = NYPLSegmentedDownload(request: request ?? URLRequest(url: bookURL),
+                                                    configuration: .ephemeral,
+                                                    destinationURL: destinationURL,
+                                                    segmentCount: 4,
+                                                    minimumContentLength: minimumContentLength)
+      segmentedDownload.acceptableContentTypes = ["application/pdf"]
+
+      let finished = expectation(description: "download finished")
+      var result: (NYPLSegmentedDownloadOutcome, URL?) = (.failed, nil)
+      segmentedDownload.start { outcome, fileURL, _, _ in
+        result = (outcome, fileURL)
+        finished.fulfill()
+      }
+      wait(for: [finished], timeout: 20)
+      return result
+  }
+
+  //----------------------------------------------------------------------------
+  /// - Returns: The `Range` headers of the requests following the probe.
+  private func requestedRanges() -> [String] {
+    return server.receivedRequests.dropFirst().compactMap { $0["range"] }.sorted()
+  }
+
+  //----------------------------------------------------------------------------
+  func testDownloadsRangesInParallelIntoOneFile() throws {
+    let result = download()
+
+    XCTAssertEqual(result.outcome, .completed)
+    let fileURL = try XCTUnwrap(result.fileURL)
+    XCTAssertEqual(try Data(contentsOf: fileURL), body)
+
+    let requests = server.receivedRequests
+    XCTAssertEqual(requests.first?["range"], "bytes=0-0")
+    XCTAssertEqual(requestedRanges(), [
+      "bytes=0-1048575",
+      "bytes=1048576-2097151",
+      "bytes=2097152-3145727",
+      "bytes=3145728-4194303",
+    ])
+    XCTAssertTrue(requests.dropFirst().allSatisfy { $0["if-range"] == "\"v1\"" })
+  }
+
+  //----------------------------------------------------------------------------
+  func testAuthorizationIsOnlySentToTheHostOfTheRequest() throws {
+    var request = URLRequest(url: try XCTUnwrap(server.movedURL))
+    request.setValue("Bearer token", forHTTPHeaderField: "Authorization")
+
+    let result = download(request: request)
+
+    XCTAssertEqual(result.outcome, .completed)
+    XCTAssertEqual(try Data(contentsOf: try XCTUnwrap(result.fileURL)), body)
+
+    let requests = server.receivedRequests
+    XCTAssertEqual(requests.first?.path, "/moved")
+    XCTAssertEqual(requests.first?["authorization"], "Bearer token")
+    let redirected = requests.dropFirst()
+    XCTAssertEqual(redirected.count, 5)
+    XCTAssertTrue(redirected.allSatisfy {
+      $0["host"]?.hasPrefix("localhost") == true && $0["authorization"] == nil
+    })
+  }
+
+  //----------------------------------------------------------------------------
+  func testAuthorizationIsSentWithRangesOnTheSameHost() {
+    var request = URLRequest(url: bookURL)
+    request.setValue("Bearer token", forHTTPHeaderField: "Authorization")
+
+    XCTAssertEqual(download(request: request).outcome, .completed)
+
+    let requests = server.receivedRequests
+    XCTAssertEqual(requests.count, 5)
+    XCTAssertTrue(requests.allSatisfy { $0["authorization"] == "Bearer token" })
+  }
+
+  //----------------------------------------------------------------------------
+  func testSegmentCutShortIsRequestedAgainFromMissingByte() throws {
+    server.dropsFirstResponseAtOffset = 2097152
+
+    let result = download()
+
+    XCTAssertEqual(result.outcome, .completed)
+    XCTAssertEqual(try Data(contentsOf: try XCTUnwrap(result.fileURL)), body)
+    let retries = requestedRanges().filter {
+      $0.hasPrefix("bytes=2") && $0.hasSuffix("-3145727")
+    }
+    XCTAssertEqual(retries.count, 2)
+    XCTAssertTrue(retries.contains("bytes=2097152-3145727"))
+  }
+
+  //----------------------------------------------------------------------------
+  func testUnsupportedWhenServerIgnoresRanges() {
+    server.honorsRanges = false
+
+    let result = download()
+
+    XCTAssertEqual(result.outcome, .unsupported)
+    XCTAssertNil(result.fileURL)
+    XCTAssertEqual(server.receivedRequests.count, 1)
+  }
+
+  //----------------------------------------------------------------------------
+  func testUnsupportedWithoutStrongETag() {
+    server.eTag = "W/\"v1\""
+
+    let result = download()
+
+    XCTAssertEqual(result.outcome, .unsupported)
+    XCTAssertEqual(server.receivedRequests.count, 1)
+  }
+
+  //----------------------------------------------------------------------------
+  func testUnsupportedWhenResourceChangesDuringDownload() {
+    server.eTagAfterFirstRequest = "\"v2\""
+
+    let result = download()
+
+    XCTAssertEqual(result.outcome, .unsupported)
+    XCTAssertFalse(FileManager.default.fileExists(atPath: destinationURL.path))
+  }
+
+  //----------------------------------------------------------------------------
+  func testUnsupportedForSmallResources() {
+    let result = download(minimumContentLength: Int64(body.count + 1))
+
+    XCTAssertEqual(result.outcome, .unsupported)
+    XCTAssertEqual(server.receivedRequests.count, 1)
+  }
+}
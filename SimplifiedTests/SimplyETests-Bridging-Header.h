@@ -6,6 +6,7 @@
 #import "NYPLOpenSearchDescription.h"
 #import "NSString+NYPLStringAdditions.h"
 #import "NYPLBook.h"
+#import "NYPLMyBooksDownloadCenter.h"
 
 //
 // Override here any ObjC declarations to facilitate testing
@@ -41,3 +42,25 @@
                                    revokeURL:(nullable NSURL *)revokeURL
                                    reportURL:(nullable NSURL *)reportURL;
 @end
+
+@interface NYPLMyBooksDownloadCenter () <NSURLSessionDownloadDelegate>
+@property (nonatomic, nonnull) NSOperationQueue *delegateQueue;
+@property (nonatomic, nonnull) dispatch_queue_t processingQueue;
+@property (nonatomic) NSUInteger activeTaskCount;
+@property (nonatomic, nonnull) NSMutableDictionary *taskIdentifierToBook;
+- (void)setBook:(nonnull NYPLBook *)book forTaskIdentifier:(NSUInteger)taskIdentifier;
+- (void)taskWillStart;
+- (void)taskDidComplete;
+@end
+
+@interface NYPLCatalogUngroupedFeed ()
+@property (nonatomic) BOOL currentlyFetchingNextURL;
+@property (nonatomic) NSUInteger greatestPreparationIndex;
+@property (nonatomic) NSTimeInterval averagePageLoadTime;
+@property (nonatomic) double preparationRate;
+@property (nonatomic) NSTimeInterval lastPreparationTime;
+@property (nonatomic) NSTimeInterval endOfListWaitStartTime;
+- (NSUInteger)preloadThreshold;
+- (void)updatePreparationRateForBookIndex:(NSUInteger)bookIndex;
+- (void)noteEndOfListWaitIfNeededForBookIndex:(NSUInteger)bookIndex;
+@end